@@ -39,8 +39,18 @@
  * - LV_STDLIB_MICROPYTHON: MicroPython implementation
  * - LV_STDLIB_RTTHREAD:    RT-Thread implementation
  * - LV_STDLIB_CUSTOM:      Implement the functions externally
+ *
+ * -D FLEET_TIERED_ALLOC=1 (the default): small objects in internal SRAM, big buffers
+ * in PSRAM (lib/FleetDisplay/src/fleet_lv_mem.h). 0: LVGL's 64 KB builtin pool.
  */
-#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#ifndef FLEET_TIERED_ALLOC
+    #define FLEET_TIERED_ALLOC 1
+#endif
+#if FLEET_TIERED_ALLOC
+    #define LV_USE_STDLIB_MALLOC    LV_STDLIB_CUSTOM
+#else
+    #define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#endif
 
 /** Possible values
  * - LV_STDLIB_BUILTIN:     LVGL's built in implementation
@@ -106,8 +116,23 @@
  * - LV_OS_WINDOWS
  * - LV_OS_MQX
  * - LV_OS_SDL2
- * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+ * - LV_OS_CUSTOM
+ *
+ * -D FLEET_RENDER_TASK=1 runs LVGL in its own task (lib/FleetDisplay/src/fleet_render_task.h):
+ * FreeRTOS on the device, pthreads on the host. Otherwise LVGL lives in loop().
+ * -D FLEET_DRAW_UNITS=2 (parallel draw threads, see LV_DRAW_SW_DRAW_UNIT_CNT) needs the OS too. */
+#ifndef FLEET_DRAW_UNITS
+    #define FLEET_DRAW_UNITS 1
+#endif
+#if (defined(FLEET_RENDER_TASK) && FLEET_RENDER_TASK) || FLEET_DRAW_UNITS > 1
+    #if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+        #define LV_USE_OS   LV_OS_FREERTOS
+    #else
+        #define LV_USE_OS   LV_OS_PTHREAD
+    #endif
+#else
+    #define LV_USE_OS   LV_OS_NONE
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -191,8 +216,9 @@
 
     /** Set number of draw units.
      *  - > 1 requires operating system to be enabled in `LV_USE_OS`.
-     *  - > 1 means multiple threads will render the screen in parallel. */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+     *  - > 1 means multiple threads will render the screen in parallel.
+     *  Set with -D FLEET_DRAW_UNITS=2 to use both ESP32-S3 cores (turns LV_USE_OS on). */
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    FLEET_DRAW_UNITS
 
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -496,12 +522,21 @@
  *  Used by image decoders such as `lv_lodepng` to keep the decoded image in memory.
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
- *  released immediately after use. */
-#define LV_CACHE_DEF_SIZE       0
+ *  released immediately after use.
+ *  Sized per board env with -D FLEET_IMAGE_CACHE_BYTES; decoded images live in PSRAM
+ *  (lib/FleetDisplay/src/fleet_image_cache.h, which also counts hits and misses). */
+#ifndef FLEET_IMAGE_CACHE_BYTES
+    #define FLEET_IMAGE_CACHE_BYTES 0
+#endif
+#define LV_CACHE_DEF_SIZE       FLEET_IMAGE_CACHE_BYTES
 
 /** Default number of image header cache entries. The cache is used to store the headers of images
- *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+ *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.
+ *  Sized per board env with -D FLEET_IMAGE_HEADER_CACHE_CNT. */
+#ifndef FLEET_IMAGE_HEADER_CACHE_CNT
+    #define FLEET_IMAGE_HEADER_CACHE_CNT 0
+#endif
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT FLEET_IMAGE_HEADER_CACHE_CNT
 
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
@@ -515,8 +550,13 @@
  *  - 254: round up */
 #define LV_COLOR_MIX_ROUND_OFS  0
 
-/** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
-#define LV_OBJ_STYLE_CACHE      0
+/** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties.
+ *  Style-heavy profile: -D FLEET_STYLE_CACHE=1. Measure it with fleet_ui_bench_styles_all()
+ *  (native_bench_styles vs native_bench_styles_cache, or ex02_bench_scenes on the device). */
+#ifndef FLEET_STYLE_CACHE
+    #define FLEET_STYLE_CACHE 0
+#endif
+#define LV_OBJ_STYLE_CACHE      FLEET_STYLE_CACHE
 
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
@@ -623,7 +663,12 @@
 #define LV_FONT_MONTSERRAT_42 0
 #define LV_FONT_MONTSERRAT_44 0
 #define LV_FONT_MONTSERRAT_46 0
-#define LV_FONT_MONTSERRAT_48 0
+/* fleet_ui_bench's large-text and transcript scenes: -D FLEET_BENCH_FONTS=1, set only in the
+ * envs that run them (ex02_bench_scenes, native_bench_scenes), so other builds don't carry the font */
+#ifndef FLEET_BENCH_FONTS
+    #define FLEET_BENCH_FONTS 0
+#endif
+#define LV_FONT_MONTSERRAT_48 FLEET_BENCH_FONTS
 
 /* Demonstrate special features */
 #define LV_FONT_MONTSERRAT_28_COMPRESSED    0  /**< bpp = 3 */
@@ -931,8 +976,12 @@
     #define LV_FS_FROGFS_LETTER '\0'
 #endif
 
-/** LODEPNG decoder library */
-#define LV_USE_LODEPNG 0
+/** LODEPNG decoder library. Off on the device (images are converted at build time);
+ *  native_bench_image_convert sets -D FLEET_LODEPNG=1 to check the converter against it. */
+#ifndef FLEET_LODEPNG
+    #define FLEET_LODEPNG 0
+#endif
+#define LV_USE_LODEPNG FLEET_LODEPNG
 
 /** PNG decoder(libpng) library */
 #define LV_USE_LIBPNG 0
@@ -1065,6 +1114,7 @@
 
     /** 1: Show used memory and memory fragmentation.
      *     - Requires `LV_USE_STDLIB_MALLOC = LV_STDLIB_BUILTIN`
+     *       (with the tiered allocator use the 'm' console command instead)
      *     - Requires `LV_USE_SYSMON = 1`*/
     #define LV_USE_MEM_MONITOR 0
     #if LV_USE_MEM_MONITOR
@@ -1072,8 +1122,13 @@
     #endif
 #endif /*LV_USE_SYSMON*/
 
-/** 1: Enable runtime performance profiler */
-#define LV_USE_PROFILER 0
+/** 1: Enable runtime performance profiler.
+ *  On in the *_profile envs (-D FLEET_PROFILE=1), see lib/FleetGfx/src/fleet_trace.h */
+#if defined(FLEET_PROFILE) && FLEET_PROFILE
+    #define LV_USE_PROFILER 1
+#else
+    #define LV_USE_PROFILER 0
+#endif
 #if LV_USE_PROFILER
     /** 1: Enable the built-in profiler */
     #define LV_USE_PROFILER_BUILTIN 1
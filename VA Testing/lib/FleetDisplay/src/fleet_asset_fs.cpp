@@ -0,0 +1,242 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_asset_fs (see fleet_asset_fs.h)
+ */
+
+#include "fleet_asset_fs.h"
+
+#include <string.h>
+
+struct AssetFile
+{
+    const FleetAssetEntry *entry;
+    uint32_t pos;
+};
+
+struct AssetDir
+{
+    char prefix[FLEET_ASSET_NAME_MAX]; // "" or "img/"
+    int next;                          // directory index to look at next
+    char last[FLEET_ASSET_NAME_MAX];   // last subdirectory listed, to list it once
+};
+
+static lv_fs_drv_t drv;
+
+// LVGL passes what follows "A:"; accept it with or without a leading '/'
+static const char *asset_name(const char *path)
+{
+    while (*path == '/')
+    {
+        path++;
+    }
+    return path;
+}
+
+static void *asset_open(lv_fs_drv_t *, const char *path, lv_fs_mode_t mode)
+{
+    if (mode != LV_FS_MODE_RD)
+    {
+        return nullptr;
+    }
+    const FleetAssetEntry *e = fleet_assets.find(asset_name(path));
+    if (e == nullptr)
+    {
+        return nullptr;
+    }
+    AssetFile *f = (AssetFile *)lv_malloc(sizeof(AssetFile));
+    if (f != nullptr)
+    {
+        f->entry = e;
+        f->pos = 0;
+    }
+    return f;
+}
+
+static lv_fs_res_t asset_close(lv_fs_drv_t *, void *file_p)
+{
+    lv_free(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t asset_read(lv_fs_drv_t *, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    AssetFile *f = (AssetFile *)file_p;
+    const uint32_t left = f->entry->size - f->pos;
+    const uint32_t n = btr < left ? btr : left;
+    memcpy(buf, fleet_assets.data(f->entry) + f->pos, n);
+    f->pos += n;
+    *br = n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t asset_seek(lv_fs_drv_t *, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    AssetFile *f = (AssetFile *)file_p;
+    int64_t to = pos;
+    if (whence == LV_FS_SEEK_CUR)
+    {
+        to += f->pos;
+    }
+    else if (whence == LV_FS_SEEK_END)
+    {
+        to += f->entry->size;
+    }
+    if (to > f->entry->size)
+    {
+        return LV_FS_RES_INV_PARAM;
+    }
+    f->pos = (uint32_t)to;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t asset_tell(lv_fs_drv_t *, void *file_p, uint32_t *pos_p)
+{
+    *pos_p = ((AssetFile *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+static void *asset_dir_open(lv_fs_drv_t *, const char *path)
+{
+    if (!fleet_assets.mounted())
+    {
+        return nullptr;
+    }
+    const char *name = asset_name(path);
+    size_t len = strlen(name);
+    while (len > 0 && name[len - 1] == '/')
+    {
+        len--;
+    }
+    if (len + 2 > FLEET_ASSET_NAME_MAX)
+    {
+        return nullptr;
+    }
+    AssetDir *d = (AssetDir *)lv_malloc(sizeof(AssetDir));
+    if (d == nullptr)
+    {
+        return nullptr;
+    }
+    memcpy(d->prefix, name, len);
+    if (len > 0)
+    {
+        d->prefix[len++] = '/';
+    }
+    d->prefix[len] = '\0';
+    d->last[0] = '\0';
+
+    // Names are sorted, so the directory is one run starting at the first
+    // name >= prefix
+    int lo = 0, hi = fleet_assets.count();
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (strcmp(fleet_assets.entry(mid)->name, d->prefix) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    d->next = lo;
+    if (len > 0 && (lo == fleet_assets.count() || strncmp(fleet_assets.entry(lo)->name, d->prefix, len) != 0))
+    {
+        lv_free(d);
+        return nullptr; // no such directory
+    }
+    return d;
+}
+
+// Files come back as "name", subdirectories as "/name" (LVGL's convention);
+// "" once the directory is exhausted
+static lv_fs_res_t asset_dir_read(lv_fs_drv_t *, void *rddir_p, char *fn, uint32_t fn_len)
+{
+    AssetDir *d = (AssetDir *)rddir_p;
+    const size_t plen = strlen(d->prefix);
+    fn[0] = '\0';
+    while (d->next < fleet_assets.count())
+    {
+        const char *name = fleet_assets.entry(d->next)->name;
+        if (strncmp(name, d->prefix, plen) != 0)
+        {
+            break;
+        }
+        d->next++;
+        const char *rest = name + plen;
+        const char *slash = strchr(rest, '/');
+        if (slash == nullptr)
+        {
+            if (strlen(rest) + 1 > fn_len)
+            {
+                return LV_FS_RES_INV_PARAM;
+            }
+            strcpy(fn, rest);
+            return LV_FS_RES_OK;
+        }
+        const size_t sub = (size_t)(slash - rest);
+        if (strncmp(d->last, rest, sub) == 0 && d->last[sub] == '\0')
+        {
+            continue; // listed already
+        }
+        if (sub + 2 > fn_len)
+        {
+            return LV_FS_RES_INV_PARAM;
+        }
+        memcpy(d->last, rest, sub);
+        d->last[sub] = '\0';
+        fn[0] = '/';
+        memcpy(fn + 1, rest, sub);
+        fn[sub + 1] = '\0';
+        return LV_FS_RES_OK;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t asset_dir_close(lv_fs_drv_t *, void *rddir_p)
+{
+    lv_free(rddir_p);
+    return LV_FS_RES_OK;
+}
+
+void fleet_asset_fs_begin(void)
+{
+    lv_fs_drv_init(&drv);
+    drv.letter = FLEET_ASSET_FS_LETTER;
+    drv.cache_size = 0; // reads are memcpy from the mapping already
+    drv.open_cb = asset_open;
+    drv.close_cb = asset_close;
+    drv.read_cb = asset_read;
+    drv.seek_cb = asset_seek;
+    drv.tell_cb = asset_tell;
+    drv.dir_open_cb = asset_dir_open;
+    drv.dir_read_cb = asset_dir_read;
+    drv.dir_close_cb = asset_dir_close;
+    lv_fs_drv_register(&drv);
+}
+
+bool fleet_asset_image(const char *path, lv_image_dsc_t *dsc)
+{
+    if (path[0] == FLEET_ASSET_FS_LETTER && path[1] == ':')
+    {
+        path += 2;
+    }
+    const FleetAssetEntry *e = fleet_assets.find(asset_name(path));
+    if (e == nullptr || e->size < sizeof(lv_image_header_t))
+    {
+        return false;
+    }
+    const uint8_t *p = fleet_assets.data(e);
+    lv_image_header_t header;
+    memcpy(&header, p, sizeof(header));
+    if (header.magic != LV_IMAGE_HEADER_MAGIC || (header.flags & LV_IMAGE_FLAGS_COMPRESSED) != 0 ||
+        (uint64_t)header.stride * header.h > e->size - sizeof(header))
+    {
+        return false;
+    }
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->header = header;
+    dsc->data_size = e->size - sizeof(header);
+    dsc->data = p + sizeof(header);
+    return true;
+}
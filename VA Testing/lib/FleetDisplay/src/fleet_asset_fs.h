@@ -0,0 +1,46 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_asset_fs
+ * Goal:    Give LVGL the mapped asset partition
+ * (lib/FleetGfx/src/fleet_asset_pack.h) as an lv_fs drive, plus
+ * zero-copy image descriptors for the .bin images in it.
+ *
+ * After fleet_assets is mounted and fleet_asset_fs_begin() has run:
+ *
+ *     lv_image_set_src(img, "A:img/sun.bin");          // through lv_fs
+ *     lv_binfont_create("A:fonts/inter_20.bin");       // fonts likewise
+ *
+ *     static lv_image_dsc_t sun;
+ *     if (fleet_asset_image("img/sun.bin", &sun))
+ *         lv_image_set_src(img, &sun);                 // no lv_fs at all
+ *
+ * lv_fs reads are a memcpy out of mapped flash into the caller's buffer
+ * (no flash driver calls, no RAM copy of the file), but LVGL's bin decoder
+ * still copies an image's pixels out through them: line by line on every
+ * draw, or whole into RAM with LV_BIN_DECODER_RAM_LOAD. A descriptor from
+ * fleet_asset_image() points at the mapping itself, so LVGL blits
+ * straight from flash and the image never takes RAM.
+ *
+ * The drive is read-only; directories are listed from the names' '/'.
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+#include "fleet_asset_pack.h"
+
+#ifndef FLEET_ASSET_FS_LETTER
+#define FLEET_ASSET_FS_LETTER 'A'
+#endif
+
+// Register the drive for fleet_assets; call after lv_init(). Mount the
+// pack before or after: until it is, every open fails. lv_fs_open()
+// reports a missing file (or a write open) as LV_FS_RES_UNKNOWN, since
+// an open_cb can only return nullptr.
+void fleet_asset_fs_begin(void);
+
+// Fill `dsc` for the LVGL .bin image `path` ("img/sun.bin", "A:" prefix
+// optional; LVGL v9 header, uncompressed), with data pointing into the
+// mapped pack. false if it is missing or not such an image.
+bool fleet_asset_image(const char *path, lv_image_dsc_t *dsc);
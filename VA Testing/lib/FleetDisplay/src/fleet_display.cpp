@@ -0,0 +1,656 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  FleetDisplay (see fleet_display.h)
+ */
+
+#include "fleet_display.h"
+#include "fleet_font_cache.h"
+#include "fleet_image_cache.h"
+#include "fleet_lv_mem.h"
+#include "fleet_port.h"
+#include "fleet_swap.h"
+
+// The invalidated-area list (inv_areas/inv_area_joined/inv_p) is only in
+// LVGL's private display header
+#include "src/display/lv_display_private.h"
+
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+// LVGL's profiler, on fleet_trace's clock and tracks (see fleet_trace.h)
+static void profilerFlush(const char *buf)
+{
+    fleet_log("%s", buf);
+}
+
+static void profilerBegin()
+{
+    lv_profiler_builtin_config_t pc;
+    lv_profiler_builtin_config_init(&pc);
+    pc.tick_per_sec = 1000000;
+    pc.tick_get_cb = fleet_trace_ticks;
+    pc.tid_get_cb = fleet_trace_tid;
+    pc.cpu_get_cb = fleet_trace_cpu;
+    pc.flush_cb = profilerFlush;
+    lv_profiler_builtin_uninit();
+    lv_profiler_builtin_init(&pc);
+}
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+bool FleetDisplay::begin(BB_SPI_LCD *lcd, const FleetDisplayConfig &config)
+{
+    FleetDisplayConfig c = config;
+    if (c.width == 0 || c.height == 0)
+    {
+        c.width = lcd->width();
+        c.height = lcd->height();
+    }
+
+    // The DMA worker owns the LCD from here on
+    if (!bb_transport.begin(lcd))
+    {
+        fleet_log("FATAL ERROR: Failed to start the DMA worker task");
+        return false;
+    }
+    return begin(&bb_transport, c);
+}
+#endif
+
+lv_color_format_t FleetDisplay::colorFormat() const
+{
+    return cfg.render_swapped ? LV_COLOR_FORMAT_RGB565_SWAPPED : LV_COLOR_FORMAT_NATIVE;
+}
+
+bool FleetDisplay::begin(FleetTransport *transport, const FleetDisplayConfig &config)
+{
+    cfg = config;
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    profilerBegin();
+    fleet_log("Profiler on: send 't' to dump the trace");
+#endif
+    const int w = cfg.width;
+    const int h = cfg.height;
+    fleet_log("FleetDisplay: %d x %d, rotation %d, %s render, flush mode %s (swap kernel %s), %d draw unit(s)", w, h,
+              cfg.rotation, cfg.direct ? "direct" : "partial", cfg.render_swapped ? "swapped" : "legacy",
+              fleet_swap_impl_name(), LV_DRAW_SW_DRAW_UNIT_CNT);
+    if (cfg.rotation != 0 && cfg.rotation != 90 && cfg.rotation != 270)
+    {
+        fleet_log("FATAL ERROR: Unsupported rotation %d (0, 90 or 270)", cfg.rotation);
+        return false;
+    }
+    if (cfg.rotation != 0 && cfg.direct)
+    {
+        // Dirty rows of a rotated frame are columns on the panel
+        fleet_log("FATAL ERROR: Rotation needs PARTIAL render mode");
+        return false;
+    }
+    quirks = fleet_panel_find(cfg.panel);
+    if (quirks == nullptr)
+    {
+        fleet_log("Warning: Unknown panel '%s', assuming it takes any window", cfg.panel ? cfg.panel : "(null)");
+        quirks = fleet_panel_find("generic");
+    }
+    round_areas = !fleet_panel_any_window(quirks);
+    fleet_log("Panel %s: x align %u, y align %u%s", quirks->name, (unsigned)quirks->x_align,
+              (unsigned)quirks->y_align, quirks->full_width ? ", full-width rows only" : "");
+    if (quirks->full_width && cfg.rotation != 0 && !cfg.direct && cfg.draw_buf_divisor > 1)
+    {
+        // Rotated, a panel row is an LVGL column: every area would be
+        // full height, which no partial draw buffer can hold
+        fleet_log("FATAL ERROR: %s can't rotate with partial draw buffers (set draw_buf_divisor = 1)",
+                  quirks->name);
+        return false;
+    }
+
+    // 1. DMA strip buffers in internal RAM, as many rows as the budget
+    // allows. The legacy (swap) and rotated paths copy through them, and
+    // so does every draw buffer the DMA can't read (PSRAM, flushArea()).
+    if (fleet_dma_strips_alloc(&dma_strips, w, cfg.dma_budget_bytes))
+    {
+        fleet_log("DMA strips: 2 x %d rows (%d bytes each)", dma_strips.rows,
+                  (int)(dma_strips.px * sizeof(uint16_t)));
+    }
+    else if (w <= (int)(sizeof(dma_row_fallback[0]) / sizeof(uint16_t)))
+    {
+        dma_strips.buf[0] = dma_row_fallback[0];
+        dma_strips.buf[1] = dma_row_fallback[1];
+        dma_strips.px = w;
+        dma_strips.rows = 1;
+        fleet_log("Warning: DMA buffer allocation failed, using static per-row fallback");
+    }
+    else
+    {
+        fleet_log("FATAL ERROR: No DMA buffer for a %d pixel row", w);
+        return false;
+    }
+    if (!pipe.begin(transport, dma_strips.buf[0], dma_strips.buf[1], dma_strips.px))
+    {
+        fleet_log("FATAL ERROR: Flush pipeline rejected the DMA strips");
+        return false;
+    }
+    coalescer.setOverhead(cfg.txn_overhead_bytes);
+    if (cfg.direct)
+    {
+        // Dirty bands from DMA-readable frames go out zero-copy; keep
+        // each DMA push strip-sized
+        pipe.setMaxPush(cfg.dma_budget_bytes / sizeof(uint16_t));
+    }
+    if (!sched.begin())
+    {
+        fleet_log("FATAL ERROR: Failed to create the scheduler");
+        return false;
+    }
+
+    // 2. LVGL draw buffers in PSRAM, sized in bytes (see fleet_buf_size.h).
+    // DIRECT mode needs the whole frame, and a second one only on request.
+    const FleetDrawBufSize size = fleet_draw_buf_size(w, h, cfg.direct ? 1 : cfg.draw_buf_divisor);
+    const bool two = cfg.direct ? cfg.direct_double_buffer : cfg.double_buffer;
+    const int count = two ? 2 : 1;
+    for (int i = 0; i < count; i++)
+    {
+        void *mem = fleet_malloc(size.bytes.value, FLEET_MEM_PSRAM);
+        if (mem == nullptr)
+        {
+            fleet_log("FATAL ERROR: Failed to allocate draw buffer in PSRAM!");
+            return false;
+        }
+        if (lv_draw_buf_init(&draw_bufs[i], w, size.rows, colorFormat(), LV_STRIDE_AUTO, mem, size.bytes.value) !=
+            LV_RESULT_OK)
+        {
+            fleet_log("FATAL ERROR: lv_draw_buf_init failed");
+            return false;
+        }
+    }
+    fleet_log("LVGL draw buffers: %d x %u rows (%u bytes each)", count, (unsigned)size.rows,
+              (unsigned)size.bytes.value);
+
+    // 3. Decoded images and glyphs in PSRAM, cache counters on
+    fleet_image_cache_begin();
+    fleet_font_cache_begin(FLEET_GLYPH_CACHE_BYTES);
+    fleet_log("LVGL image cache: %u bytes, %u headers; glyph cache: %u bytes", (unsigned)LV_CACHE_DEF_SIZE,
+              (unsigned)LV_IMAGE_HEADER_CACHE_DEF_CNT, (unsigned)FLEET_GLYPH_CACHE_BYTES);
+
+    // 4. The LVGL display itself
+    disp = lv_display_create(w, h);
+    if (disp == nullptr)
+    {
+        fleet_log("FATAL ERROR: lv_display_create failed");
+        return false;
+    }
+    lv_display_set_driver_data(disp, this);
+    lv_display_set_draw_buffers(disp, &draw_bufs[0], two ? &draw_bufs[1] : nullptr);
+    lv_display_set_flush_cb(disp, flushCb);
+    lv_display_set_flush_wait_cb(disp, flushWaitCb);
+    lv_display_set_color_format(disp, colorFormat());
+    lv_display_set_render_mode(disp, cfg.direct ? LV_DISPLAY_RENDER_MODE_DIRECT : LV_DISPLAY_RENDER_MODE_PARTIAL);
+    if (cfg.rotation != 0)
+    {
+        // LVGL lays out (and maps touch) in landscape; flushPartial() rotates
+        lv_display_set_rotation(disp, cfg.rotation == 90 ? LV_DISPLAY_ROTATION_90 : LV_DISPLAY_ROTATION_270);
+    }
+    lv_display_add_event_cb(disp, eventCb, LV_EVENT_INVALIDATE_AREA, this);
+    lv_display_add_event_cb(disp, eventCb, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(disp, eventCb, LV_EVENT_RENDER_READY, this);
+    lv_display_set_default(disp);
+    return true;
+}
+
+uint32_t FleetDisplay::timerHandler()
+{
+    const uint32_t t0 = fleet_micros();
+    in_handler = true;
+    const uint32_t next = lv_timer_handler();
+    in_handler = false;
+    metrics_.handler_us.record(fleet_micros() - t0);
+    return next;
+}
+
+// LVGL returns how long until its next timer; sleep exactly that. It
+// never returns 0 after running everything due, but keep at least 1 ms
+// so the loop task can't starve lower-priority work if it ever did.
+// Synced to TE, LVGL's refresh timer never fires, so render here whenever
+// something is invalid; the flush then blocks until the blanking, which
+// is what paces the loop.
+void FleetDisplay::runOnce()
+{
+    const uint32_t next = timerHandler();
+    if (te != nullptr)
+    {
+        // inv_p is written by whoever invalidates, under the same lock
+        lv_lock();
+        if (disp->inv_p > 0)
+        {
+            in_handler = true;
+            lv_refr_now(disp);
+            in_handler = false;
+            lv_unlock();
+            return;
+        }
+        lv_unlock();
+    }
+    sched.sleep(next > 0 ? next : 1);
+}
+
+void FleetDisplay::syncToTe(FleetTe *source)
+{
+    te = source;
+    te_last = te ? te->pulses() : 0;
+    // A period that never elapses: the timer still exists, so
+    // lv_refr_now() keeps working, but only runOnce() starts a refresh
+    lv_timer_set_period(lv_display_get_refr_timer(disp), te ? UINT32_MAX - 1 : LV_DEF_REFR_PERIOD);
+    fleet_log("FleetDisplay: %s", te ? "refresh paced by TE" : "refresh paced by LV_DEF_REFR_PERIOD");
+}
+
+bool FleetDisplay::pushImage(const lv_image_dsc_t *img, int x, int y)
+{
+    const lv_image_header_t &hd = img->header;
+    const bool wire = hd.cf == LV_COLOR_FORMAT_RGB565_SWAPPED;
+    if ((!wire && hd.cf != LV_COLOR_FORMAT_RGB565) || hd.stride != hd.w * sizeof(uint16_t) || cfg.rotation != 0)
+    {
+        fleet_log("pushImage: needs unpadded RGB565(_SWAPPED) and rotation 0 (cf 0x%02x, stride %u, rotation %d)",
+                  (unsigned)hd.cf, (unsigned)hd.stride, cfg.rotation);
+        return false;
+    }
+    FleetRect r = {x, y, x + (int32_t)hd.w - 1, y + (int32_t)hd.h - 1};
+    const FleetRect want = r;
+    fleet_panel_round(quirks, &r, cfg.width, cfg.height);
+    if (r.x1 != want.x1 || r.y1 != want.y1 || r.x2 != want.x2 || r.y2 != want.y2)
+    {
+        fleet_log("pushImage: %s can't take a %u x %u window at %d,%d", quirks->name, (unsigned)hd.w,
+                  (unsigned)hd.h, x, y);
+        return false;
+    }
+
+    // LVGL's last area must be out before the window changes. Images in
+    // flash or PSRAM go through the DMA strips (a copy); internal RAM
+    // zero-copy, in strip-sized pushes like DIRECT mode's bands.
+    pipe.waitIdle();
+    const uint16_t *px = (const uint16_t *)img->data;
+    if (!wire || !fleet_dma_readable(px))
+    {
+        if (!pipe.flushCopy(x, y, hd.w, hd.h, px, !wire, nullptr, nullptr))
+        {
+            fleet_log("pushImage: no DMA strips to copy through");
+            return false;
+        }
+    }
+    else
+    {
+        const size_t max_push = pipe.maxPush();
+        pipe.setMaxPush(cfg.dma_budget_bytes / sizeof(uint16_t));
+        pipe.flush(x, y, hd.w, hd.h, px, false, nullptr, nullptr);
+        pipe.setMaxPush(max_push);
+    }
+    pipe.waitIdle();
+    return true;
+}
+
+// Hold the frame's first pixels until the panel starts a vertical
+// blanking, so the write runs ahead of the scan-out instead of through it.
+// A pulse that fired less than FLEET_TE_BLANKING_US ago still counts.
+void FleetDisplay::waitForBlanking()
+{
+    uint32_t target = te->pulses();
+    if (fleet_micros() - te->lastPulseUs() > FLEET_TE_BLANKING_US)
+    {
+        target++;
+    }
+    const uint32_t divider = cfg.te_divider ? cfg.te_divider : 1;
+    if ((int32_t)(te_last + divider - target) > 0)
+    {
+        target = te_last + divider;
+    }
+
+    FLEET_TRACE_BEGIN("te_wait");
+    te->waitPulse(target, FLEET_TE_TIMEOUT_MS);
+    FLEET_TRACE_END("te_wait");
+    te_last = te->pulses();
+}
+
+void FleetDisplay::handleCommand(int c)
+{
+    if (c == 't')
+    {
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+        lv_profiler_builtin_flush();
+#endif
+        fleet_trace_flush();
+        return;
+    }
+    metrics_.handleCommand(c);
+    if (c == 'm')
+    {
+        const FleetSchedulerStats &ss = sched.stats();
+        fleet_log("scheduler: %u sleeps, %u woken early, %u ms asleep", (unsigned)ss.sleeps, (unsigned)ss.woken,
+                  (unsigned)(ss.slept_us / 1000));
+        if (te != nullptr)
+        {
+            const FleetTeStats &ts = te->stats();
+            const uint32_t period = te->periodUs() ? te->periodUs() : 1;
+            fleet_log("te: panel %u.%u Hz, %u frames synced, %u timeouts, avg wait %u us", (unsigned)(1000000 / period),
+                      (unsigned)(10000000 / period % 10), (unsigned)ts.waits, (unsigned)ts.timeouts,
+                      (unsigned)(ts.waits ? ts.waited_us / ts.waits : 0));
+            te->lag().dump("te pulse->push", "us");
+        }
+        if (round_areas)
+        {
+            const uint64_t px_in = rounded_px_in ? rounded_px_in : 1;
+            fleet_log("panel %s: %u areas rounded, %u -> %u px (+%u%%)", quirks->name, (unsigned)rounded_areas,
+                      (unsigned)rounded_px_in, (unsigned)rounded_px_out,
+                      (unsigned)((rounded_px_out - rounded_px_in) * 100 / px_in));
+        }
+        fleet_image_cache_dump();
+        fleet_font_cache_dump();
+        fleet_lv_mem_dump();
+        const FleetCoalesceStats &cs = coalescer.stats();
+        const uint64_t cost_in = cs.cost_in ? cs.cost_in : 1;
+        fleet_log("coalesce: %u frames, %u -> %u areas, modelled bus bytes %u -> %u (-%u%%)", (unsigned)cs.runs,
+                  (unsigned)cs.areas_in, (unsigned)cs.areas_out, (unsigned)cs.cost_in, (unsigned)cs.cost_out,
+                  (unsigned)((cs.cost_in - cs.cost_out) * 100 / cost_in));
+    }
+    else if (c == 'r')
+    {
+        sched.resetStats();
+        coalescer.resetStats();
+        fleet_image_cache_reset_stats();
+        fleet_font_cache_reset_stats();
+        fleet_lv_mem_reset_peaks();
+        rounded_areas = 0;
+        rounded_px_in = rounded_px_out = 0;
+        if (te != nullptr)
+        {
+            te->resetStats();
+        }
+    }
+}
+
+// Frame timing from the display's own events. LVGL ignores invalidations
+// while rendering, so every one seen before RENDER_START belongs to the
+// frame that starts there.
+void FleetDisplay::eventCb(lv_event_t *e)
+{
+    FleetDisplay *self = (FleetDisplay *)lv_event_get_user_data(e);
+    const uint32_t now = fleet_micros();
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_INVALIDATE_AREA:
+        if (self->round_areas)
+        {
+            self->roundArea((lv_area_t *)lv_event_get_param(e));
+        }
+        // LVGL drops invalidations while rendering; the only ones sent then
+        // are its probes for the strip height, which only need rounding
+        if (self->disp->rendering_in_progress)
+        {
+            break;
+        }
+        if (!self->inval_pending)
+        {
+            self->inval_t0 = now;
+            self->inval_pending = true;
+        }
+        // From outside the handler: the refresh timer may be paused and
+        // the loop asleep, so get it going now
+        if (!self->in_handler)
+        {
+            self->sched.wake();
+        }
+        break;
+    case LV_EVENT_RENDER_START:
+        self->render_t0 = now;
+        self->render_flush_us = self->total_flush_us;
+        self->frame_inval_t0 = self->inval_t0;
+        self->frame_inval = self->inval_pending;
+        self->inval_pending = false;
+        if (self->cfg.coalesce)
+        {
+            self->coalesceInvalid();
+        }
+        break;
+    case LV_EVENT_RENDER_READY:
+        // Time spent in flushCb is reported separately
+        self->metrics_.render_us.record(now - self->render_t0 - (self->total_flush_us - self->render_flush_us));
+        break;
+    default:
+        break;
+    }
+}
+
+// Grow the area to a window the panel accepts (see fleet_panel.h)
+void FleetDisplay::roundArea(lv_area_t *area)
+{
+    FleetRect r = {area->x1, area->y1, area->x2, area->y2};
+    fleet_panel_round(quirks, &r, cfg.width, cfg.height, (FleetRotation)cfg.rotation);
+    if (!disp->rendering_in_progress)
+    {
+        rounded_areas++;
+        rounded_px_in += (uint64_t)lv_area_get_width(area) * lv_area_get_height(area);
+        rounded_px_out += (uint64_t)(r.x2 - r.x1 + 1) * (r.y2 - r.y1 + 1);
+    }
+    lv_area_set(area, r.x1, r.y1, r.x2, r.y2);
+}
+
+// Replace LVGL's (already joined) invalidated areas with the coalesced
+// set. LVGL picks the index of the last area to render before sending
+// RENDER_START, so the list keeps its length: the final rect goes to that
+// index and every other unused slot is marked joined.
+void FleetDisplay::coalesceInvalid()
+{
+    FleetRect rects[LV_INV_BUF_SIZE];
+    int n = 0;
+    int last_i = -1;
+    for (int i = 0; i < (int)disp->inv_p; i++)
+    {
+        if (!disp->inv_area_joined[i])
+        {
+            const lv_area_t &a = disp->inv_areas[i];
+            rects[n++] = {a.x1, a.y1, a.x2, a.y2};
+            last_i = i;
+        }
+    }
+    if (n < 2)
+    {
+        return;
+    }
+
+    const int m = coalescer.run(rects, n);
+    if (m == n)
+    {
+        return; // nothing merged, the list is unchanged
+    }
+    for (int i = 0; i <= last_i; i++)
+    {
+        disp->inv_area_joined[i] = 1;
+    }
+    for (int k = 0; k < m; k++)
+    {
+        const int idx = k == m - 1 ? last_i : k;
+        lv_area_set(&disp->inv_areas[idx], rects[k].x1, rects[k].y1, rects[k].x2, rects[k].y2);
+        disp->inv_area_joined[idx] = 0;
+    }
+}
+
+// Runs from the transport's done event for the area's last push
+void FleetDisplay::flushDone(void *ctx)
+{
+    lv_display_flush_ready((lv_display_t *)ctx);
+}
+
+// Same, for the last area of a frame: its pixels are now all on the wire
+void FleetDisplay::flushDoneLast(void *ctx)
+{
+    FleetDisplay *self = (FleetDisplay *)lv_display_get_driver_data((lv_display_t *)ctx);
+    if (self->glass_inval)
+    {
+        self->metrics_.latency_us.record(fleet_micros() - self->glass_inval_t0);
+    }
+    lv_display_flush_ready((lv_display_t *)ctx);
+}
+
+// LVGL calls this instead of spinning on the flushing flag
+void FleetDisplay::flushWaitCb(lv_display_t *disp)
+{
+    FleetDisplay *self = (FleetDisplay *)lv_display_get_driver_data(disp);
+    FLEET_TRACE_BEGIN("flush_wait");
+    self->pipe.waitIdle();
+    FLEET_TRACE_END("flush_wait");
+}
+
+// Queue the area and return; see FleetFlushPipeline for the details
+void FleetDisplay::flushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    FleetDisplay *self = (FleetDisplay *)lv_display_get_driver_data(disp);
+    const uint32_t t0 = fleet_micros();
+    FLEET_TRACE_BEGIN("flush_cb");
+
+    const bool last = lv_display_flush_is_last(disp);
+    if (last)
+    {
+        // The previous frame's done event must not see this frame's stamp
+        self->pipe.waitIdle();
+        self->glass_inval_t0 = self->frame_inval_t0;
+        self->glass_inval = self->frame_inval;
+    }
+    // DIRECT sends everything from the last area, PARTIAL from the first
+    if (self->te != nullptr && (self->cfg.direct ? last : self->frame_areas == 0))
+    {
+        self->waitForBlanking();
+    }
+    if (self->cfg.direct)
+    {
+        self->flushDirect(area, px_map, last);
+    }
+    else
+    {
+        self->flushPartial(area, px_map, last);
+    }
+    FLEET_TRACE_END("flush_cb");
+
+    const uint32_t dt = fleet_micros() - t0;
+    self->frame_flush_us += dt;
+    self->total_flush_us += dt;
+    self->frame_areas++;
+    if (last)
+    {
+        self->pipe.endFrame();
+        self->frameDone();
+    }
+}
+
+// PARTIAL: px_map holds just this area, send it as it is, or rotated
+// into the DMA strips on the way out
+void FleetDisplay::flushPartial(const lv_area_t *area, const uint8_t *px_map, bool last)
+{
+    if (cfg.rotation != 0)
+    {
+        lv_area_t panel = *area;
+        lv_display_rotate_area(disp, &panel);
+        const int w = lv_area_get_width(&panel);
+        const int h = lv_area_get_height(&panel);
+        if (!pipe.flushRotated(panel.x1, panel.y1, w, h, (const uint16_t *)px_map, (FleetRotation)cfg.rotation,
+                               !cfg.render_swapped, last ? flushDoneLast : flushDone, disp))
+        {
+            // A DMA strip shorter than one panel row: drop the area rather
+            // than leave LVGL waiting for flush_ready
+            fleet_log("Warning: %d pixel row doesn't fit the DMA strips, area dropped", w);
+            (last ? flushDoneLast : flushDone)(disp);
+            return;
+        }
+        frame_px += w * h;
+        return;
+    }
+
+    const int w = lv_area_get_width(area);
+    const int h = lv_area_get_height(area);
+    flushArea(area->x1, area->y1, w, h, (const uint16_t *)px_map, last ? flushDoneLast : flushDone);
+    frame_px += w * h;
+}
+
+// DIRECT: px_map is the whole frame and LVGL has already drawn this area
+// into it. Collect the rows; on the last area send each dirty band of
+// full-width rows (contiguous in the frame) as one window. LVGL waits for
+// the last flush_ready before drawing into a single buffer again.
+void FleetDisplay::flushDirect(const lv_area_t *area, const uint8_t *px_map, bool last)
+{
+    dirty_rows.add(area->y1, area->y2);
+    if (!last)
+    {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    const int w = cfg.width;
+    const uint16_t *frame = (const uint16_t *)px_map;
+    for (int i = 0; i < dirty_rows.count(); i++)
+    {
+        const FleetRowBand &b = dirty_rows.band(i);
+        const int rows = b.y1 - b.y0 + 1;
+        const bool final_band = i == dirty_rows.count() - 1;
+        flushArea(0, b.y0, w, rows, frame + (size_t)b.y0 * w, final_band ? flushDoneLast : nullptr);
+        frame_px += w * rows;
+    }
+    dirty_rows.clear();
+}
+
+// Zero-copy only where the DMA can read the draw buffer. The ESP32's are
+// in PSRAM: bb_spi_lcd's DRAW_WITH_DMA hands the pointer to IDF's
+// spi_master, which bounces anything esp_ptr_dma_capable() rejects through
+// a fresh malloc + memcpy per transaction. Copying (or swapping) into the
+// DMA strips costs the same memcpy without the malloc, and the DMA only
+// ever reads internal RAM, so no cache writeback is needed.
+void FleetDisplay::flushArea(int x, int y, int w, int h, const uint16_t *px, FleetFlushPipeline::ready_cb_t ready)
+{
+    if (fleet_dma_readable(px))
+    {
+        pipe.flush(x, y, w, h, px, !cfg.render_swapped, ready, disp);
+    }
+    else if (!pipe.flushCopy(x, y, w, h, px, !cfg.render_swapped, ready, disp))
+    {
+        // No strips, and nothing would ever complete: don't leave LVGL
+        // waiting for flush_ready
+        fleet_log("Warning: no DMA strips to copy a %d x %d area through, dropped", w, h);
+        if (ready)
+        {
+            ready(disp);
+        }
+    }
+}
+
+// A "frame" ends with the last flush of a refresh. The flush time is CPU
+// time in the flush callback (swap + queueing); the wire time overlaps
+// with rendering. Transactions per frame and bytes per transaction tell us
+// whether the DMA strip budget is worth raising; the share of the full
+// screen shows what DIRECT mode's dirty-row flushing saves.
+void FleetDisplay::frameDone()
+{
+    metrics_.flush_us.record(frame_flush_us);
+    metrics_.bytes.record(frame_px * FLEET_BYTES_PER_PIXEL);
+    metrics_.areas.record(frame_areas);
+    frame_areas = 0;
+
+    log_frames++;
+    log_flush_us += frame_flush_us;
+    log_px += frame_px;
+    if (frame_flush_us > log_max_us)
+    {
+        log_max_us = frame_flush_us;
+    }
+    frame_flush_us = frame_px = 0;
+
+    if (cfg.log_every == 0 || log_frames < cfg.log_every)
+    {
+        return;
+    }
+
+    // Bytes actually sent vs. pushing the full screen every frame
+    const FleetFlushStats &fs = pipe.stats();
+    const unsigned txn = fs.transactions ? fs.transactions : 1;
+    const uint64_t full_px = (uint64_t)cfg.width * cfg.height * log_frames;
+    fleet_log("flush[%s]: %u frames, avg %u us/frame, max %u us, avg %u px/frame (%u%% of full screen), "
+              "%u.%u txn/frame, %u B/txn",
+              cfg.render_swapped ? "swapped" : "legacy", (unsigned)log_frames, (unsigned)(log_flush_us / log_frames),
+              (unsigned)log_max_us, (unsigned)(log_px / log_frames), (unsigned)(log_px * 100 / full_px),
+              (unsigned)(fs.transactions / log_frames), (unsigned)(fs.transactions * 10 / log_frames % 10),
+              (unsigned)(fs.bytes / txn));
+    pipe.resetStats();
+    log_frames = log_flush_us = log_max_us = log_px = 0;
+}
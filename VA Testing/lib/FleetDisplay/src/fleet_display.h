@@ -0,0 +1,210 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  FleetDisplay
+ * Goal:    The LVGL "glue" every example used to copy: draw buffers, DMA
+ * strip buffers, the flush callback and the display setup.
+ *
+ * The pixels go out through a FleetTransport (lib/FleetGfx), so the same
+ * glue drives bb_spi_lcd on the device and an in-memory framebuffer on the
+ * host:
+ *
+ *     FleetDisplay display;
+ *     display.begin(&lcd, cfg);              // bb_spi_lcd (ESP32)
+ *     display.begin(&fb_transport, cfg);     // any FleetTransport
+ *
+ * Call lv_init() and lv_tick_set_cb() first; begin() creates the
+ * lv_display_t and makes it the default display.
+ *
+ * Drive LVGL with display.runOnce() from the main loop. It runs
+ * lv_timer_handler() (timed into metrics()) and then sleeps until LVGL's
+ * next timer is due. Touch, audio or any other task can cut the sleep
+ * short with display.scheduler().wake(). Invalidations made outside the
+ * handler wake it automatically. With FleetRenderTask
+ * (fleet_render_task.h) runOnce() moves to its own task.
+ *
+ * This is the one place flush-performance work lands.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#include "fleet_buf_size.h"
+#include "fleet_coalesce.h"
+#include "fleet_dirty_rows.h"
+#include "fleet_dma_strips.h"
+#include "fleet_flush_pipeline.h"
+#include "fleet_metrics.h"
+#include "fleet_panel.h"
+#include "fleet_scheduler.h"
+#include "fleet_te.h"
+#include "fleet_trace.h"
+#include "fleet_transport.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "fleet_bb_spi_transport.h"
+#endif
+
+// Default flush mode. The panels want big-endian RGB565 on the wire.
+// 1: LVGL renders LV_COLOR_FORMAT_RGB565_SWAPPED and px_map is pushed as-is.
+// 0: LVGL renders NATIVE and the flush byte-swaps (legacy).
+#ifndef FLEET_RENDER_SWAPPED
+#define FLEET_RENDER_SWAPPED 1
+#endif
+
+// Default render mode.
+// 0: PARTIAL, LVGL renders into draw buffers of 1/draw_buf_divisor screen.
+// 1: DIRECT, LVGL renders into a full-frame buffer in PSRAM
+//    (320x480 RGB565 = 300 KB each) and only the dirty rows are sent.
+#ifndef FLEET_DIRECT_MODE
+#define FLEET_DIRECT_MODE 0
+#endif
+
+// Default for FleetDisplayConfig::direct_double_buffer. DIRECT mode uses
+// one framebuffer unless this is 1: the dirty rows are sent from it, so
+// LVGL waits for their DMA before drawing the next frame. A second
+// frame (another 300 KB of PSRAM, and LVGL copying each frame's dirty
+// areas across) lets rendering overlap the DMA; worth it only if the
+// flush log shows the wait.
+#ifndef FLEET_DIRECT_DOUBLE_BUFFER
+#define FLEET_DIRECT_DOUBLE_BUFFER 0
+#endif
+
+// Default for FleetDisplayConfig::coalesce: merge invalidated areas when
+// that saves bus bytes (see fleet_coalesce.h)
+#ifndef FLEET_COALESCE
+#define FLEET_COALESCE 1
+#endif
+
+// Default for FleetDisplayConfig::te_divider: with a TE source, refresh
+// at most once every N panel frames (1: at the panel rate)
+#ifndef FLEET_TE_DIVIDER
+#define FLEET_TE_DIVIDER 1
+#endif
+
+// Default for FleetDisplayConfig::log_every (0 = never)
+#ifndef FLUSH_LOG_EVERY
+#define FLUSH_LOG_EVERY 30
+#endif
+
+struct FleetDisplayConfig
+{
+    int width = 0;  // panel size before rotation; 0: ask the LCD (bb_spi_lcd begin only)
+    int height = 0; // 0: ask the LCD (bb_spi_lcd begin only)
+    uint32_t draw_buf_divisor = 10; // each draw buffer covers 1/N of the screen (PARTIAL)
+    bool double_buffer = true;      // render the next area during the DMA (PARTIAL)
+    bool direct = FLEET_DIRECT_MODE; // full-frame buffer(s), dirty-row flushing
+    bool direct_double_buffer = FLEET_DIRECT_DOUBLE_BUFFER; // DIRECT: a second full frame
+    bool coalesce = FLEET_COALESCE;  // merge invalidated areas before rendering
+    uint32_t txn_overhead_bytes = FLEET_TXN_OVERHEAD_BYTES; // coalescing cost model
+    const char *panel = FLEET_PANEL; // controller, for its window rules (fleet_panel.h)
+    int rotation = FLEET_ROTATION;   // 0, 90 or 270 degrees, done in the flush (PARTIAL only)
+    bool render_swapped = FLEET_RENDER_SWAPPED;
+    size_t dma_budget_bytes = FLEET_DMA_BUDGET_BYTES;
+    uint32_t te_divider = FLEET_TE_DIVIDER; // panel frames per refresh, see syncToTe()
+    uint32_t log_every = FLUSH_LOG_EVERY; // frames between flush summaries
+};
+
+class FleetDisplay
+{
+public:
+#if defined(ARDUINO_ARCH_ESP32)
+    // Start the DMA worker for an already-initialised LCD and set up LVGL
+    bool begin(BB_SPI_LCD *lcd, const FleetDisplayConfig &cfg = FleetDisplayConfig());
+#endif
+    bool begin(FleetTransport *transport, const FleetDisplayConfig &cfg);
+
+    lv_display_t *display() const { return disp; }
+    FleetFlushPipeline &pipeline() { return pipe; }
+    const FleetDisplayConfig &config() const { return cfg; }
+    lv_color_format_t colorFormat() const;
+
+    // lv_timer_handler(), timed into metrics().handler_us. Returns its
+    // result (ms until LVGL next needs to run).
+    uint32_t timerHandler();
+
+    // timerHandler(), then sleep until it's due again or woken
+    void runOnce();
+
+    // Pace rendering to the panel's TE signal instead of LVGL's refresh
+    // timer (nullptr: back to LV_DEF_REFR_PERIOD). runOnce() then renders
+    // as soon as something is invalid, and each frame's first pixels wait
+    // for a vertical blanking, at most one frame per te_divider pulses.
+    void syncToTe(FleetTe *te);
+
+    // Send an image straight to the panel at (x, y), bypassing LVGL: no
+    // rendering, no pixel conversion. Meant for opaque full-screen images
+    // (boot splash, static backgrounds) that tools/fleet_image_convert.py
+    // stored as RGB565_SWAPPED; RGB565 is swapped on the way. Needs
+    // rotation 0, unpadded rows and a window the panel accepts; false
+    // otherwise. Blocks until sent. LVGL doesn't know: its next refresh
+    // draws over it. Call it from LVGL's task, between runOnce() calls.
+    bool pushImage(const lv_image_dsc_t *img, int x = 0, int y = 0);
+
+    FleetMetrics &metrics() { return metrics_; }
+    FleetScheduler &scheduler() { return sched; }
+
+    // Serial console commands: FleetMetrics' 'm'/'r', plus 't' to write
+    // out LVGL's profiler buffer and fleet_trace (FLEET_PROFILE builds)
+    void handleCommand(int c);
+
+private:
+    static void flushCb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void flushWaitCb(lv_display_t *disp);
+    static void flushDone(void *ctx);
+    static void flushDoneLast(void *ctx);
+    static void eventCb(lv_event_t *e);
+    void roundArea(lv_area_t *area);
+    void coalesceInvalid();
+    void waitForBlanking();
+    void flushPartial(const lv_area_t *area, const uint8_t *px_map, bool last);
+    void flushDirect(const lv_area_t *area, const uint8_t *px_map, bool last);
+    void flushArea(int x, int y, int w, int h, const uint16_t *px, FleetFlushPipeline::ready_cb_t ready);
+    void frameDone();
+
+    FleetDisplayConfig cfg;
+    lv_display_t *disp = nullptr;
+    lv_draw_buf_t draw_bufs[2];
+    FleetDmaStrips dma_strips = {};
+    uint16_t dma_row_fallback[2][512];
+    FleetFlushPipeline pipe;
+    FleetDirtyRows dirty_rows; // DIRECT mode: this frame's changed rows
+    FleetCoalescer coalescer;
+    const FleetPanelQuirks *quirks = nullptr;
+    bool round_areas = false;   // quirks restrict the window
+    uint32_t rounded_areas = 0; // invalidations grown by roundArea()
+    uint64_t rounded_px_in = 0;
+    uint64_t rounded_px_out = 0;
+    FleetScheduler sched;
+    FleetTe *te = nullptr;
+    uint32_t te_last = 0; // pulse the previous frame went out on
+    std::atomic<bool> in_handler{false}; // read by other tasks' invalidations
+#if defined(ARDUINO_ARCH_ESP32)
+    FleetBbSpiTransport bb_transport;
+#endif
+
+    // Flush accounting, see frameDone()
+    uint32_t frame_flush_us = 0;
+    uint32_t frame_px = 0;
+    uint32_t log_frames = 0;
+    uint32_t log_flush_us = 0;
+    uint32_t log_max_us = 0;
+    uint32_t log_px = 0;
+
+    // Metrics, see eventCb() and flushDoneLast()
+    FleetMetrics metrics_;
+    uint32_t frame_areas = 0;
+    uint32_t total_flush_us = 0;  // flush callback time, running total
+    uint32_t render_t0 = 0;       // LV_EVENT_RENDER_START
+    uint32_t render_flush_us = 0; // total_flush_us at RENDER_START
+    uint32_t inval_t0 = 0;        // first invalidation not yet rendered
+    bool inval_pending = false;
+    uint32_t frame_inval_t0 = 0;  // ... of the frame being rendered
+    bool frame_inval = false;
+    uint32_t glass_inval_t0 = 0;  // ... of the frame whose last area is queued
+    bool glass_inval = false;
+};
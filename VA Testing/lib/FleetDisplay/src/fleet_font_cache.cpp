@@ -0,0 +1,121 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_font_cache (see fleet_font_cache.h)
+ */
+
+#include "fleet_font_cache.h"
+#include "fleet_port.h"
+
+#include <atomic>
+
+// lv_draw_buf_t's header and data
+#include "src/draw/lv_draw_buf_private.h"
+
+// The wrapper LVGL sees; `font` first, so the lv_font_t * LVGL hands back
+// (resolved_font) is also the CachedFont *
+struct CachedFont
+{
+    lv_font_t font;
+    const lv_font_t *orig;
+};
+
+static CachedFont cached_fonts[FLEET_FONT_CACHE_FONTS];
+static int cached_count = 0;
+static FleetGlyphCache glyphs;
+static std::atomic<bool> bypass{false};
+
+static bool cached_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letter_next)
+{
+    const lv_font_t *orig = ((const CachedFont *)font)->orig;
+    return orig->get_glyph_dsc(orig, dsc, letter, letter_next);
+}
+
+// The original unpacks into draw_buf (reshaped by LVGL to A8, box_w x
+// box_h) and returns it; anything else (raw bitmaps, images) passes
+// through uncached
+static const void *cached_glyph_bitmap(lv_font_glyph_dsc_t *g, lv_draw_buf_t *draw_buf)
+{
+    const lv_font_t *font = g->resolved_font;
+    const lv_font_t *orig = ((const CachedFont *)font)->orig;
+    const bool cacheable = !bypass.load(std::memory_order_relaxed) && draw_buf != nullptr &&
+                           g->format >= LV_FONT_GLYPH_FORMAT_A1 && g->format <= LV_FONT_GLYPH_FORMAT_A8 &&
+                           draw_buf->header.cf == LV_COLOR_FORMAT_A8 && draw_buf->header.w >= g->box_w &&
+                           draw_buf->header.h >= g->box_h;
+
+    const FleetGlyphKey key = {orig, g->gid.index, (uint16_t)g->box_w, (uint16_t)g->box_h};
+    if (cacheable && glyphs.get(key, draw_buf->data, draw_buf->header.stride))
+    {
+        return draw_buf;
+    }
+
+    g->resolved_font = orig;
+    const void *bitmap = orig->get_glyph_bitmap(g, draw_buf);
+    g->resolved_font = font;
+    if (cacheable && bitmap == draw_buf)
+    {
+        glyphs.put(key, draw_buf->data, draw_buf->header.stride);
+    }
+    return bitmap;
+}
+
+void fleet_font_cache_begin(size_t budget_bytes)
+{
+    glyphs.begin(budget_bytes);
+}
+
+const lv_font_t *fleet_font_cached(const lv_font_t *font)
+{
+    if (font == nullptr || !glyphs.enabled())
+    {
+        return font;
+    }
+    for (int i = 0; i < cached_count; i++)
+    {
+        if (cached_fonts[i].orig == font || &cached_fonts[i].font == font)
+        {
+            return &cached_fonts[i].font;
+        }
+    }
+    if (cached_count == FLEET_FONT_CACHE_FONTS)
+    {
+        fleet_log("glyph cache: no room to wrap another font");
+        return font;
+    }
+    CachedFont *c = &cached_fonts[cached_count++];
+    c->orig = font;
+    c->font = *font; // metrics, kerning, fallback
+    c->font.get_glyph_dsc = cached_glyph_dsc;
+    c->font.get_glyph_bitmap = cached_glyph_bitmap;
+    c->font.release_glyph = nullptr; // cached bitmaps belong to the cache
+    return &c->font;
+}
+
+void fleet_font_cache_enable(bool on)
+{
+    bypass = !on;
+}
+
+bool fleet_font_cache_enabled(void)
+{
+    return glyphs.enabled() && !bypass;
+}
+
+FleetGlyphCacheStats fleet_font_cache_stats(void)
+{
+    return glyphs.stats();
+}
+
+void fleet_font_cache_reset_stats(void)
+{
+    glyphs.resetStats();
+}
+
+void fleet_font_cache_dump(void)
+{
+    const FleetGlyphCacheStats s = glyphs.stats();
+    const uint32_t lookups = s.hits + s.misses;
+    fleet_log("glyph cache: %u/%u B used, %u glyphs in %d font(s), %u lookups, %u%% hits, %u misses, %u evictions%s",
+              (unsigned)s.bytes, (unsigned)s.budget, (unsigned)s.entries, cached_count, (unsigned)lookups,
+              (unsigned)(lookups ? s.hits * 100ull / lookups : 0), (unsigned)s.misses, (unsigned)s.evictions,
+              bypass ? " (bypassed)" : "");
+}
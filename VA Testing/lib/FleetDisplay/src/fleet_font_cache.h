@@ -0,0 +1,53 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_font_cache
+ * Goal:    Plug the PSRAM glyph cache (lib/FleetGfx/src/fleet_glyph_cache.h)
+ * into LVGL's font engine.
+ *
+ * LVGL's built-in fonts are packed 1-4 bpp bitmaps; the software renderer
+ * asks the font for every letter on every frame, and the font unpacks it
+ * into an 8-bit alpha draw buffer. fleet_font_cached() returns a copy of a
+ * font whose get_glyph_bitmap serves that buffer from the cache instead,
+ * keyed by (font, glyph id, box size). LVGL resolves the codepoint to the
+ * glyph id before it asks for the bitmap, so the id stands in for it.
+ *
+ * Use the returned font wherever the original went:
+ *
+ *     lv_obj_set_style_text_font(label, fleet_font_cached(&lv_font_montserrat_48), 0);
+ *
+ * The budget comes from -D FLEET_GLYPH_CACHE_BYTES (0: off, and
+ * fleet_font_cached() hands back the font itself). FleetDisplay::begin()
+ * calls fleet_font_cache_begin(); 'm' on the console prints the counters.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "lvgl.h"
+
+#include "fleet_glyph_cache.h"
+
+#ifndef FLEET_GLYPH_CACHE_BYTES
+#define FLEET_GLYPH_CACHE_BYTES 0
+#endif
+
+// Distinct fonts that can be wrapped
+#define FLEET_FONT_CACHE_FONTS 8
+
+// Call once, after lv_init()
+void fleet_font_cache_begin(size_t budget_bytes);
+
+// The cached twin of `font` (the same one for repeated calls), or `font`
+// itself if the cache is off or FLEET_FONT_CACHE_FONTS are taken
+const lv_font_t *fleet_font_cached(const lv_font_t *font);
+
+// Bypass the cache without touching the fonts in use, for A/B runs
+void fleet_font_cache_enable(bool on);
+bool fleet_font_cache_enabled(void);
+
+FleetGlyphCacheStats fleet_font_cache_stats(void);
+void fleet_font_cache_reset_stats(void);
+
+// One line via fleet_log()
+void fleet_font_cache_dump(void);
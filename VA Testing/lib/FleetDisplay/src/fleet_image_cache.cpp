@@ -0,0 +1,177 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_image_cache (see fleet_image_cache.h)
+ */
+
+#include "fleet_image_cache.h"
+#include "fleet_port.h"
+
+#include "lvgl.h"
+
+// The cache objects, their classes and the draw-buffer handlers are only
+// in LVGL's private headers
+#include "src/core/lv_global.h"
+#include "src/draw/lv_draw_buf_private.h"
+#include "src/misc/cache/lv_cache_private.h"
+
+// Decoded images: same over-allocation as LVGL's default allocator (the
+// align callback rounds the pointer up), but from PSRAM
+static void *image_buf_malloc(size_t size, lv_color_format_t cf)
+{
+    (void)cf;
+    return fleet_malloc(size + LV_DRAW_BUF_ALIGN - 1, FLEET_MEM_PSRAM);
+}
+
+static void image_buf_free(void *buf)
+{
+    fleet_free(buf);
+}
+
+// One wrapped cache: its own copy of the class with counting callbacks.
+// They all run under the cache's lock, so plain counters are enough.
+//
+// get_cb alone can't tell a hit from lv_cache_drop()'s own lookup, which
+// goes through it too, and remove_cb serves both eviction and drop. So:
+//   - evictions: get_victim_cb picking a victim (only the eviction path
+//     asks for one); the remove_cb that follows is for that victim
+//   - drops: any other remove_cb. Each came from a drop's lookup that
+//     found the entry, so it takes that lookup back out of the hits.
+//   - misses: add_cb, the entry a decoder-path miss inserts once decoded.
+//     A drop's lookup that finds nothing adds nothing, so it isn't one.
+struct TrackedCache
+{
+    lv_cache_t *cache;
+    const lv_cache_class_t *orig;
+    lv_cache_class_t clz;
+    lv_cache_entry_t *victim;
+    FleetCacheStats stats;
+};
+
+static TrackedCache tracked[2]; // 0: images, 1: headers
+
+static TrackedCache *find(lv_cache_t *cache)
+{
+    return tracked[0].cache == cache ? &tracked[0] : &tracked[1];
+}
+
+static lv_cache_entry_t *counted_get(lv_cache_t *cache, const void *key, void *user_data)
+{
+    TrackedCache *t = find(cache);
+    lv_cache_entry_t *entry = t->orig->get_cb(cache, key, user_data);
+    if (entry != nullptr)
+    {
+        t->stats.hits++;
+    }
+    return entry;
+}
+
+static lv_cache_entry_t *counted_add(lv_cache_t *cache, const void *key, void *user_data)
+{
+    TrackedCache *t = find(cache);
+    lv_cache_entry_t *entry = t->orig->add_cb(cache, key, user_data);
+    if (entry != nullptr)
+    {
+        t->stats.misses++;
+    }
+    return entry;
+}
+
+static lv_cache_entry_t *counted_get_victim(lv_cache_t *cache, void *user_data)
+{
+    TrackedCache *t = find(cache);
+    t->victim = t->orig->get_victim_cb(cache, user_data);
+    if (t->victim != nullptr)
+    {
+        t->stats.evictions++;
+    }
+    return t->victim;
+}
+
+static void counted_remove(lv_cache_t *cache, lv_cache_entry_t *entry, void *user_data)
+{
+    TrackedCache *t = find(cache);
+    if (entry != t->victim)
+    {
+        t->stats.drops++;
+        if (t->stats.hits > 0)
+        {
+            t->stats.hits--;
+        }
+    }
+    t->victim = nullptr;
+    t->orig->remove_cb(cache, entry, user_data);
+}
+
+static void track(TrackedCache *t, lv_cache_t *cache)
+{
+    t->cache = cache;
+    t->stats = FleetCacheStats();
+    if (cache == nullptr || t->orig != nullptr)
+    {
+        return;
+    }
+    t->orig = cache->clz;
+    t->clz = *cache->clz;
+    t->clz.get_cb = counted_get;
+    t->clz.add_cb = counted_add;
+    t->clz.get_victim_cb = counted_get_victim;
+    t->clz.remove_cb = counted_remove;
+    cache->clz = &t->clz;
+}
+
+void fleet_image_cache_begin(void)
+{
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_image_handlers();
+    handlers->buf_malloc_cb = image_buf_malloc;
+    handlers->buf_free_cb = image_buf_free;
+
+    track(&tracked[0], LV_GLOBAL_DEFAULT()->img_cache);
+    track(&tracked[1], LV_GLOBAL_DEFAULT()->img_header_cache);
+}
+
+void fleet_image_cache_stats(FleetCacheStats *images, FleetCacheStats *headers)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        TrackedCache *t = &tracked[i];
+        if (t->cache != nullptr)
+        {
+            t->stats.size = lv_cache_get_size(t->cache, nullptr);
+            t->stats.max_size = lv_cache_get_max_size(t->cache, nullptr);
+        }
+    }
+    if (images != nullptr)
+    {
+        *images = tracked[0].stats;
+    }
+    if (headers != nullptr)
+    {
+        *headers = tracked[1].stats;
+    }
+}
+
+void fleet_image_cache_reset_stats(void)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        FleetCacheStats &s = tracked[i].stats;
+        s.hits = s.misses = s.evictions = s.drops = 0;
+    }
+}
+
+static void dump_one(const char *name, const char *unit, const FleetCacheStats &s)
+{
+    const uint32_t lookups = s.hits + s.misses;
+    fleet_log("%s cache: %u/%u %s used, %u lookups, %u%% hits, %u misses, %u evictions, %u drops", name,
+              (unsigned)s.size, (unsigned)s.max_size, unit, (unsigned)lookups,
+              (unsigned)(lookups ? s.hits * 100ull / lookups : 0), (unsigned)s.misses, (unsigned)s.evictions,
+              (unsigned)s.drops);
+}
+
+void fleet_image_cache_dump(void)
+{
+    FleetCacheStats images, headers;
+    fleet_image_cache_stats(&images, &headers);
+    dump_one("image", "B", images);
+    dump_one("image header", "entries", headers);
+}
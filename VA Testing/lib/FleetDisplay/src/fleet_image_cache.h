@@ -0,0 +1,46 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_image_cache
+ * Goal:    Keep decoded images in PSRAM and count how well LVGL's image
+ * caches work, so their sizes come from real screens.
+ *
+ * LVGL has two caches, both sized in lv_conf.h from per-env build flags:
+ *
+ *   - images:  decoded pixels, LV_CACHE_DEF_SIZE bytes
+ *              (-D FLEET_IMAGE_CACHE_BYTES)
+ *   - headers: image sizes/formats, LV_IMAGE_HEADER_CACHE_DEF_CNT entries
+ *              (-D FLEET_IMAGE_HEADER_CACHE_CNT)
+ *
+ * fleet_image_cache_begin() points LVGL's image draw-buffer allocator at
+ * PSRAM directly (not through lv_malloc, so they never count against
+ * LVGL's heap caps) and wraps both caches' class callbacks to count hits,
+ * misses, evictions and drops. FleetDisplay::begin() calls it. The 'm'
+ * console command prints the counters.
+ *
+ * A low hit rate with evictions: the cache is too small for the screen.
+ * A high hit rate with a max size far above the used size: it can shrink.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct FleetCacheStats
+{
+    uint32_t hits;      // lookups that found the entry
+    uint32_t misses;    // entries added after a decode (or header read)
+    uint32_t evictions; // entries LVGL picked as victims to make room
+    uint32_t drops;     // entries removed by lv_cache_drop() (image invalidation)
+    size_t size;        // in use: bytes (images) or entries (headers)
+    size_t max_size;    // capacity, same unit; 0 = cache off
+};
+
+// Call once, after lv_init()
+void fleet_image_cache_begin(void);
+
+void fleet_image_cache_stats(FleetCacheStats *images, FleetCacheStats *headers);
+void fleet_image_cache_reset_stats(void);
+
+// One line per cache via fleet_log()
+void fleet_image_cache_dump(void);
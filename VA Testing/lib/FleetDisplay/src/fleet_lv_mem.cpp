@@ -0,0 +1,104 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_lv_mem (see fleet_lv_mem.h)
+ */
+
+#include "fleet_lv_mem.h"
+#include "fleet_port.h"
+#include "fleet_tiered_alloc.h"
+
+#include "lvgl.h"
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+void lv_mem_init(void)
+{
+    if (!fleet_lv_alloc.begin())
+    {
+        fleet_log("alloc: could not set up the LVGL heap");
+    }
+}
+
+void lv_mem_deinit(void)
+{
+    fleet_lv_alloc.end();
+}
+
+// Extra pools are a builtin-heap feature; the tiers grow on their own
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
+{
+    (void)mem;
+    (void)bytes;
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    (void)pool;
+}
+
+void *lv_malloc_core(size_t size)
+{
+    return fleet_lv_alloc.allocate(size);
+}
+
+void *lv_realloc_core(void *p, size_t new_size)
+{
+    return fleet_lv_alloc.reallocate(p, new_size);
+}
+
+void lv_free_core(void *p)
+{
+    fleet_lv_alloc.release(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
+{
+    const FleetTieredConfig &cfg = fleet_lv_alloc.config();
+    const FleetTierStats in = fleet_lv_alloc.stats(FLEET_TIER_INTERNAL);
+    const FleetTierStats ps = fleet_lv_alloc.stats(FLEET_TIER_PSRAM);
+
+    // Sized to our caps, not the chip's heaps, so used_pct means the same
+    // as with the builtin pool
+    const size_t total = cfg.internal_max + cfg.psram_max;
+    const size_t used = in.used + ps.used;
+    mon_p->total_size = total;
+    mon_p->free_size = total > used ? total - used : 0;
+    mon_p->free_biggest_size = in.largest_free > ps.largest_free ? in.largest_free : ps.largest_free;
+    mon_p->free_cnt = 0;
+    mon_p->used_cnt = in.blocks + ps.blocks;
+    mon_p->max_used = in.peak + ps.peak;
+    mon_p->used_pct = total ? (uint8_t)(used * 100 / total) : 0;
+    mon_p->frag_pct = (uint8_t)fleet_lv_alloc.fragmentation(FLEET_TIER_INTERNAL);
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    return LV_RESULT_OK;
+}
+
+void fleet_lv_mem_dump(void)
+{
+    fleet_lv_alloc.dump();
+}
+
+void fleet_lv_mem_reset_peaks(void)
+{
+    fleet_lv_alloc.resetPeaks();
+}
+
+#else
+
+void fleet_lv_mem_dump(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    fleet_log("alloc: builtin pool used %u of %u peak %u frag %u%%", (unsigned)(mon.total_size - mon.free_size),
+              (unsigned)mon.total_size, (unsigned)mon.max_used, (unsigned)mon.frag_pct);
+}
+
+void fleet_lv_mem_reset_peaks(void)
+{
+}
+
+#endif
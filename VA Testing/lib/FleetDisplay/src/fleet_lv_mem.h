@@ -0,0 +1,19 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_lv_mem
+ * Goal:    LVGL's lv_malloc() on top of the tiered allocator
+ * (lib/FleetGfx/src/fleet_tiered_alloc.h) instead of the fixed 64 KB
+ * builtin pool.
+ *
+ * lv_conf.h selects LV_STDLIB_CUSTOM unless -D FLEET_TIERED_ALLOC=0; this
+ * file then provides LVGL's lv_*_core() hooks. lv_mem_monitor() still
+ * works: its totals are the sum of both tiers, the fragmentation that of
+ * the internal tier. The 'm' console command prints per-tier lines.
+ */
+
+#pragma once
+
+// One line per tier via fleet_log(); a note if the builtin pool is in use
+void fleet_lv_mem_dump(void);
+
+void fleet_lv_mem_reset_peaks(void);
@@ -0,0 +1,182 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  FleetRenderTask (see fleet_render_task.h)
+ */
+
+#include "fleet_render_task.h"
+#include "fleet_port.h"
+
+// The render loop: run whatever was posted (under one lock), then let
+// runOnce() render and sleep. Posting wakes the scheduler, so work never
+// waits out a full sleep.
+void *FleetRenderTask::taskMain(void *arg)
+{
+    FleetRenderTask *self = (FleetRenderTask *)arg;
+    while (!self->stop.load())
+    {
+        Work work;
+        if (self->take(&work))
+        {
+            lv_lock();
+            do
+            {
+                work.fn(work.ctx);
+                self->executed++;
+            } while (self->take(&work));
+            lv_unlock();
+        }
+        self->display->runOnce();
+    }
+    return nullptr;
+}
+
+void FleetRenderTask::lock()
+{
+    lv_lock();
+}
+
+void FleetRenderTask::unlock()
+{
+    lv_unlock();
+    display->scheduler().wake();
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+bool FleetRenderTask::begin(FleetDisplay *disp, const FleetRenderTaskConfig &config)
+{
+#if LV_USE_OS == LV_OS_NONE
+    (void)disp;
+    (void)config;
+    fleet_log("FATAL ERROR: FleetRenderTask needs -D FLEET_RENDER_TASK=1 (LV_USE_OS)");
+    return false;
+#else
+    display = disp;
+    cfg = config;
+    stop = false;
+    queue = xQueueCreate(cfg.queue_len, sizeof(Work));
+    exited = xSemaphoreCreateBinary();
+    if (queue == nullptr || exited == nullptr)
+    {
+        fleet_log("FATAL ERROR: Failed to create the render task queue");
+        return false;
+    }
+
+    // FreeRTOS task entry points return void
+    auto entry = [](void *arg) {
+        FleetRenderTask *self = (FleetRenderTask *)arg;
+        taskMain(self);
+        xSemaphoreGive(self->exited);
+        vTaskDelete(nullptr);
+    };
+    if (xTaskCreatePinnedToCore(entry, "fleet_render", cfg.stack_bytes, this, cfg.priority, &task, cfg.core) !=
+        pdPASS)
+    {
+        fleet_log("FATAL ERROR: Failed to start the render task");
+        return false;
+    }
+    fleet_log("Render task: core %d, priority %u, %u byte stack", cfg.core, cfg.priority,
+              (unsigned)cfg.stack_bytes);
+    return true;
+#endif
+}
+
+void FleetRenderTask::end()
+{
+    if (task == nullptr)
+    {
+        return;
+    }
+    stop = true;
+    display->scheduler().wake();
+    xSemaphoreTake(exited, portMAX_DELAY);
+    task = nullptr;
+}
+
+bool FleetRenderTask::post(work_fn_t fn, void *ctx)
+{
+    const Work work = {fn, ctx};
+    if (xQueueSend(queue, &work, 0) != pdTRUE)
+    {
+        rejected++;
+        return false;
+    }
+    posted++;
+    display->scheduler().wake();
+    return true;
+}
+
+bool FleetRenderTask::take(Work *work)
+{
+    return xQueueReceive(queue, work, 0) == pdTRUE;
+}
+
+#else // Host: a pthread stands in for the FreeRTOS task (core and priority are ignored)
+
+bool FleetRenderTask::begin(FleetDisplay *disp, const FleetRenderTaskConfig &config)
+{
+#if LV_USE_OS == LV_OS_NONE
+    (void)disp;
+    (void)config;
+    fleet_log("FATAL ERROR: FleetRenderTask needs -D FLEET_RENDER_TASK=1 (LV_USE_OS)");
+    return false;
+#else
+    display = disp;
+    cfg = config;
+    stop = false;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, cfg.stack_bytes < 64 * 1024 ? 64 * 1024 : cfg.stack_bytes);
+    started = pthread_create(&thread, &attr, taskMain, this) == 0;
+    pthread_attr_destroy(&attr);
+    if (!started)
+    {
+        fleet_log("FATAL ERROR: Failed to start the render thread");
+        return false;
+    }
+    return true;
+#endif
+}
+
+void FleetRenderTask::end()
+{
+    if (!started)
+    {
+        return;
+    }
+    stop = true;
+    display->scheduler().wake();
+    pthread_join(thread, nullptr);
+    started = false;
+}
+
+bool FleetRenderTask::post(work_fn_t fn, void *ctx)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (queue.size() >= cfg.queue_len)
+        {
+            rejected++;
+            return false;
+        }
+        queue.push_back({fn, ctx});
+    }
+    posted++;
+    display->scheduler().wake();
+    return true;
+}
+
+bool FleetRenderTask::take(Work *work)
+{
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (queue.empty())
+    {
+        return false;
+    }
+    *work = queue.front();
+    queue.pop_front();
+    return true;
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  FleetRenderTask
+ * Goal:    Give LVGL its own task, so audio and network work in other
+ * tasks never share a loop with rendering.
+ *
+ * Needs -D FLEET_RENDER_TASK=1, which switches LV_USE_OS to FreeRTOS
+ * (device) or pthreads (host) in lv_conf.h, so lv_timer_handler() takes
+ * LVGL's global lock and draw units can run in their own threads.
+ *
+ *     static FleetRenderTask render;
+ *     render.begin(&display);                 // after the UI is built
+ *
+ *     // From any other task:
+ *     render.post(show_reply, reply);         // runs on the render task
+ *     render.lock();                          // or touch LVGL directly
+ *     lv_label_set_text(status, "Listening");
+ *     render.unlock();
+ *
+ * post() is the preferred way in: it never blocks the caller, and the
+ * work runs between two frames, with the LVGL lock held. lock()/unlock()
+ * suit short edits from a task that can afford to wait for a frame to
+ * finish.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#else
+#include <deque>
+#include <mutex>
+#include <pthread.h>
+#endif
+
+#include "fleet_display.h"
+
+#ifndef FLEET_RENDER_TASK
+#define FLEET_RENDER_TASK 0
+#endif
+
+struct FleetRenderTaskConfig
+{
+    int core = 1;                     // device only; the DMA worker is on core 0
+    unsigned priority = 2;            // device only; above loopTask (1), below the DMA worker (5)
+    uint32_t stack_bytes = 16 * 1024; // LVGL's layout and event code likes stack
+    uint32_t queue_len = 16;          // posted work items
+};
+
+class FleetRenderTask
+{
+public:
+    typedef void (*work_fn_t)(void *ctx);
+
+    // Start running display->runOnce() forever in a new task
+    bool begin(FleetDisplay *display, const FleetRenderTaskConfig &cfg = FleetRenderTaskConfig());
+
+    // Stop the task after its current frame and wait for it to exit
+    void end();
+
+    // Queue fn(ctx) for the render task and wake it. Never blocks: returns
+    // false if the queue is full. Not for ISRs (use the scheduler's
+    // wakeFromISR() and let a task post).
+    bool post(work_fn_t fn, void *ctx);
+
+    // Direct LVGL access from another task. unlock() wakes the render task
+    // so the change is drawn without waiting for the next timer.
+    void lock();
+    void unlock();
+
+    // Counters since begin()
+    std::atomic<uint32_t> posted{0};
+    std::atomic<uint32_t> executed{0};
+    std::atomic<uint32_t> rejected{0};
+
+private:
+    struct Work
+    {
+        work_fn_t fn;
+        void *ctx;
+    };
+
+    static void *taskMain(void *arg);
+    bool take(Work *work);
+
+    FleetDisplay *display = nullptr;
+    FleetRenderTaskConfig cfg;
+    std::atomic<bool> stop{false};
+#if defined(ARDUINO_ARCH_ESP32)
+    QueueHandle_t queue = nullptr;
+    SemaphoreHandle_t exited = nullptr;
+    TaskHandle_t task = nullptr;
+#else
+    std::mutex queue_mutex;
+    std::deque<Work> queue;
+    pthread_t thread;
+    bool started = false;
+#endif
+};
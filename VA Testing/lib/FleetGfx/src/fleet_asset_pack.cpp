@@ -0,0 +1,236 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_asset_pack (see fleet_asset_pack.h)
+ */
+
+#include "fleet_asset_pack.h"
+#include "fleet_port.h"
+
+#include <string.h>
+
+FleetAssetPack fleet_assets;
+
+// zlib's reflected CRC-32 table, filled in by its constructor: a static
+// one is built before main(), so no caller ever sees it half-filled
+struct Crc32Table
+{
+    uint32_t entry[256];
+
+    Crc32Table()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+            {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entry[i] = c;
+        }
+    }
+};
+
+static const Crc32Table crc32_table;
+
+uint32_t fleet_crc32(const void *data, size_t len, uint32_t crc)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--)
+    {
+        crc = crc32_table.entry[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool FleetAssetPack::mount(const void *image, size_t image_size)
+{
+    const FleetAssetHeader *h = (const FleetAssetHeader *)image;
+    if (image_size < sizeof(FleetAssetHeader) || h->magic != FLEET_ASSET_MAGIC)
+    {
+        fleet_log("assets: no asset image (bad magic)");
+        return false;
+    }
+    if (h->version != FLEET_ASSET_VERSION || h->total_size > image_size ||
+        sizeof(FleetAssetHeader) + (size_t)h->count * sizeof(FleetAssetEntry) > h->total_size)
+    {
+        fleet_log("assets: unsupported or truncated image (version %u, %u of %u bytes)", (unsigned)h->version,
+                  (unsigned)image_size, (unsigned)h->total_size);
+        return false;
+    }
+    const FleetAssetEntry *d = (const FleetAssetEntry *)(h + 1);
+    for (int i = 0; i < h->count; i++)
+    {
+        if (memchr(d[i].name, 0, FLEET_ASSET_NAME_MAX) == nullptr || d[i].offset > h->total_size ||
+            d[i].size > h->total_size - d[i].offset || (i > 0 && strcmp(d[i - 1].name, d[i].name) >= 0))
+        {
+            fleet_log("assets: bad directory entry %d", i);
+            return false;
+        }
+    }
+    base = (const uint8_t *)image;
+    header = h;
+    dir = d;
+    return true;
+}
+
+const FleetAssetEntry *FleetAssetPack::find(const char *name) const
+{
+    int lo = 0, hi = count() - 1;
+    while (lo <= hi)
+    {
+        const int mid = (lo + hi) / 2;
+        const int c = strcmp(dir[mid].name, name);
+        if (c == 0)
+        {
+            return &dir[mid];
+        }
+        if (c < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid - 1;
+        }
+    }
+    return nullptr;
+}
+
+bool FleetAssetPack::verify() const
+{
+    return mounted() &&
+           fleet_crc32(base + sizeof(FleetAssetHeader), header->total_size - sizeof(FleetAssetHeader)) ==
+               header->data_crc;
+}
+
+bool FleetAssetPack::verify(const FleetAssetEntry *e) const
+{
+    return mounted() && fleet_crc32(data(e), e->size) == e->crc;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <esp_idf_version.h>
+#include <esp_partition.h>
+#if ESP_IDF_VERSION_MAJOR < 5
+#include <esp_spi_flash.h>
+#endif
+
+bool FleetAssetPack::mountPartition(const char *label)
+{
+    unmount();
+    const esp_partition_t *part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)FLEET_ASSET_SUBTYPE, label);
+    if (part == nullptr)
+    {
+        fleet_log("assets: no '%s' partition (see partitions_16MB_assets.csv)", label);
+        return false;
+    }
+
+    // Map only what the image uses, not the whole partition: the MMU's
+    // data window is shared with PSRAM and the app's rodata
+    FleetAssetHeader h;
+    if (esp_partition_read(part, 0, &h, sizeof(h)) != ESP_OK || h.magic != FLEET_ASSET_MAGIC ||
+        h.total_size > part->size)
+    {
+        fleet_log("assets: partition '%s' holds no asset image", label);
+        return false;
+    }
+
+    const void *ptr = nullptr;
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_mmap_handle_t handle;
+    const esp_err_t err = esp_partition_mmap(part, 0, h.total_size, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+#else
+    spi_flash_mmap_handle_t handle;
+    const esp_err_t err = esp_partition_mmap(part, 0, h.total_size, SPI_FLASH_MMAP_DATA, &ptr, &handle);
+#endif
+    if (err != ESP_OK)
+    {
+        fleet_log("assets: mmap of %u bytes failed (%d)", (unsigned)h.total_size, (int)err);
+        return false;
+    }
+    if (!mount(ptr, h.total_size))
+    {
+#if ESP_IDF_VERSION_MAJOR >= 5
+        esp_partition_munmap(handle);
+#else
+        spi_flash_munmap(handle);
+#endif
+        return false;
+    }
+    map_handle = (uint32_t)handle;
+    map_len = h.total_size;
+    fleet_log("assets: %d files, %u bytes mapped at %p", count(), (unsigned)map_len, ptr);
+    return true;
+}
+
+void FleetAssetPack::unmount()
+{
+    if (map_len != 0)
+    {
+#if ESP_IDF_VERSION_MAJOR >= 5
+        esp_partition_munmap((esp_partition_mmap_handle_t)map_handle);
+#else
+        spi_flash_munmap((spi_flash_mmap_handle_t)map_handle);
+#endif
+    }
+    base = nullptr;
+    header = nullptr;
+    dir = nullptr;
+    map_handle = 0;
+    map_len = 0;
+}
+
+#else // Host
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool FleetAssetPack::mountFile(const char *path)
+{
+    unmount();
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fleet_log("assets: cannot open %s", path);
+        return false;
+    }
+    struct stat st;
+    void *ptr = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // the mapping stays valid
+    if (ptr == MAP_FAILED)
+    {
+        fleet_log("assets: cannot map %s", path);
+        return false;
+    }
+    if (!mount(ptr, (size_t)st.st_size))
+    {
+        munmap(ptr, (size_t)st.st_size);
+        return false;
+    }
+    map_len = (size_t)st.st_size;
+    return true;
+}
+
+void FleetAssetPack::unmount()
+{
+    if (map_len != 0)
+    {
+        munmap((void *)base, map_len);
+    }
+    base = nullptr;
+    header = nullptr;
+    dir = nullptr;
+    map_handle = 0;
+    map_len = 0;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_asset_pack
+ * Goal:    Read images and fonts straight out of a flash partition that is
+ * memory-mapped at boot, instead of compiling them in as C arrays.
+ *
+ * tools/fleet_asset_pack.py packs a directory into one image:
+ *
+ *     FleetAssetHeader                      16 bytes
+ *     FleetAssetEntry[count]                56 bytes each, sorted by name
+ *     file data, each file 16-byte aligned
+ *
+ * all little-endian. data_crc is the CRC-32 (zlib's) of everything after
+ * the header. The image goes to the "assets" partition
+ * (partitions_16MB_assets.csv):
+ *
+ *     python tools/fleet_asset_pack.py assets -o .pio/assets.bin
+ *     esptool.py write_flash 0xA10000 .pio/assets.bin
+ *
+ * On the device mountPartition() maps it into the data address space
+ * (esp_partition_mmap), so data() pointers are directly readable flash:
+ * no copy to RAM, the cache does the rest. On the host mountFile() mmaps
+ * a packed file the same way. LVGL reaches it through
+ * lib/FleetDisplay/src/fleet_asset_fs.h.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLEET_ASSET_MAGIC 0x41544C46u // "FLTA"
+#define FLEET_ASSET_VERSION 1
+#define FLEET_ASSET_NAME_MAX 40 // including the NUL
+#define FLEET_ASSET_ALIGN 16
+#define FLEET_ASSET_SUBTYPE 0x40 // data partition subtype in the CSV
+
+struct FleetAssetHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;      // directory entries
+    uint32_t total_size; // whole image, header included
+    uint32_t data_crc;   // CRC-32 of bytes [16, total_size)
+};
+
+struct FleetAssetEntry
+{
+    char name[FLEET_ASSET_NAME_MAX]; // path relative to the packed directory, '/'-separated
+    uint32_t offset;                 // from the start of the image
+    uint32_t size;
+    uint32_t crc;                    // CRC-32 of the file
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FleetAssetHeader) == 16, "packed layout");
+static_assert(sizeof(FleetAssetEntry) == 56, "packed layout");
+
+// zlib-compatible CRC-32; pass the previous result to continue
+uint32_t fleet_crc32(const void *data, size_t len, uint32_t crc = 0);
+
+class FleetAssetPack
+{
+public:
+    // Use an image already in memory; checks the header and directory
+    bool mount(const void *base, size_t size);
+#if defined(ARDUINO_ARCH_ESP32)
+    // Map the partition with this label and mount it
+    bool mountPartition(const char *label = "assets");
+#else
+    // mmap a packed file read-only and mount it
+    bool mountFile(const char *path);
+#endif
+    void unmount();
+
+    bool mounted() const { return header != nullptr; }
+    size_t size() const { return header ? header->total_size : 0; }
+    const uint8_t *image() const { return base; } // the header's address
+
+    int count() const { return header ? header->count : 0; }
+    const FleetAssetEntry *entry(int i) const { return &dir[i]; }
+
+    // Exact name ("img/sun.bin", no leading '/'); nullptr if absent
+    const FleetAssetEntry *find(const char *name) const;
+
+    // The file's bytes, straight from the mapping
+    const uint8_t *data(const FleetAssetEntry *e) const { return base + e->offset; }
+
+    // CRC checks: the whole image (reads every byte once) or one file
+    bool verify() const;
+    bool verify(const FleetAssetEntry *e) const;
+
+private:
+    const uint8_t *base = nullptr;
+    const FleetAssetHeader *header = nullptr;
+    const FleetAssetEntry *dir = nullptr;
+    // What unmount() has to undo: an esp_partition_mmap handle or a host
+    // mmap length; 0 for mount() of caller memory
+    uint32_t map_handle = 0;
+    size_t map_len = 0;
+};
+
+// The pack LVGL's asset file system reads (see fleet_asset_fs.h)
+extern FleetAssetPack fleet_assets;
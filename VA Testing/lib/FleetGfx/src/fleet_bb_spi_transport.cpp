@@ -0,0 +1,77 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_bb_spi_transport (see fleet_bb_spi_transport.h)
+ */
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include "fleet_bb_spi_transport.h"
+#include "fleet_trace.h"
+
+bool FleetBbSpiTransport::begin(BB_SPI_LCD *lcd_ptr, BaseType_t core, UBaseType_t priority, UBaseType_t queue_len)
+{
+    lcd = lcd_ptr;
+    queue = xQueueCreate(queue_len, sizeof(Cmd));
+    done_sem = xSemaphoreCreateBinary();
+    if (queue == nullptr || done_sem == nullptr)
+    {
+        return false;
+    }
+    return xTaskCreatePinnedToCore(worker, "fleet_dma", 4096, this, priority, &task, core) == pdPASS;
+}
+
+void FleetBbSpiTransport::setWindow(int x, int y, int w, int h)
+{
+    Cmd cmd = {CMD_WINDOW, 0, (int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h, nullptr, 0};
+    xQueueSend(queue, &cmd, portMAX_DELAY);
+}
+
+void FleetBbSpiTransport::push(const uint16_t *pixels, size_t count, uint8_t tag)
+{
+    Cmd cmd = {CMD_PUSH, tag, 0, 0, 0, 0, pixels, (uint32_t)count};
+    in_flight++;
+    xQueueSend(queue, &cmd, portMAX_DELAY);
+}
+
+void FleetBbSpiTransport::waitForDone()
+{
+    if (in_flight.load() == 0)
+    {
+        return;
+    }
+    xSemaphoreTake(done_sem, portMAX_DELAY);
+}
+
+void FleetBbSpiTransport::worker(void *arg)
+{
+    FleetBbSpiTransport *self = (FleetBbSpiTransport *)arg;
+    Cmd cmd;
+
+    for (;;)
+    {
+        if (xQueueReceive(self->queue, &cmd, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        if (cmd.type == CMD_WINDOW)
+        {
+            FLEET_TRACE_BEGIN("set_window");
+            self->lcd->setAddrWindow(cmd.x, cmd.y, cmd.w, cmd.h);
+            FLEET_TRACE_END("set_window");
+            continue;
+        }
+
+        FLEET_TRACE_BEGIN("dma_push");
+        self->lcd->pushPixels((uint16_t *)cmd.pixels, cmd.count, DRAW_TO_LCD | DRAW_WITH_DMA);
+        self->lcd->waitDMA();
+        FLEET_TRACE_END("dma_push");
+
+        // This is the "DMA done" event
+        self->in_flight--;
+        self->signalDone(cmd.tag);
+        xSemaphoreGive(self->done_sem);
+    }
+}
+
+#endif // ARDUINO_ARCH_ESP32
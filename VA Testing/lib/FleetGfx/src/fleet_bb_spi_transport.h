@@ -0,0 +1,70 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_bb_spi_transport
+ * Goal:    FleetTransport on top of bb_spi_lcd.
+ *
+ * bb_spi_lcd has no DMA-complete callback, so a small worker task owns the
+ * LCD: it takes window/push commands off a queue, runs
+ * pushPixels(DRAW_WITH_DMA) + waitDMA(), and then raises the done event.
+ * The caller (LVGL) keeps rendering/converting while the worker waits.
+ *
+ * pushPixels(DRAW_WITH_DMA) queues the pointer to IDF's spi_master as it
+ * is. spi_master DMAs only from memory esp_ptr_dma_capable() accepts and
+ * bounces anything else, PSRAM included, through a malloc + memcpy per
+ * transaction. So only push internal RAM: FleetDisplay checks
+ * fleet_dma_readable() and copies PSRAM areas into the DMA strips.
+ *
+ * All LCD access must go through the transport once begin() has run.
+ */
+
+#pragma once
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <atomic>
+
+#include <bb_spi_lcd.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "fleet_transport.h"
+
+class FleetBbSpiTransport : public FleetTransport
+{
+public:
+    // Starts the DMA worker. Core 0 keeps it off LVGL's core (Arduino's
+    // loop() runs on core 1).
+    bool begin(BB_SPI_LCD *lcd, BaseType_t core = 0, UBaseType_t priority = 5, UBaseType_t queue_len = 8);
+
+    void setWindow(int x, int y, int w, int h) override;
+    void push(const uint16_t *pixels, size_t count, uint8_t tag) override;
+    void waitForDone() override;
+
+private:
+    enum
+    {
+        CMD_WINDOW,
+        CMD_PUSH,
+    };
+
+    struct Cmd
+    {
+        uint8_t type;
+        uint8_t tag;
+        int16_t x, y, w, h;
+        const uint16_t *pixels;
+        uint32_t count;
+    };
+
+    static void worker(void *arg);
+
+    BB_SPI_LCD *lcd = nullptr;
+    QueueHandle_t queue = nullptr;
+    SemaphoreHandle_t done_sem = nullptr;
+    TaskHandle_t task = nullptr;
+    std::atomic<int> in_flight{0};
+};
+
+#endif // ARDUINO_ARCH_ESP32
@@ -0,0 +1,80 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_buf_size
+ * Goal:    One place that sizes LVGL draw buffers, in units that can't be
+ * mixed up.
+ *
+ * ex01_hello_lvgl once defined its draw buffer in *pixels* and passed that
+ * number to heap_caps_malloc() and lv_draw_buf_init() as *bytes*. The
+ * buffer came out half size and LVGL rendered twice as many strips per
+ * refresh, with nothing complaining. Pixel and byte counts are distinct
+ * types here, so that mistake no longer compiles.
+ *
+ * Everything is constexpr (C++11 style), so a fixed panel size can be
+ * checked with static_assert at build time.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct FleetPixels
+{
+    uint32_t value;
+};
+
+struct FleetBytes
+{
+    uint32_t value;
+};
+
+// RGB565, the only format our panels take
+#define FLEET_BYTES_PER_PIXEL 2u
+
+constexpr FleetBytes fleet_bytes(FleetPixels px, uint32_t bytes_per_px = FLEET_BYTES_PER_PIXEL)
+{
+    return FleetBytes{px.value * bytes_per_px};
+}
+
+constexpr FleetPixels fleet_pixels(FleetBytes bytes, uint32_t bytes_per_px = FLEET_BYTES_PER_PIXEL)
+{
+    return FleetPixels{bytes.value / bytes_per_px};
+}
+
+struct FleetDrawBufSize
+{
+    uint32_t width; // pixels per row
+    uint32_t rows;  // whole rows, never 0
+    FleetPixels pixels;
+    FleetBytes bytes; // what heap_caps_malloc() and lv_draw_buf_init() want
+};
+
+constexpr uint32_t fleet_draw_buf_rows(uint32_t width, uint32_t height, uint32_t divisor)
+{
+    return (width * height / divisor) / width > 0 ? (width * height / divisor) / width : 1;
+}
+
+constexpr FleetDrawBufSize fleet_draw_buf_size_rows(uint32_t width, uint32_t rows,
+                                                    uint32_t bytes_per_px = FLEET_BYTES_PER_PIXEL)
+{
+    return FleetDrawBufSize{width, rows, FleetPixels{width * rows},
+                            fleet_bytes(FleetPixels{width * rows}, bytes_per_px)};
+}
+
+// A draw buffer covering 1/divisor of a width x height screen, rounded down
+// to whole rows (at least one row).
+constexpr FleetDrawBufSize fleet_draw_buf_size(uint32_t width, uint32_t height, uint32_t divisor = 10,
+                                               uint32_t bytes_per_px = FLEET_BYTES_PER_PIXEL)
+{
+    return fleet_draw_buf_size_rows(width, fleet_draw_buf_rows(width, height, divisor), bytes_per_px);
+}
+
+// The Guition 3.5" panel, both orientations: 1/10th of 320x480 is 48
+// portrait rows (30 KB) or 32 landscape rows, never the 15 KB the
+// pixels-as-bytes bug produced.
+static_assert(fleet_draw_buf_size(320, 480).rows == 48, "portrait draw buffer should be 48 rows");
+static_assert(fleet_draw_buf_size(320, 480).bytes.value == 320 * 48 * 2, "draw buffer size must be in bytes");
+static_assert(fleet_draw_buf_size(480, 320).rows == 32, "landscape draw buffer should be 32 rows");
+static_assert(fleet_draw_buf_size(480, 320).bytes.value == 480 * 32 * 2, "draw buffer size must be in bytes");
+static_assert(fleet_draw_buf_size(320, 5).rows == 1, "draw buffer must hold at least one row");
+static_assert(fleet_pixels(fleet_bytes(FleetPixels{15360})).value == 15360, "pixel/byte round trip");
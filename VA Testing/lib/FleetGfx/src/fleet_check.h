@@ -0,0 +1,61 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_check
+ * Goal:    The pass/fail bookkeeping every host check program under
+ * src/native/ shares, so each one reports and exits the same way:
+ *
+ *     check(w == 320, "wrong width");
+ *     checkf(n == want, "%s: %d pushes, want %d", name, n, want);
+ *     ...
+ *     return fleet_check_exit();
+ *
+ * Header-only and host-only: nothing in the firmware includes it.
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+
+// Failed checks so far, across the whole program
+inline int fleet_check_failures = 0;
+
+// Unless `ok`: print "  FAIL: <what>" and count it. Returns `ok`.
+inline bool check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("  FAIL: %s\n", what);
+        fleet_check_failures++;
+    }
+    return ok;
+}
+
+// check() with a printf-style message, for checks that name their case
+__attribute__((format(printf, 2, 3))) inline bool checkf(bool ok, const char *fmt, ...)
+{
+    if (!ok)
+    {
+        va_list args;
+        va_start(args, fmt);
+        printf("  FAIL: ");
+        vprintf(fmt, args);
+        printf("\n");
+        va_end(args);
+        fleet_check_failures++;
+    }
+    return ok;
+}
+
+// Print the summary line; the result is main()'s exit status (1 if any
+// check failed)
+inline int fleet_check_exit()
+{
+    if (fleet_check_failures)
+    {
+        printf("%d check(s) FAILED\n", fleet_check_failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_coalesce (see fleet_coalesce.h)
+ */
+
+#include "fleet_coalesce.h"
+
+static uint64_t pixels(const FleetRect &r)
+{
+    return (uint64_t)(r.x2 - r.x1 + 1) * (uint64_t)(r.y2 - r.y1 + 1);
+}
+
+static FleetRect bounds(const FleetRect &a, const FleetRect &b)
+{
+    return {a.x1 < b.x1 ? a.x1 : b.x1, a.y1 < b.y1 ? a.y1 : b.y1, a.x2 > b.x2 ? a.x2 : b.x2,
+            a.y2 > b.y2 ? a.y2 : b.y2};
+}
+
+uint64_t FleetCoalescer::cost(const FleetRect &r) const
+{
+    return overhead + pixels(r) * bpp;
+}
+
+uint64_t FleetCoalescer::cost(const FleetRect *rects, int n) const
+{
+    uint64_t total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        total += cost(rects[i]);
+    }
+    return total;
+}
+
+int FleetCoalescer::run(FleetRect *rects, int n)
+{
+    stats_.runs++;
+    stats_.areas_in += n;
+    stats_.cost_in += cost(rects, n);
+    for (int i = 0; i < n; i++)
+    {
+        stats_.px_in += pixels(rects[i]);
+    }
+
+    // Greedy: merge the best pair, repeat. n is at most LVGL's
+    // LV_INV_BUF_SIZE (32), so O(n^3) is a few thousand cheap evaluations.
+    for (;;)
+    {
+        int best_i = -1, best_j = -1;
+        int64_t best_saving = 0;
+        for (int i = 0; i < n; i++)
+        {
+            const uint64_t ci = cost(rects[i]);
+            for (int j = i + 1; j < n; j++)
+            {
+                const int64_t saving = (int64_t)(ci + cost(rects[j])) - (int64_t)cost(bounds(rects[i], rects[j]));
+                if (saving > best_saving)
+                {
+                    best_saving = saving;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+        if (best_i < 0)
+        {
+            break;
+        }
+        rects[best_i] = bounds(rects[best_i], rects[best_j]);
+        rects[best_j] = rects[--n];
+    }
+
+    stats_.areas_out += n;
+    stats_.cost_out += cost(rects, n);
+    for (int i = 0; i < n; i++)
+    {
+        stats_.px_out += pixels(rects[i]);
+    }
+    return n;
+}
@@ -0,0 +1,72 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_coalesce
+ * Goal:    Merge a frame's invalidated areas when one bigger transfer is
+ * cheaper on the bus than several small ones.
+ *
+ * Every area that reaches the flush costs a setAddrWindow and a DMA setup
+ * on top of its pixels. We model that as a fixed number of
+ * "overhead bytes" per transaction:
+ *
+ *     cost(area) = txn_overhead_bytes + w * h * bytes_per_px
+ *
+ * and greedily merge the pair whose bounding box saves the most, until no
+ * merge saves anything. LVGL's own join only merges when the union is
+ * smaller than the parts, so with per-transaction overhead it leaves many
+ * small areas (spinners, icons, blinking cursors) apart.
+ *
+ * Rects use lv_area_t's convention (inclusive corners), but nothing here
+ * depends on LVGL, so the host can check it (src/native/bench_coalesce).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// What one extra transaction costs, in bus bytes. On the Guition QSPI
+// panel at 40 MHz a window + DMA setup is ~30-50 us, i.e. ~1 KB of pixels.
+#ifndef FLEET_TXN_OVERHEAD_BYTES
+#define FLEET_TXN_OVERHEAD_BYTES 1024
+#endif
+
+struct FleetRect
+{
+    int32_t x1, y1, x2, y2; // inclusive
+};
+
+struct FleetCoalesceStats
+{
+    uint32_t runs;      // run() calls
+    uint32_t areas_in;  // areas seen
+    uint32_t areas_out; // areas left after merging
+    uint64_t cost_in;   // modelled bus bytes before
+    uint64_t cost_out;  // ... and after
+    uint64_t px_in;     // pixels before (overlaps counted twice)
+    uint64_t px_out;    // pixels after
+};
+
+class FleetCoalescer
+{
+public:
+    explicit FleetCoalescer(uint32_t txn_overhead_bytes = FLEET_TXN_OVERHEAD_BYTES, uint32_t bytes_per_px = 2)
+        : overhead(txn_overhead_bytes), bpp(bytes_per_px)
+    {
+    }
+
+    void setOverhead(uint32_t txn_overhead_bytes) { overhead = txn_overhead_bytes; }
+
+    uint64_t cost(const FleetRect &r) const;
+    uint64_t cost(const FleetRect *rects, int n) const;
+
+    // Merge `rects` in place; returns the new count. Every input pixel is
+    // covered by some output rect, and the total cost never goes up.
+    int run(FleetRect *rects, int n);
+
+    const FleetCoalesceStats &stats() const { return stats_; }
+    void resetStats() { stats_ = FleetCoalesceStats(); }
+
+private:
+    uint32_t overhead;
+    uint32_t bpp;
+    FleetCoalesceStats stats_ = FleetCoalesceStats();
+};
@@ -0,0 +1,69 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_dirty_rows (see fleet_dirty_rows.h)
+ */
+
+#include "fleet_dirty_rows.h"
+
+void FleetDirtyRows::mergeAt(int i)
+{
+    if (bands[i + 1].y1 > bands[i].y1)
+    {
+        bands[i].y1 = bands[i + 1].y1;
+    }
+    for (int k = i + 1; k < n - 1; k++)
+    {
+        bands[k] = bands[k + 1];
+    }
+    n--;
+}
+
+void FleetDirtyRows::add(int y0, int y1)
+{
+    // Insert sorted by y0 (there are at most MAX_BANDS + 1 entries)
+    int i = n;
+    while (i > 0 && bands[i - 1].y0 > y0)
+    {
+        bands[i] = bands[i - 1];
+        i--;
+    }
+    bands[i] = {(int16_t)y0, (int16_t)y1};
+    n++;
+
+    // Join everything that now overlaps or sits within `gap` rows
+    for (int k = 0; k + 1 < n;)
+    {
+        if (bands[k + 1].y0 <= bands[k].y1 + 1 + gap)
+        {
+            mergeAt(k);
+        }
+        else
+        {
+            k++;
+        }
+    }
+
+    // Still too many: join the closest pair
+    if (n > MAX_BANDS)
+    {
+        int best = 0;
+        for (int k = 1; k + 1 < n; k++)
+        {
+            if (bands[k + 1].y0 - bands[k].y1 < bands[best + 1].y0 - bands[best].y1)
+            {
+                best = k;
+            }
+        }
+        mergeAt(best);
+    }
+}
+
+uint32_t FleetDirtyRows::rows() const
+{
+    uint32_t total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        total += bands[i].y1 - bands[i].y0 + 1;
+    }
+    return total;
+}
@@ -0,0 +1,50 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_dirty_rows
+ * Goal:    Collect a frame's changed areas as bands of whole rows, for
+ * DIRECT render mode.
+ *
+ * In a full-frame buffer, a run of full-width rows is one contiguous block
+ * of memory and one address window, so it can go to the LCD in a single
+ * zero-copy stream. Each band costs one setAddrWindow. Bands closer than
+ * `merge_gap` rows are joined, because re-sending a few clean rows is
+ * cheaper than another window + DMA setup. If more than MAX_BANDS remain,
+ * the closest pair is joined.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct FleetRowBand
+{
+    int16_t y0; // first row
+    int16_t y1; // last row (inclusive)
+};
+
+class FleetDirtyRows
+{
+public:
+    static const int MAX_BANDS = 8;
+
+    explicit FleetDirtyRows(int merge_gap = 8) : gap(merge_gap) {}
+
+    void setMergeGap(int rows) { gap = rows; }
+    void clear() { n = 0; }
+
+    // Mark rows y0..y1 (inclusive) dirty
+    void add(int y0, int y1);
+
+    int count() const { return n; }
+    const FleetRowBand &band(int i) const { return bands[i]; }
+
+    // Total rows over all bands
+    uint32_t rows() const;
+
+private:
+    void mergeAt(int i); // join bands[i] and bands[i + 1]
+
+    FleetRowBand bands[MAX_BANDS + 1];
+    int n = 0;
+    int gap;
+};
@@ -0,0 +1,47 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_dma_strips (see fleet_dma_strips.h)
+ */
+
+#include "fleet_dma_strips.h"
+#include "fleet_port.h"
+
+bool fleet_dma_strips_alloc(FleetDmaStrips *strips, int width, size_t budget_bytes)
+{
+    const size_t row_bytes = sizeof(uint16_t) * width;
+    int rows = (int)(budget_bytes / 2 / row_bytes);
+    if (rows < 1)
+    {
+        rows = 1;
+    }
+
+    for (; rows >= 1; rows /= 2)
+    {
+        const size_t bytes = row_bytes * rows;
+        strips->buf[0] = (uint16_t *)fleet_malloc(bytes, FLEET_MEM_DMA);
+        strips->buf[1] = (uint16_t *)fleet_malloc(bytes, FLEET_MEM_DMA);
+        if (strips->buf[0] != nullptr && strips->buf[1] != nullptr)
+        {
+            strips->px = (size_t)width * rows;
+            strips->rows = rows;
+            return true;
+        }
+        fleet_dma_strips_free(strips);
+    }
+
+    strips->px = 0;
+    strips->rows = 0;
+    return false;
+}
+
+void fleet_dma_strips_free(FleetDmaStrips *strips)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (strips->buf[i] != nullptr)
+        {
+            fleet_free(strips->buf[i]);
+            strips->buf[i] = nullptr;
+        }
+    }
+}
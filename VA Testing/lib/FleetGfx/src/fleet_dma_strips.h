@@ -0,0 +1,32 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_dma_strips
+ * Goal:    Allocate the pipeline's two DMA buffers as multi-row strips.
+ *
+ * One pushPixels per strip instead of per row cuts the per-transaction
+ * setup cost. The strips must live in internal, DMA-capable RAM, which is
+ * scarce, so the size comes from a byte budget for *both* buffers and is
+ * halved until the allocation succeeds. One row is the floor; if even that
+ * fails the caller falls back to its static buffers.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Internal RAM budget for both strip buffers together, in bytes
+#ifndef FLEET_DMA_BUDGET_BYTES
+#define FLEET_DMA_BUDGET_BYTES (32 * 1024)
+#endif
+
+struct FleetDmaStrips
+{
+    uint16_t *buf[2]; // nullptr if allocation failed
+    size_t px;        // pixels per buffer
+    int rows;         // rows of `width` pixels per buffer
+};
+
+// Returns false (and leaves buf[] null) if not even one row fits
+bool fleet_dma_strips_alloc(FleetDmaStrips *strips, int width, size_t budget_bytes = FLEET_DMA_BUDGET_BYTES);
+void fleet_dma_strips_free(FleetDmaStrips *strips);
@@ -0,0 +1,85 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_fb_transport (see fleet_fb_transport.h)
+ */
+
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+
+#include <string.h>
+
+bool FleetFramebufferTransport::begin(int width, int height)
+{
+    end();
+    fb = (uint16_t *)fleet_malloc(sizeof(uint16_t) * width * height, FLEET_MEM_PSRAM);
+    if (fb == nullptr)
+    {
+        return false;
+    }
+    memset(fb, 0, sizeof(uint16_t) * width * height);
+    fb_w = width;
+    fb_h = height;
+    windows = pushes = 0;
+    bytes = 0;
+    setWindow(0, 0, width, height);
+    return true;
+}
+
+void FleetFramebufferTransport::end()
+{
+    if (fb != nullptr)
+    {
+        fleet_free(fb);
+        fb = nullptr;
+    }
+}
+
+void FleetFramebufferTransport::setWindow(int x, int y, int w, int h)
+{
+    win_x = x;
+    win_y = y;
+    win_w = w;
+    win_h = h;
+    cur_x = cur_y = 0;
+    windows++;
+}
+
+void FleetFramebufferTransport::push(const uint16_t *px, size_t count, uint8_t tag)
+{
+    pushes++;
+    bytes += count * sizeof(uint16_t);
+
+    while (count > 0 && win_w > 0 && win_h > 0)
+    {
+        // Copy up to the end of the current window row
+        size_t n = (size_t)(win_w - cur_x);
+        if (n > count)
+        {
+            n = count;
+        }
+
+        const int y = win_y + cur_y;
+        const int x = win_x + cur_x;
+        if (y >= 0 && y < fb_h && x >= 0 && x + (int)n <= fb_w)
+        {
+            memcpy(&fb[y * fb_w + x], px, n * sizeof(uint16_t));
+        }
+
+        px += n;
+        count -= n;
+        cur_x += n;
+        if (cur_x == win_w)
+        {
+            cur_x = 0;
+            cur_y = (cur_y + 1) % win_h; // the controller wraps too
+        }
+    }
+
+    signalDone(tag);
+}
+
+uint16_t FleetFramebufferTransport::pixel(int x, int y) const
+{
+    const uint16_t v = fb[y * fb_w + x];
+    return (uint16_t)((v >> 8) | (v << 8));
+}
@@ -0,0 +1,50 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_fb_transport
+ * Goal:    A FleetTransport that "sends" pixels into an in-memory panel.
+ *
+ * It behaves like the LCD's GRAM: setWindow() sets the address window and
+ * pushes fill it left-to-right, top-to-bottom, wrapping inside the window.
+ * The framebuffer keeps the panel's wire format (big-endian RGB565), so
+ * what you read back is exactly what the glass would have received.
+ * Transfers complete synchronously inside push().
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fleet_transport.h"
+
+class FleetFramebufferTransport : public FleetTransport
+{
+public:
+    // Allocates a width x height framebuffer, cleared to black
+    bool begin(int width, int height);
+    void end();
+
+    void setWindow(int x, int y, int w, int h) override;
+    void push(const uint16_t *pixels, size_t count, uint8_t tag) override;
+    void waitForDone() override {}
+
+    int width() const { return fb_w; }
+    int height() const { return fb_h; }
+
+    // Raw wire-format pixels, row-major, width() * height()
+    const uint16_t *pixels() const { return fb; }
+
+    // Native-endian RGB565 of one pixel
+    uint16_t pixel(int x, int y) const;
+
+    // Counters since begin()
+    uint32_t windows = 0;
+    uint32_t pushes = 0;
+    uint64_t bytes = 0;
+
+private:
+    uint16_t *fb = nullptr;
+    int fb_w = 0, fb_h = 0;
+    int win_x = 0, win_y = 0, win_w = 0, win_h = 0;
+    int cur_x = 0, cur_y = 0; // write cursor, relative to the window
+};
@@ -0,0 +1,186 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_flush_pipeline (see fleet_flush_pipeline.h)
+ */
+
+#include "fleet_flush_pipeline.h"
+#include "fleet_swap.h"
+#include "fleet_trace.h"
+
+#include <string.h>
+
+bool FleetFlushPipeline::begin(FleetTransport *t, uint16_t *buf_a, uint16_t *buf_b, size_t px)
+{
+    // takeBuf() hands out bufs[0] first, and an empty buffer would never
+    // move a pixel
+    if (t == nullptr || (buf_b != nullptr && buf_a == nullptr) || (buf_a != nullptr && px == 0))
+    {
+        return false;
+    }
+    transport = t;
+    bufs[0] = buf_a;
+    bufs[1] = buf_b;
+    buf_px = px;
+    next_buf = 0;
+    free_bufs = (buf_a != nullptr) + (buf_b != nullptr);
+    state_ = IDLE;
+    transport->setDoneCallback(onDone, this);
+    return true;
+}
+
+void FleetFlushPipeline::start(int x, int y, int w, int h, ready_cb_t ready, void *ctx)
+{
+    // LVGL never flushes again before flush_ready, but be defensive
+    waitIdle();
+
+    ready_cb = ready;
+    ready_ctx = ctx;
+    state_ = FLUSHING;
+
+    transport->setWindow(x, y, w, h);
+    stats_.areas++;
+    stats_.bytes += (uint64_t)w * h * sizeof(uint16_t);
+}
+
+uint16_t *FleetFlushPipeline::takeBuf()
+{
+    // Nothing would ever give a buffer back: don't wait for it
+    if (bufs[0] == nullptr)
+    {
+        return nullptr;
+    }
+    FLEET_TRACE_BEGIN("wait_buf");
+    while (free_bufs.load() == 0)
+    {
+        transport->waitForDone();
+    }
+    FLEET_TRACE_END("wait_buf");
+    free_bufs--;
+
+    uint16_t *dst = bufs[next_buf];
+    if (bufs[1] != nullptr)
+    {
+        next_buf ^= 1;
+    }
+    return dst;
+}
+
+bool FleetFlushPipeline::flush(int x, int y, int w, int h, const uint16_t *px, bool swap, ready_cb_t ready, void *ctx)
+{
+    if (swap)
+    {
+        return flushCopy(x, y, w, h, px, true, ready, ctx);
+    }
+    start(x, y, w, h, ready, ctx);
+    const size_t total = (size_t)w * h;
+
+    // Zero copy: the caller's buffer goes straight to the DMA
+    const size_t step = max_push_px ? max_push_px : total;
+    for (size_t done = 0; done < total;)
+    {
+        const size_t n = (total - done < step) ? total - done : step;
+        const uint16_t *src = px + done;
+        done += n;
+        stats_.transactions++;
+        transport->push(src, n, done == total ? FLEET_TAG_LAST : 0);
+    }
+    return true;
+}
+
+bool FleetFlushPipeline::flushCopy(int x, int y, int w, int h, const uint16_t *px, bool swap, ready_cb_t ready,
+                                   void *ctx)
+{
+    if (bufs[0] == nullptr)
+    {
+        return false;
+    }
+    start(x, y, w, h, ready, ctx);
+    const size_t total = (size_t)w * h;
+
+    // The window is one linear pixel stream, so chunks don't have to be
+    // whole rows, but whole rows keep every strip the same shape. Only a
+    // buffer narrower than the area gets split mid-row.
+    size_t chunk = buf_px;
+    if (chunk >= (size_t)w)
+    {
+        chunk -= chunk % w;
+    }
+
+    for (size_t done = 0; done < total;)
+    {
+        const size_t n = (total - done < chunk) ? total - done : chunk;
+
+        uint16_t *dst = takeBuf();
+        if (swap)
+        {
+            FLEET_TRACE_BEGIN("swap");
+            fleet_swap_rgb565(dst, px + done, n);
+            FLEET_TRACE_END("swap");
+        }
+        else
+        {
+            FLEET_TRACE_BEGIN("copy");
+            memcpy(dst, px + done, n * sizeof(uint16_t));
+            FLEET_TRACE_END("copy");
+        }
+        done += n;
+        stats_.transactions++;
+        transport->push(dst, n, FLEET_TAG_BUFFER | (done == total ? FLEET_TAG_LAST : 0));
+    }
+    return true;
+}
+
+bool FleetFlushPipeline::flushRotated(int x, int y, int w, int h, const uint16_t *px, FleetRotation rot, bool swap,
+                                      ready_cb_t ready, void *ctx)
+{
+    // Whole window rows per strip. The source is w rows of h pixels, and
+    // its rows become the window's columns. Less than one row per strip
+    // would never get anywhere.
+    const int strip_rows = w > 0 ? (int)(buf_px / w) : 0;
+    if (bufs[0] == nullptr || strip_rows == 0)
+    {
+        return false;
+    }
+    start(x, y, w, h, ready, ctx);
+
+    for (int r = 0; r < h;)
+    {
+        const int n = h - r < strip_rows ? h - r : strip_rows;
+        uint16_t *dst = takeBuf();
+        FLEET_TRACE_BEGIN("rotate");
+        fleet_rotate_rgb565(dst, px, h, w, h, rot, r, n, swap);
+        FLEET_TRACE_END("rotate");
+        r += n;
+        stats_.transactions++;
+        transport->push(dst, (size_t)n * w, FLEET_TAG_BUFFER | (r == h ? FLEET_TAG_LAST : 0));
+    }
+    return true;
+}
+
+void FleetFlushPipeline::waitIdle()
+{
+    while (state_.load() != IDLE)
+    {
+        transport->waitForDone();
+    }
+}
+
+void FleetFlushPipeline::onDone(void *ctx, uint8_t tag)
+{
+    FleetFlushPipeline *self = (FleetFlushPipeline *)ctx;
+
+    if (tag & FLEET_TAG_BUFFER)
+    {
+        self->free_bufs++;
+    }
+    if (tag & FLEET_TAG_LAST)
+    {
+        // Notify first, then go IDLE: flush() and waitIdle() both wait for
+        // IDLE, so the next area can't overwrite ready_cb while we use it.
+        if (self->ready_cb)
+        {
+            self->ready_cb(self->ready_ctx);
+        }
+        self->state_ = IDLE;
+    }
+}
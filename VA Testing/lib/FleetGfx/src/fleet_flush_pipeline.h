@@ -0,0 +1,108 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_flush_pipeline
+ * Goal:    Overlap pixel conversion with the DMA transfer, and only hand the
+ * buffer back to LVGL once the DMA is really done.
+ *
+ * Two DMA buffers are used ping-pong: while buffer A is on the wire the CPU
+ * swaps the next chunk into buffer B. flush() returns as soon as the last
+ * chunk is queued; the ready callback (lv_display_flush_ready in practice)
+ * fires from the transport's done event for the area's final push.
+ *
+ * With `swap == false` the pixels are already in wire format and are pushed
+ * straight from the caller's buffer (zero copy, no DMA buffer used).
+ *
+ * Pixels are sent in chunks of up to one DMA buffer, rounded down to whole
+ * rows, so a buffer of N display rows turns an area into ceil(h / N) pushes
+ * instead of h (see fleet_dma_strips.h for sizing).
+ *
+ * The pipeline knows nothing about LVGL or Arduino, so the whole state
+ * machine runs on the host against FleetMockTransport
+ * (src/native/bench_flush_pipeline).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fleet_rotate.h"
+#include "fleet_transport.h"
+
+// Counters for tuning the strip size on real hardware
+struct FleetFlushStats
+{
+    uint32_t frames;       // endFrame() calls
+    uint32_t areas;        // flush() calls
+    uint32_t transactions; // pushes handed to the transport
+    uint64_t bytes;        // pixel bytes pushed
+};
+
+class FleetFlushPipeline
+{
+public:
+    typedef void (*ready_cb_t)(void *ctx);
+
+    enum State
+    {
+        IDLE,     // nothing queued, caller's buffer is free
+        FLUSHING, // area queued, waiting for its last push to complete
+    };
+
+    // buf_a/buf_b: DMA-capable buffers of buf_px pixels each. They may be
+    // nullptr if only zero-copy flushes are used; buf_b alone may be
+    // nullptr (one buffer, no overlap). False for buf_b without buf_a, or
+    // buffers of no pixels.
+    bool begin(FleetTransport *transport, uint16_t *buf_a, uint16_t *buf_b, size_t buf_px);
+
+    // Queue the w x h area at (x, y). `px` holds w*h row-contiguous pixels.
+    // `ready(ctx)` is called from the done event once `px` may be reused.
+    // Returns false, with nothing queued and `ready` not called, if the
+    // area needs the DMA buffers (`swap`) and there are none.
+    bool flush(int x, int y, int w, int h, const uint16_t *px, bool swap, ready_cb_t ready, void *ctx);
+
+    // Like flush(), but always copy (and swap if `swap`) through the DMA
+    // buffers: for pixels the DMA can't read, e.g. memory-mapped flash.
+    // False without DMA buffers.
+    bool flushCopy(int x, int y, int w, int h, const uint16_t *px, bool swap, ready_cb_t ready, void *ctx);
+
+    // Queue a rotated area. (x, y, w, h) is the window on the panel; `px`
+    // is the area as LVGL rendered it, before rotation: w rows of h
+    // pixels. Each strip is rotated (and swapped if `swap`) straight into a
+    // DMA buffer. False if a buffer can't hold one w-pixel row.
+    bool flushRotated(int x, int y, int w, int h, const uint16_t *px, FleetRotation rot, bool swap, ready_cb_t ready,
+                      void *ctx);
+
+    // Split zero-copy flushes into pushes of at most `px` pixels (0: no
+    // limit). Full-frame bands in DIRECT mode can be far larger than one
+    // DMA transaction should be.
+    void setMaxPush(size_t px) { max_push_px = px; }
+    size_t maxPush() const { return max_push_px; }
+
+    // Block until the current area has fully completed
+    void waitIdle();
+
+    State state() const { return state_.load(); }
+
+    // Mark the end of a refresh (call on lv_display_flush_is_last)
+    void endFrame() { stats_.frames++; }
+    const FleetFlushStats &stats() const { return stats_; }
+    void resetStats() { stats_ = FleetFlushStats(); }
+
+private:
+    static void onDone(void *ctx, uint8_t tag);
+    void start(int x, int y, int w, int h, ready_cb_t ready, void *ctx);
+    uint16_t *takeBuf(); // wait for a free DMA buffer (nullptr if none exist)
+
+    FleetTransport *transport = nullptr;
+    uint16_t *bufs[2] = {nullptr, nullptr};
+    size_t buf_px = 0;
+    size_t max_push_px = 0;
+    int next_buf = 0;
+    std::atomic<int> free_bufs{0};
+    std::atomic<State> state_{IDLE};
+    ready_cb_t ready_cb = nullptr;
+    void *ready_ctx = nullptr;
+    FleetFlushStats stats_ = FleetFlushStats();
+};
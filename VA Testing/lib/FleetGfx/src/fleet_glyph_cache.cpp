@@ -0,0 +1,233 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_glyph_cache (see fleet_glyph_cache.h)
+ */
+
+#include "fleet_glyph_cache.h"
+#include "fleet_port.h"
+
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#define CACHE_LOCK() portENTER_CRITICAL(&mux)
+#define CACHE_UNLOCK() portEXIT_CRITICAL(&mux)
+#else
+#define CACHE_LOCK() mutex.lock()
+#define CACHE_UNLOCK() mutex.unlock()
+#endif
+
+// One allocation per glyph: header, then w * h alpha bytes (stride w)
+struct FleetGlyphCache::Entry
+{
+    Entry *chain;       // next in the hash bucket
+    Entry *prev, *next; // LRU list, prev towards mru
+    FleetGlyphKey key;
+    uint16_t pins;      // get()s copying out of it right now
+    bool retired;       // evicted while pinned: the last unpin frees it
+    uint8_t *bitmap() { return (uint8_t *)(this + 1); }
+    size_t bytes() const { return (size_t)key.w * key.h; }
+};
+
+static uint32_t hash_of(const FleetGlyphKey &key)
+{
+    uint32_t h = (uint32_t)(uintptr_t)key.font * 2654435761u;
+    h ^= key.glyph * 2246822519u;
+    h ^= ((uint32_t)key.w << 16 | key.h) * 3266489917u;
+    return (h ^ (h >> 15)) % FleetGlyphCache::BUCKETS;
+}
+
+static bool same_key(const FleetGlyphKey &a, const FleetGlyphKey &b)
+{
+    return a.font == b.font && a.glyph == b.glyph && a.w == b.w && a.h == b.h;
+}
+
+static void copy_rows(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t w,
+                      uint16_t h)
+{
+    for (uint16_t y = 0; y < h; y++)
+    {
+        memcpy(dst + (size_t)y * dst_stride, src + (size_t)y * src_stride, w);
+    }
+}
+
+bool FleetGlyphCache::begin(size_t budget_bytes)
+{
+    end();
+    budget = budget_bytes;
+    st = FleetGlyphCacheStats();
+    st.budget = budget;
+    return true;
+}
+
+// Called with the lock held, once e is off the LRU list and its bucket. A
+// pinned entry is still being read by get(), which frees it when done;
+// anything else joins *freed, to be freed after unlocking.
+void FleetGlyphCache::retire(Entry *e, Entry **freed)
+{
+    if (e->pins > 0)
+    {
+        e->retired = true;
+        return;
+    }
+    e->next = *freed;
+    *freed = e;
+}
+
+void FleetGlyphCache::freeChain(Entry *e)
+{
+    while (e != nullptr)
+    {
+        Entry *next = e->next;
+        fleet_free(e);
+        e = next;
+    }
+}
+
+void FleetGlyphCache::end()
+{
+    Entry *freed = nullptr;
+    CACHE_LOCK();
+    for (Entry *e = mru, *next; e != nullptr; e = next)
+    {
+        next = e->next;
+        retire(e, &freed);
+    }
+    mru = lru = nullptr;
+    memset(buckets, 0, sizeof(buckets));
+    budget = 0;
+    st.entries = 0;
+    st.bytes = 0;
+    st.budget = 0;
+    CACHE_UNLOCK();
+    freeChain(freed);
+}
+
+FleetGlyphCache::Entry *FleetGlyphCache::find(const FleetGlyphKey &key, uint32_t bucket) const
+{
+    for (Entry *e = buckets[bucket]; e != nullptr; e = e->chain)
+    {
+        if (same_key(e->key, key))
+        {
+            return e;
+        }
+    }
+    return nullptr;
+}
+
+void FleetGlyphCache::unlink(Entry *e)
+{
+    (e->prev ? e->prev->next : mru) = e->next;
+    (e->next ? e->next->prev : lru) = e->prev;
+}
+
+void FleetGlyphCache::pushFront(Entry *e)
+{
+    e->prev = nullptr;
+    e->next = mru;
+    (mru ? mru->prev : lru) = e;
+    mru = e;
+}
+
+bool FleetGlyphCache::get(const FleetGlyphKey &key, uint8_t *dst, uint32_t dst_stride)
+{
+    if (!enabled())
+    {
+        return false;
+    }
+    const uint32_t bucket = hash_of(key);
+    CACHE_LOCK();
+    Entry *e = find(key, bucket);
+    if (e == nullptr)
+    {
+        st.misses++;
+        CACHE_UNLOCK();
+        return false;
+    }
+    st.hits++;
+    if (e != mru)
+    {
+        unlink(e);
+        pushFront(e);
+    }
+    // Copy out of PSRAM with the lock released (on the S3 it's a spinlock
+    // with interrupts off); the pin keeps put() and end() from freeing it
+    e->pins++;
+    CACHE_UNLOCK();
+
+    copy_rows(dst, dst_stride, e->bitmap(), key.w, key.w, key.h);
+
+    CACHE_LOCK();
+    const bool release = --e->pins == 0 && e->retired;
+    CACHE_UNLOCK();
+    if (release)
+    {
+        fleet_free(e);
+    }
+    return true;
+}
+
+void FleetGlyphCache::put(const FleetGlyphKey &key, const uint8_t *src, uint32_t src_stride)
+{
+    const size_t bytes = (size_t)key.w * key.h;
+    if (!enabled() || bytes == 0 || bytes > FLEET_GLYPH_CACHE_MAX_ENTRY || bytes > budget / 4)
+    {
+        return;
+    }
+    Entry *e = (Entry *)fleet_malloc(sizeof(Entry) + bytes, FLEET_MEM_PSRAM);
+    if (e == nullptr)
+    {
+        return;
+    }
+    e->key = key;
+    e->pins = 0;
+    e->retired = false;
+    copy_rows(e->bitmap(), key.w, src, src_stride, key.w, key.h);
+
+    const uint32_t bucket = hash_of(key);
+    Entry *evicted = nullptr;
+    CACHE_LOCK();
+    if (find(key, bucket) != nullptr)
+    {
+        // The other draw unit got there first
+        CACHE_UNLOCK();
+        fleet_free(e);
+        return;
+    }
+    while (st.bytes + bytes > budget && lru != nullptr)
+    {
+        Entry *old = lru;
+        unlink(old);
+        Entry **link = &buckets[hash_of(old->key)];
+        while (*link != old)
+        {
+            link = &(*link)->chain;
+        }
+        *link = old->chain;
+        st.bytes -= old->bytes();
+        st.entries--;
+        st.evictions++;
+        retire(old, &evicted);
+    }
+    e->chain = buckets[bucket];
+    buckets[bucket] = e;
+    pushFront(e);
+    st.bytes += bytes;
+    st.entries++;
+    CACHE_UNLOCK();
+    freeChain(evicted);
+}
+
+FleetGlyphCacheStats FleetGlyphCache::stats() const
+{
+    CACHE_LOCK();
+    const FleetGlyphCacheStats s = st;
+    CACHE_UNLOCK();
+    return s;
+}
+
+void FleetGlyphCache::resetStats()
+{
+    CACHE_LOCK();
+    st.hits = st.misses = st.evictions = 0;
+    CACHE_UNLOCK();
+}
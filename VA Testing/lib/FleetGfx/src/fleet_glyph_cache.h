@@ -0,0 +1,97 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_glyph_cache
+ * Goal:    Keep rendered glyph bitmaps (8-bit alpha) in PSRAM, so large
+ * anti-aliased text isn't unpacked from the font again every frame.
+ *
+ * Entries are keyed by (font, glyph, box size) and evicted least recently
+ * used first once their bytes pass the budget. get() and put() copy, so a
+ * draw thread never holds a pointer into the cache: two LVGL draw units
+ * (FLEET_DRAW_UNITS=2) can share it. The lock only covers the lookup and
+ * list updates; bitmap copies, allocation and freeing happen outside it.
+ * On the ESP32 it is a spinlock that masks interrupts, so get() pins the
+ * entry while it copies and an eviction that meets a pinned entry leaves
+ * the free to get().
+ *
+ * The LVGL side (wrapping a font's get_glyph_bitmap) is in
+ * lib/FleetDisplay/src/fleet_font_cache.h. Nothing here depends on LVGL,
+ * so the host can check it (src/native/bench_glyph_cache).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#else
+#include <mutex>
+#endif
+
+// Largest bitmap kept, in bytes: a 48 px Montserrat glyph box is about
+// 48 x 50. Anything bigger isn't text and would just churn the cache.
+#ifndef FLEET_GLYPH_CACHE_MAX_ENTRY
+#define FLEET_GLYPH_CACHE_MAX_ENTRY 4096
+#endif
+
+struct FleetGlyphKey
+{
+    const void *font; // the font as LVGL resolved it (fallbacks are separate fonts)
+    uint32_t glyph;   // glyph id in that font: one per codepoint
+    uint16_t w, h;    // bitmap box, i.e. the glyph at this font's size
+};
+
+struct FleetGlyphCacheStats
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t entries;
+    size_t bytes;  // bitmap bytes held (entry headers not included)
+    size_t budget; // 0: cache off
+};
+
+class FleetGlyphCache
+{
+public:
+    static const int BUCKETS = 256;
+
+    // budget_bytes of bitmaps at most; 0 turns the cache off
+    bool begin(size_t budget_bytes);
+    void end();
+
+    bool enabled() const { return budget > 0; }
+
+    // On a hit, copy the w x h bitmap into dst (dst_stride bytes per row),
+    // mark it most recently used and return true
+    bool get(const FleetGlyphKey &key, uint8_t *dst, uint32_t dst_stride);
+
+    // Store a copy of a w x h bitmap. Least recently used entries go to
+    // make room; a glyph bigger than FLEET_GLYPH_CACHE_MAX_ENTRY or a
+    // quarter of the budget is not kept.
+    void put(const FleetGlyphKey &key, const uint8_t *src, uint32_t src_stride);
+
+    FleetGlyphCacheStats stats() const;
+    void resetStats();
+
+private:
+    struct Entry;
+
+    Entry *find(const FleetGlyphKey &key, uint32_t bucket) const;
+    void unlink(Entry *e);
+    void pushFront(Entry *e);
+    void retire(Entry *e, Entry **freed);
+    static void freeChain(Entry *e);
+
+    Entry *buckets[BUCKETS] = {};
+    Entry *mru = nullptr; // most recently used; lru at the other end
+    Entry *lru = nullptr;
+    size_t budget = 0;
+    FleetGlyphCacheStats st = {};
+#if defined(ARDUINO_ARCH_ESP32)
+    mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#else
+    mutable std::mutex mutex;
+#endif
+};
@@ -0,0 +1,134 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_metrics (see fleet_metrics.h)
+ */
+
+#include "fleet_metrics.h"
+#include "fleet_port.h"
+
+#include <string.h>
+
+int FleetHistogram::bucketOf(uint32_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+    const int b = 32 - __builtin_clz(value);
+    return b < BUCKETS ? b : BUCKETS - 1;
+}
+
+void FleetHistogram::record(uint32_t value)
+{
+    counts[bucketOf(value)]++;
+    if (n == 0 || value < lo)
+    {
+        lo = value;
+    }
+    if (value > hi)
+    {
+        hi = value;
+    }
+    n++;
+    sum += value;
+}
+
+void FleetHistogram::reset()
+{
+    memset(counts, 0, sizeof(counts));
+    n = 0;
+    sum = 0;
+    lo = hi = 0;
+}
+
+uint32_t FleetHistogram::percentile(unsigned pct) const
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    // Smallest bucket whose running count reaches pct% of the samples
+    const uint64_t want = ((uint64_t)n * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= want && seen > 0)
+        {
+            const uint32_t upper = i == BUCKETS - 1 ? hi : bucketLow(i + 1) - 1;
+            return upper < hi ? upper : hi;
+        }
+    }
+    return hi;
+}
+
+void FleetHistogram::dump(const char *name, const char *unit) const
+{
+    fleet_log("%s [%s]: n %u, min %u, avg %u, p50 %u, p90 %u, p99 %u, max %u", name, unit, (unsigned)n,
+              (unsigned)min(), (unsigned)mean(), (unsigned)percentile(50), (unsigned)percentile(90),
+              (unsigned)percentile(99), (unsigned)hi);
+    if (n == 0)
+    {
+        return;
+    }
+
+    uint32_t peak = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        peak = counts[i] > peak ? counts[i] : peak;
+    }
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        if (counts[i] == 0)
+        {
+            continue;
+        }
+        char bar[33];
+        const int len = (int)((uint64_t)counts[i] * (sizeof(bar) - 1) / peak);
+        memset(bar, '#', len);
+        bar[len > 0 ? len : 0] = '\0';
+        if (i == BUCKETS - 1)
+        {
+            fleet_log("  >= %8u : %8u %s", (unsigned)bucketLow(i), (unsigned)counts[i], bar);
+        }
+        else
+        {
+            fleet_log("  < %9u : %8u %s", (unsigned)bucketLow(i + 1), (unsigned)counts[i], bar);
+        }
+    }
+}
+
+void FleetMetrics::reset()
+{
+    handler_us.reset();
+    render_us.reset();
+    flush_us.reset();
+    bytes.reset();
+    areas.reset();
+    latency_us.reset();
+}
+
+void FleetMetrics::dump() const
+{
+    fleet_log("--- metrics ---");
+    handler_us.dump("lv_timer_handler", "us");
+    render_us.dump("render/frame", "us");
+    flush_us.dump("flush cb/frame", "us");
+    bytes.dump("flushed/frame", "B");
+    areas.dump("areas/frame", "areas");
+    latency_us.dump("invalidate->pixels", "us");
+    fleet_log("--- end metrics ---");
+}
+
+void FleetMetrics::handleCommand(int c)
+{
+    if (c == 'm')
+    {
+        dump();
+    }
+    else if (c == 'r')
+    {
+        reset();
+        fleet_log("metrics reset");
+    }
+}
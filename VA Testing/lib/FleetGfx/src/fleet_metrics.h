@@ -0,0 +1,68 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_metrics
+ * Goal:    Always-on, fixed-size histograms of what a frame costs, cheap
+ * enough to leave in every build and dump over serial when asked.
+ *
+ * FleetHistogram buckets values by powers of two: bucket 0 holds 0,
+ * bucket i holds [2^(i-1), 2^i), and the last bucket holds everything
+ * above. record() is a count-leading-zeros and a few adds, with no
+ * allocation, so it is safe in the flush path.
+ *
+ * FleetMetrics is the set FleetDisplay fills in (see fleet_display.cpp for
+ * where each one is measured). Nothing here knows about LVGL or Arduino,
+ * so the histograms behave the same on the host.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class FleetHistogram
+{
+public:
+    static const int BUCKETS = 24;
+
+    void record(uint32_t value);
+    void reset();
+
+    uint32_t count() const { return n; }
+    uint32_t min() const { return n ? lo : 0; }
+    uint32_t max() const { return hi; }
+    uint32_t mean() const { return n ? (uint32_t)(sum / n) : 0; }
+
+    // Upper bound of the bucket holding the pct-th percentile, clamped to
+    // max(). Good to a factor of two, which is what a log histogram buys.
+    uint32_t percentile(unsigned pct) const;
+
+    uint32_t bucket(int i) const { return counts[i]; }
+    static int bucketOf(uint32_t value);
+    static uint32_t bucketLow(int i) { return i == 0 ? 0 : 1u << (i - 1); }
+
+    // Summary line plus one line per non-empty bucket, via fleet_log()
+    void dump(const char *name, const char *unit) const;
+
+private:
+    uint32_t counts[BUCKETS] = {};
+    uint32_t n = 0;
+    uint64_t sum = 0;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+};
+
+struct FleetMetrics
+{
+    FleetHistogram handler_us; // one lv_timer_handler() call
+    FleetHistogram render_us;  // one refresh, minus time in the flush callback
+    FleetHistogram flush_us;   // flush callback CPU time, per frame
+    FleetHistogram bytes;      // pixel bytes flushed, per frame
+    FleetHistogram areas;      // flushed areas, per frame
+    FleetHistogram latency_us; // first invalidation -> last pixel on the wire
+
+    void reset();
+    void dump() const;
+
+    // Console commands: 'm' dumps, 'r' resets, anything else is ignored
+    // (so fleet_console_read()'s -1 can be passed straight in).
+    void handleCommand(int c);
+};
@@ -0,0 +1,56 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_mock_transport (see fleet_mock_transport.h)
+ */
+
+#include "fleet_mock_transport.h"
+
+void FleetMockTransport::setWindow(int x, int y, int w, int h)
+{
+    win_x = x;
+    win_y = y;
+    win_w = w;
+    win_h = h;
+    windows++;
+}
+
+void FleetMockTransport::push(const uint16_t *pixels, size_t count, uint8_t tag)
+{
+    pending.push_back({win_x, win_y, win_w, win_h, pixels, count, tag});
+}
+
+void FleetMockTransport::waitForDone()
+{
+    completeOne();
+}
+
+bool FleetMockTransport::completeOne()
+{
+    if (pending.empty())
+    {
+        return false;
+    }
+
+    Pending p = pending.front();
+    pending.pop_front();
+
+    Push done;
+    done.x = p.x;
+    done.y = p.y;
+    done.w = p.w;
+    done.h = p.h;
+    done.tag = p.tag;
+    done.src = p.pixels;
+    done.pixels.assign(p.pixels, p.pixels + p.count);
+    completed.push_back(done);
+
+    signalDone(p.tag);
+    return true;
+}
+
+void FleetMockTransport::completeAll()
+{
+    while (completeOne())
+    {
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_mock_transport
+ * Goal:    A FleetTransport for the host that never completes anything by
+ * itself, so the flush state machine can be stepped one DMA at a time.
+ *
+ * Pushes are queued as "in flight". completeOne() finishes the oldest one:
+ * only then are its pixels copied out of the caller's buffer (like a real
+ * DMA reading late), which catches any buffer reused too early.
+ * waitForDone() completes one push, so code that blocks on the transport
+ * runs to completion single-threaded.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "fleet_transport.h"
+
+class FleetMockTransport : public FleetTransport
+{
+public:
+    struct Push
+    {
+        int x, y, w, h;              // window active for this push
+        uint8_t tag;
+        const uint16_t *src;          // the pointer that was pushed
+        std::vector<uint16_t> pixels; // captured at completion time
+    };
+
+    void setWindow(int x, int y, int w, int h) override;
+    void push(const uint16_t *pixels, size_t count, uint8_t tag) override;
+    void waitForDone() override;
+
+    // Finish the oldest in-flight push. Returns false if none was queued.
+    bool completeOne();
+    void completeAll();
+
+    size_t inFlight() const { return pending.size(); }
+
+    // Everything completed so far, in order
+    std::vector<Push> completed;
+    size_t windows = 0; // number of setWindow() calls
+
+private:
+    struct Pending
+    {
+        int x, y, w, h;
+        const uint16_t *pixels;
+        size_t count;
+        uint8_t tag;
+    };
+
+    std::deque<Pending> pending;
+    int win_x = 0, win_y = 0, win_w = 0, win_h = 0;
+};
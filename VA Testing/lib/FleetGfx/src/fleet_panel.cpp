@@ -0,0 +1,97 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_panel (see fleet_panel.h)
+ */
+
+#include "fleet_panel.h"
+
+#include <strings.h>
+
+const FleetPanelQuirks fleet_panel_table[] = {
+    // name        x_align y_align full_width
+    {"generic", 1, 1, false},
+    // Guition JC3248W535 (QSPI): column address is ignored, rows work
+    {"AXS15231B", 1, 1, true},
+    // QSPI AMOLEDs: start and size must be even
+    {"SH8601", 2, 2, false},
+    {"CO5300", 2, 2, false},
+    // Waveshare 86 box (480x480 RGB): the panel scans a PSRAM framebuffer,
+    // so any rectangle can be copied in
+    {"ST7701S", 1, 1, false},
+    {nullptr, 0, 0, false},
+};
+
+const FleetPanelQuirks *fleet_panel_find(const char *name)
+{
+    if (name == nullptr)
+    {
+        return nullptr;
+    }
+    for (const FleetPanelQuirks *q = fleet_panel_table; q->name != nullptr; q++)
+    {
+        if (strcasecmp(q->name, name) == 0)
+        {
+            return q;
+        }
+    }
+    return nullptr;
+}
+
+bool fleet_panel_any_window(const FleetPanelQuirks *q)
+{
+    return !q->full_width && q->x_align <= 1 && q->y_align <= 1;
+}
+
+// Round [lo, hi] out to multiples of `align`, staying below `size`
+static void align_span(int32_t *lo, int32_t *hi, int align, int size)
+{
+    if (align <= 1)
+    {
+        return;
+    }
+    *lo -= *lo % align;
+    *hi += align - 1 - *hi % align;
+    if (*hi > size - 1)
+    {
+        *hi = size - 1;
+    }
+}
+
+void fleet_panel_round(const FleetPanelQuirks *q, FleetRect *r, int panel_w, int panel_h, FleetRotation rot)
+{
+    // To panel coordinates (lv_display_rotate_area()'s mapping)...
+    FleetRect p = *r;
+    if (rot == FLEET_ROTATION_90)
+    {
+        p = {r->y1, panel_h - 1 - r->x2, r->y2, panel_h - 1 - r->x1};
+    }
+    else if (rot == FLEET_ROTATION_270)
+    {
+        p = {panel_w - 1 - r->y2, r->x1, panel_w - 1 - r->y1, r->x2};
+    }
+
+    if (q->full_width)
+    {
+        p.x1 = 0;
+        p.x2 = panel_w - 1;
+    }
+    else
+    {
+        align_span(&p.x1, &p.x2, q->x_align, panel_w);
+    }
+    align_span(&p.y1, &p.y2, q->y_align, panel_h);
+
+    // ...and back
+    if (rot == FLEET_ROTATION_90)
+    {
+        *r = {panel_h - 1 - p.y2, p.x1, panel_h - 1 - p.y1, p.x2};
+    }
+    else if (rot == FLEET_ROTATION_270)
+    {
+        *r = {p.y1, panel_w - 1 - p.x2, p.y2, panel_w - 1 - p.x1};
+    }
+    else
+    {
+        *r = p;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_panel
+ * Goal:    What address windows each LCD controller really accepts, and
+ * the rounding that turns any invalidated area into one it does.
+ *
+ * Some controllers can't take an arbitrary window. The AXS15231B on QSPI
+ * ignores the column range, so anything narrower than the panel lands in
+ * the wrong place. Some AMOLED controllers want even coordinates. Each
+ * controller is one row in fleet_panel_table; a new panel is a new row.
+ *
+ * FleetDisplay applies fleet_panel_round() from LVGL's
+ * LV_EVENT_INVALIDATE_AREA. So LVGL only ever renders legal areas, its
+ * draw-buffer strips are rounded the same way, and FleetCoalescer then
+ * merges the legal areas into the cheapest set of transactions. The
+ * bounding box of two legal areas is legal too.
+ *
+ * Nothing here depends on LVGL (src/native/bench_panel_quirks checks it).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "fleet_coalesce.h"
+#include "fleet_rotate.h"
+
+// Default for FleetDisplayConfig::panel
+#ifndef FLEET_PANEL
+#define FLEET_PANEL "generic"
+#endif
+
+struct FleetPanelQuirks
+{
+    const char *name; // controller, as passed in FleetDisplayConfig::panel
+    uint8_t x_align;  // window x and width in multiples of this (1: any)
+    uint8_t y_align;  // window y and height in multiples of this (1: any)
+    bool full_width;  // no column windowing: every window spans whole rows
+};
+
+// Known controllers, terminated by an entry with name == nullptr
+extern const FleetPanelQuirks fleet_panel_table[];
+
+// Look up a controller by name (case-insensitive); nullptr if unknown
+const FleetPanelQuirks *fleet_panel_find(const char *name);
+
+// True if the controller takes any window, i.e. rounding never changes one
+bool fleet_panel_any_window(const FleetPanelQuirks *q);
+
+// Grow `r`, an area in LVGL's (possibly rotated) coordinates, to the
+// smallest window the controller accepts. panel_w/panel_h are the panel's
+// size before rotation; the result stays on the panel.
+void fleet_panel_round(const FleetPanelQuirks *q, FleetRect *r, int panel_w, int panel_h,
+                       FleetRotation rot = FLEET_ROTATION_0);
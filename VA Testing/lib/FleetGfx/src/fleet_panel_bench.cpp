@@ -0,0 +1,285 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_panel_bench (see fleet_panel_bench.h)
+ */
+
+#include "fleet_panel_bench.h"
+
+#include "fleet_port.h"
+
+const FleetWindowSize fleet_bench_windows[] = {
+    {1, 1}, {16, 16}, {64, 64}, {320, 1}, {320, 10}, {320, 48}, {320, 160}, {320, 480},
+};
+const int fleet_bench_window_count = sizeof(fleet_bench_windows) / sizeof(fleet_bench_windows[0]);
+
+const char *fleet_bench_test_name(FleetBenchTest test)
+{
+    switch (test)
+    {
+    case FLEET_BENCH_FILL:
+        return "fill";
+    case FLEET_BENCH_PUSH_POLL:
+        return "push_poll";
+    case FLEET_BENCH_PUSH_DMA:
+        return "push_dma";
+    default:
+        return "?";
+    }
+}
+
+bool FleetPanelBench::run(FleetBenchBus *b, const FleetPanelBenchConfig &c)
+{
+    bus = b;
+    cfg = c;
+    bus_name = bus->name();
+    width = bus->width();
+    height = bus->height();
+    n_throughput = n_windows = n_skipped = 0;
+    last_hz = 0;
+    last_probe_mb_s = 0;
+    if (!cfg.windows)
+    {
+        cfg.windows = fleet_bench_windows;
+        cfg.window_count = fleet_bench_window_count;
+    }
+    if (cfg.window_count > MAX_WINDOWS)
+    {
+        cfg.window_count = MAX_WINDOWS;
+    }
+    if (cfg.frames < 1)
+    {
+        cfg.frames = 1;
+    }
+    if (cfg.window_iters < 1)
+    {
+        cfg.window_iters = 1;
+    }
+    if (!cfg.strip[0] || !cfg.strip[1] || cfg.strip_px < (size_t)width)
+    {
+        fleet_log("fleet_panel_bench: need two strip buffers of at least one row (%d px)", width);
+        return false;
+    }
+
+    // Two colours, so the pushes show as stripes
+    for (size_t i = 0; i < cfg.strip_px; i++)
+    {
+        cfg.strip[0][i] = 0x1f00;
+        cfg.strip[1][i] = 0xe007;
+    }
+
+    const int count = cfg.bus_count < MAX_BUS ? cfg.bus_count : MAX_BUS;
+    for (int i = 0; i < count; i++)
+    {
+        const uint32_t hz = bus->setBusHz(cfg.bus_hz[i]);
+        if (hz == 0)
+        {
+            skipped[n_skipped++] = {cfg.bus_hz[i], FLEET_BENCH_SKIP_REFUSED, 0, 0};
+            continue;
+        }
+        if (!probe(hz))
+        {
+            continue;
+        }
+        runThroughput(hz);
+        const FleetThroughputRow &dma = throughput_rows[n_throughput - FLEET_BENCH_TEST_COUNT + FLEET_BENCH_PUSH_DMA];
+        runWindows(hz, dma.mb_s);
+    }
+    return true;
+}
+
+// No driver we use can read its clock back, and bb_spi_lcd re-inits to
+// change it. Time one fill: faster than the wire allows at `hz`, or no
+// different from a clock at least 10% away, means the bus is still at
+// some other clock.
+bool FleetPanelBench::probe(uint32_t hz)
+{
+    bus->waitDma();
+    const uint32_t t0 = bus->micros();
+    bus->fillScreen(0);
+    uint32_t us = bus->micros() - t0;
+    if (us == 0)
+    {
+        us = 1;
+    }
+    const float mb_s = (float)width * height * 2 / us;
+    const float wire_mb_s = hz / 1e6f * cfg.lanes / 8;
+
+    uint32_t same_as = 0;
+    bool taken = mb_s <= wire_mb_s * 1.05f;
+    if (taken && last_hz != 0)
+    {
+        const float clock_ratio = (float)hz / last_hz;
+        const float rate_ratio = mb_s / last_probe_mb_s;
+        if ((clock_ratio > 1.1f || clock_ratio < 1 / 1.1f) && rate_ratio > 0.97f && rate_ratio < 1.03f)
+        {
+            taken = false;
+            same_as = last_hz;
+        }
+    }
+    if (!taken)
+    {
+        skipped[n_skipped++] = {hz, FLEET_BENCH_SKIP_NOT_TAKEN, mb_s, same_as};
+        return false;
+    }
+    last_hz = hz;
+    last_probe_mb_s = mb_s;
+    return true;
+}
+
+uint32_t FleetPanelBench::pushFrame(bool dma, uint32_t *cpu_us)
+{
+    const int rows = (int)(cfg.strip_px / width);
+    const uint32_t t0 = bus->micros();
+    bus->setAddrWindow(0, 0, width, height);
+    uint32_t cpu = bus->micros() - t0;
+    for (int y = 0, i = 0; y < height; y += rows, i++)
+    {
+        const int n = (y + rows <= height ? rows : height - y) * width;
+        // The driver would wait for the previous DMA inside pushPixels();
+        // waiting here first keeps that out of the CPU time
+        if (dma)
+        {
+            bus->waitDma();
+        }
+        const uint32_t c0 = bus->micros();
+        bus->pushPixels(cfg.strip[i & 1], n, dma);
+        cpu += bus->micros() - c0;
+    }
+    if (dma)
+    {
+        bus->waitDma();
+    }
+    *cpu_us += cpu;
+    return bus->micros() - t0;
+}
+
+void FleetPanelBench::runThroughput(uint32_t hz)
+{
+    const float bytes = (float)width * height * 2 * cfg.frames;
+    const float wire_mb_s = hz / 1e6f * cfg.lanes / 8;
+    for (int t = 0; t < FLEET_BENCH_TEST_COUNT; t++)
+    {
+        uint32_t total = 0, cpu = 0;
+        if (t == FLEET_BENCH_FILL)
+        {
+            static const uint16_t colors[] = {0xf800, 0x07e0, 0x001f}; // red, green, blue
+            const uint32_t t0 = bus->micros();
+            for (int f = 0; f < cfg.frames; f++)
+            {
+                bus->fillScreen(colors[f % 3]);
+            }
+            total = cpu = bus->micros() - t0;
+        }
+        else
+        {
+            for (int f = 0; f < cfg.frames; f++)
+            {
+                total += pushFrame(t == FLEET_BENCH_PUSH_DMA, &cpu);
+            }
+        }
+        if (total == 0)
+        {
+            total = 1;
+        }
+
+        FleetThroughputRow &r = throughput_rows[n_throughput++];
+        r.bus_hz = hz;
+        r.test = (FleetBenchTest)t;
+        r.us_per_frame = total / cfg.frames;
+        r.cpu_us_per_frame = cpu / cfg.frames;
+        r.fps = cfg.frames * 1e6f / total;
+        r.mb_s = bytes / total;
+        r.wire_pct = wire_mb_s > 0 ? r.mb_s * 100 / wire_mb_s : 0;
+    }
+}
+
+void FleetPanelBench::pushArea(int count)
+{
+    for (int i = 0; count > 0; i++)
+    {
+        const int n = count < (int)cfg.strip_px ? count : (int)cfg.strip_px;
+        bus->pushPixels(cfg.strip[i & 1], n, true);
+        count -= n;
+    }
+}
+
+void FleetPanelBench::runWindows(uint32_t hz, float stream_bytes_per_us)
+{
+    for (int s = 0; s < cfg.window_count; s++)
+    {
+        const int w = cfg.windows[s].w, h = cfg.windows[s].h;
+        if (w > width || h > height)
+        {
+            continue;
+        }
+        // Walk the window over the panel, so no position is special
+        uint32_t t0 = bus->micros();
+        for (int i = 0; i < cfg.window_iters; i++)
+        {
+            bus->setAddrWindow(i * 7 % (width - w + 1), i * 13 % (height - h + 1), w, h);
+        }
+        const uint32_t set_us = bus->micros() - t0;
+
+        t0 = bus->micros();
+        for (int i = 0; i < cfg.window_iters; i++)
+        {
+            bus->setAddrWindow(i * 7 % (width - w + 1), i * 13 % (height - h + 1), w, h);
+            pushArea(w * h);
+            bus->waitDma();
+        }
+        const uint32_t txn_us = bus->micros() - t0;
+
+        const float bytes = (float)w * h * 2;
+        FleetWindowRow &r = window_rows[n_windows++];
+        r.bus_hz = hz;
+        r.w = w;
+        r.h = h;
+        r.us_set_window = (float)set_us / cfg.window_iters;
+        r.us_per_txn = (float)txn_us / cfg.window_iters;
+        r.mb_s = r.us_per_txn > 0 ? bytes / r.us_per_txn : 0;
+        r.overhead_us = r.us_per_txn - (stream_bytes_per_us > 0 ? bytes / stream_bytes_per_us : 0);
+    }
+}
+
+void FleetPanelBench::print() const
+{
+    fleet_log("# fleet_panel_bench: %s %dx%d, %d lanes, %d frames per test, %d transactions per window",
+              bus_name, width, height, cfg.lanes, cfg.frames, cfg.window_iters);
+    for (int i = 0; i < n_skipped; i++)
+    {
+        const FleetSkippedClock &k = skipped[i];
+        if (k.why == FLEET_BENCH_SKIP_REFUSED)
+        {
+            fleet_log("# %.1f MHz skipped: the bus refused it", k.bus_hz / 1e6f);
+        }
+        else if (k.same_as_hz)
+        {
+            fleet_log("# %.1f MHz skipped: clock didn't take (fill at %.2f MB/s, same as %.1f MHz)", k.bus_hz / 1e6f,
+                      k.probe_mb_s, k.same_as_hz / 1e6f);
+        }
+        else
+        {
+            fleet_log("# %.1f MHz skipped: clock didn't take (fill at %.2f MB/s, faster than the wire)",
+                      k.bus_hz / 1e6f, k.probe_mb_s);
+        }
+    }
+
+    fleet_log("# throughput (full screen)");
+    fleet_log("bus_mhz,test,us_per_frame,fps,mb_s,wire_pct,cpu_pct");
+    for (int i = 0; i < n_throughput; i++)
+    {
+        const FleetThroughputRow &r = throughput_rows[i];
+        fleet_log("%.1f,%s,%u,%.2f,%.2f,%.1f,%.1f", r.bus_hz / 1e6f, fleet_bench_test_name(r.test),
+                  (unsigned)r.us_per_frame, r.fps, r.mb_s, r.wire_pct,
+                  r.us_per_frame ? r.cpu_us_per_frame * 100.0f / r.us_per_frame : 0.0f);
+    }
+
+    fleet_log("# windows (setAddrWindow + DMA push of w x h)");
+    fleet_log("bus_mhz,w,h,us_set_window,us_per_txn,mb_s,overhead_us");
+    for (int i = 0; i < n_windows; i++)
+    {
+        const FleetWindowRow &r = window_rows[i];
+        fleet_log("%.1f,%d,%d,%.2f,%.2f,%.2f,%.2f", r.bus_hz / 1e6f, r.w, r.h, r.us_set_window, r.us_per_txn, r.mb_s,
+                  r.overhead_us);
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_panel_bench
+ * Goal:    Measure what the panel bus itself can do, with no LVGL and no
+ * flush pipeline in the way: full-screen fills and pushes (polling and
+ * DMA) and the cost of an address window, across bus clocks.
+ *
+ * The benchmark drives a FleetBenchBus, the handful of bb_spi_lcd calls
+ * it times. ex00_hello_bb_spi implements it on BB_SPI_LCD; FleetSimBus
+ * (fleet_sim_bus.h) implements it on a modelled bus with a virtual clock,
+ * so src/native/bench_panel_throughput can check the harness's arithmetic
+ * on the host.
+ *
+ * Results come back as rows and print as CSV (MB/s is 10^6 bytes/s):
+ *
+ *     bus_mhz,test,us_per_frame,fps,mb_s,wire_pct,cpu_pct
+ *     bus_mhz,w,h,us_set_window,us_per_txn,mb_s,overhead_us
+ *
+ * wire_pct compares mb_s with the clock's raw rate (MHz x lanes / 8);
+ * cpu_pct is the share of the frame the CPU spent inside the calls rather
+ * than free (what DMA buys). overhead_us is what a window transaction
+ * costs beyond its pixels at the full-screen DMA rate.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The panel operations being timed. Pixels are sent as they are (wire
+// format); the benchmark doesn't care what they show.
+class FleetBenchBus
+{
+public:
+    virtual ~FleetBenchBus() {}
+
+    virtual const char *name() const = 0;
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+
+    // Switch the bus clock. Returns the clock now in use, 0 if `hz` can't
+    // be set (the benchmark skips it). The benchmark also times a fill
+    // right after, and skips a clock that plainly didn't take.
+    virtual uint32_t setBusHz(uint32_t hz) = 0;
+
+    virtual void fillScreen(uint16_t color) = 0;
+    virtual void setAddrWindow(int x, int y, int w, int h) = 0;
+
+    // Blocking, or started on the DMA (`dma`). A DMA push may wait for the
+    // previous one first; waitDma() waits for the last one.
+    virtual void pushPixels(const uint16_t *px, int count, bool dma) = 0;
+    virtual void waitDma() = 0;
+
+    // The clock every time is taken from
+    virtual uint32_t micros() = 0;
+};
+
+enum FleetBenchTest
+{
+    FLEET_BENCH_FILL,      // fillScreen()
+    FLEET_BENCH_PUSH_POLL, // full-screen window, strips pushed blocking
+    FLEET_BENCH_PUSH_DMA,  // same, each strip on the DMA
+    FLEET_BENCH_TEST_COUNT,
+};
+
+const char *fleet_bench_test_name(FleetBenchTest test);
+
+struct FleetThroughputRow
+{
+    uint32_t bus_hz;
+    FleetBenchTest test;
+    uint32_t us_per_frame;
+    uint32_t cpu_us_per_frame; // inside the driver calls, not waiting for the DMA
+    float fps;
+    float mb_s;
+    float wire_pct;
+};
+
+struct FleetWindowRow
+{
+    uint32_t bus_hz;
+    int w, h;
+    float us_set_window; // setAddrWindow() alone
+    float us_per_txn;    // window + its pixels on the DMA, waited for
+    float mb_s;
+    float overhead_us;   // us_per_txn minus the pixels at the streaming rate
+};
+
+struct FleetWindowSize
+{
+    int w, h;
+};
+
+enum FleetBenchSkip
+{
+    FLEET_BENCH_SKIP_REFUSED,   // setBusHz() returned 0
+    FLEET_BENCH_SKIP_NOT_TAKEN, // the probe fill ran at another clock's rate
+};
+
+struct FleetSkippedClock
+{
+    uint32_t bus_hz;
+    FleetBenchSkip why;
+    float probe_mb_s;   // NOT_TAKEN: the fill rate measured
+    uint32_t same_as_hz; // NOT_TAKEN: the clock it matched (0: faster than the wire)
+};
+
+struct FleetPanelBenchConfig
+{
+    const uint32_t *bus_hz = nullptr; // clocks to sweep, in order
+    int bus_count = 0;
+    int lanes = 4;                    // data lines (QSPI: 4), for wire_pct
+    int frames = 10;                  // full-screen frames per test
+    int window_iters = 100;           // transactions per window size
+    const FleetWindowSize *windows = nullptr; // nullptr: fleet_bench_windows
+    int window_count = 0;
+    // Two strip buffers of strip_px pixels, DMA-capable on the device
+    uint16_t *strip[2] = {nullptr, nullptr};
+    size_t strip_px = 0;
+};
+
+// Default window sizes: tiny to full screen, for a 320-wide panel
+extern const FleetWindowSize fleet_bench_windows[];
+extern const int fleet_bench_window_count;
+
+class FleetPanelBench
+{
+public:
+    static const int MAX_BUS = 8;
+    static const int MAX_WINDOWS = 16;
+
+    // Runs every test at every clock; the results stay in the object.
+    // False if the config can't run (no strips, or strips under one row).
+    bool run(FleetBenchBus *bus, const FleetPanelBenchConfig &cfg);
+
+    int throughputCount() const { return n_throughput; }
+    const FleetThroughputRow &throughput(int i) const { return throughput_rows[i]; }
+    int windowCount() const { return n_windows; }
+    const FleetWindowRow &window(int i) const { return window_rows[i]; }
+    int skippedCount() const { return n_skipped; }
+    const FleetSkippedClock &skippedClock(int i) const { return skipped[i]; }
+
+    // Both tables as CSV via fleet_log(); '#' lines are comments
+    void print() const;
+
+private:
+    bool probe(uint32_t hz); // false (and skipped) if the clock didn't take
+    void runThroughput(uint32_t hz);
+    void runWindows(uint32_t hz, float stream_bytes_per_us);
+    uint32_t pushFrame(bool dma, uint32_t *cpu_us); // returns the frame's time
+    void pushArea(int count);                      // count pixels, DMA strips
+
+    FleetBenchBus *bus = nullptr;
+    FleetPanelBenchConfig cfg;
+    const char *bus_name = "";
+    int width = 0, height = 0;
+    FleetThroughputRow throughput_rows[MAX_BUS * FLEET_BENCH_TEST_COUNT];
+    int n_throughput = 0;
+    FleetWindowRow window_rows[MAX_BUS * MAX_WINDOWS];
+    int n_windows = 0;
+    FleetSkippedClock skipped[MAX_BUS];
+    int n_skipped = 0;
+    uint32_t last_hz = 0;      // last clock that took, and its probe rate
+    float last_probe_mb_s = 0;
+};
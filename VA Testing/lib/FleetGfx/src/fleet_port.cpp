@@ -0,0 +1,122 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_port (see fleet_port.h)
+ */
+
+#include "fleet_port.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#if __has_include(<esp_memory_utils.h>)
+#include <esp_memory_utils.h> // IDF 5
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+
+uint32_t fleet_millis(void)
+{
+    return millis();
+}
+
+uint32_t fleet_micros(void)
+{
+    return micros();
+}
+
+void fleet_log(const char *fmt, ...)
+{
+    char line[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    Serial.println(line);
+}
+
+int fleet_console_read(void)
+{
+    return Serial.available() ? Serial.read() : -1;
+}
+
+void *fleet_malloc(size_t size, FleetMemKind kind)
+{
+    switch (kind)
+    {
+    case FLEET_MEM_PSRAM:
+        return heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    case FLEET_MEM_DMA:
+        return heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    default:
+        return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+}
+
+void fleet_free(void *ptr)
+{
+    heap_caps_free(ptr);
+}
+
+bool fleet_dma_readable(const void *ptr)
+{
+    return esp_ptr_dma_capable(ptr);
+}
+
+#else // Host
+
+#include <chrono>
+
+static const auto start_time = std::chrono::steady_clock::now();
+
+uint32_t fleet_millis(void)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start_time)
+        .count();
+}
+
+uint32_t fleet_micros(void)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start_time)
+        .count();
+}
+
+void fleet_log(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    putchar('\n');
+    fflush(stdout);
+}
+
+int fleet_console_read(void)
+{
+    return -1;
+}
+
+void *fleet_malloc(size_t size, FleetMemKind kind)
+{
+    (void)kind;
+    return malloc(size);
+}
+
+void fleet_free(void *ptr)
+{
+    free(ptr);
+}
+
+bool fleet_dma_readable(const void *ptr)
+{
+    (void)ptr;
+    return true;
+}
+
+#endif
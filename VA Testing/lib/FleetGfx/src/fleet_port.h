@@ -0,0 +1,42 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_port
+ * Goal:    The few platform services the display code needs, implemented
+ * for Arduino-ESP32 and for the host, so nothing above this file has to
+ * #if on the platform just to log, time or allocate.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Milliseconds / microseconds since boot (or process start on the host).
+// fleet_millis has the lv_tick_get_cb_t signature, so it can be handed to
+// lv_tick_set_cb() directly.
+uint32_t fleet_millis(void);
+uint32_t fleet_micros(void);
+
+// printf-style line to Serial (device) or stdout (host)
+void fleet_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Next byte typed on the serial console, or -1 if there is none. Never
+// blocks. Always -1 on the host.
+int fleet_console_read(void);
+
+enum FleetMemKind
+{
+    FLEET_MEM_PSRAM,    // big, slow, not DMA-able from every peripheral
+    FLEET_MEM_INTERNAL, // fast SRAM
+    FLEET_MEM_DMA,      // internal and DMA-capable
+};
+
+// On the host every kind is plain malloc()
+void *fleet_malloc(size_t size, FleetMemKind kind);
+void fleet_free(void *ptr);
+
+// True if a DMA push can read `ptr` directly: DMA-capable internal RAM
+// only. Not memory-mapped flash (const arrays, fleet_asset_pack), and not
+// PSRAM, which IDF's spi_master would bounce through a malloc + memcpy per
+// transaction. Always true on the host.
+bool fleet_dma_readable(const void *ptr);
@@ -0,0 +1,85 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_rotate (see fleet_rotate.h)
+ */
+
+#include "fleet_rotate.h"
+
+void fleet_rotate_rgb565_naive(uint16_t *dst, const uint16_t *src, int src_w, int src_h, int src_stride,
+                               FleetRotation rot)
+{
+    for (int x = 0; x < src_w; x++)
+    {
+        uint16_t *d = dst + (size_t)x * src_h;
+        for (int y = 0; y < src_h; y++)
+        {
+            d[y] = rot == FLEET_ROTATION_90 ? src[(size_t)y * src_stride + (src_w - 1 - x)]
+                                            : src[(size_t)(src_h - 1 - y) * src_stride + x];
+        }
+    }
+}
+
+// One kernel per (rotation, swap) pair, so the inner loop has no branches.
+// Inside a tile, source rows are read forward, one contiguous run of
+// pixels each, and scattered down a column of the tile's destination
+// rows (which stay in cache). Tiles are visited in source order too, so
+// the whole strip streams through the source once, front to back.
+//
+// ROT90: source row c, pixels src_w - 1 - r, i.e. r descending.
+// ROT270: source row src_h - 1 - c, pixels r ascending.
+template <bool ROT90, bool SWAP>
+static void rotate_tiles(uint16_t *dst, const uint16_t *src, int src_w, int src_h, int src_stride, int row0,
+                         int rows)
+{
+    const int row_end = row0 + rows;
+    for (int y0 = 0; y0 < src_h; y0 += FLEET_ROTATE_BLOCK)
+    {
+        const int y1 = y0 + FLEET_ROTATE_BLOCK < src_h ? y0 + FLEET_ROTATE_BLOCK : src_h;
+        for (int r0 = row0; r0 < row_end; r0 += FLEET_ROTATE_BLOCK)
+        {
+            const int r1 = r0 + FLEET_ROTATE_BLOCK < row_end ? r0 + FLEET_ROTATE_BLOCK : row_end;
+            const int n = r1 - r0;
+            for (int y = y0; y < y1; y++)
+            {
+                // Destination column of source row y, and the first pixel
+                // of the run, in source memory order
+                const int c = ROT90 ? y : src_h - 1 - y;
+                const uint16_t *s = src + (size_t)y * src_stride + (ROT90 ? src_w - r1 : r0);
+                uint16_t *d = ROT90 ? dst + (size_t)(r1 - 1 - row0) * src_h + c : dst + (size_t)(r0 - row0) * src_h + c;
+                const ptrdiff_t step = ROT90 ? -(ptrdiff_t)src_h : (ptrdiff_t)src_h;
+                for (int i = 0; i < n; i++, d += step)
+                {
+                    const uint16_t v = s[i];
+                    *d = SWAP ? (uint16_t)((v >> 8) | (v << 8)) : v;
+                }
+            }
+        }
+    }
+}
+
+void fleet_rotate_rgb565(uint16_t *dst, const uint16_t *src, int src_w, int src_h, int src_stride, FleetRotation rot,
+                         int row0, int rows, bool swap)
+{
+    if (rot == FLEET_ROTATION_90)
+    {
+        if (swap)
+        {
+            rotate_tiles<true, true>(dst, src, src_w, src_h, src_stride, row0, rows);
+        }
+        else
+        {
+            rotate_tiles<true, false>(dst, src, src_w, src_h, src_stride, row0, rows);
+        }
+    }
+    else
+    {
+        if (swap)
+        {
+            rotate_tiles<false, true>(dst, src, src_w, src_h, src_stride, row0, rows);
+        }
+        else
+        {
+            rotate_tiles<false, false>(dst, src, src_w, src_h, src_stride, row0, rows);
+        }
+    }
+}
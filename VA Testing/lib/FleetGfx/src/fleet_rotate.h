@@ -0,0 +1,62 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_rotate
+ * Goal:    90/270 degree RGB565 rotation for landscape UIs, fused with the
+ * byte swap so a strip is converted in one pass.
+ *
+ * The AXS15231B ignores bb_spi_lcd's setRotation(), so landscape has to
+ * be done in software. LVGL's lv_draw_sw_rotate() walks the source one
+ * column at a time: every pixel read is a new cache line, which hurts
+ * badly when the draw buffer lives in PSRAM. Then the swap makes a second
+ * pass over the result.
+ *
+ * fleet_rotate_rgb565() works in FLEET_ROTATE_BLOCK x FLEET_ROTATE_BLOCK
+ * tiles instead. Each source row of a tile is one contiguous forward
+ * read, for 90 and 270 alike, while the tile's destination rows stay in
+ * cache. It swaps while storing, and it can produce
+ * any band of destination rows, so the flush pipeline rotates straight into
+ * its DMA strips.
+ *
+ * Both functions use lv_draw_sw_rotate()'s mapping, so lv_display_rotate_area()
+ * gives the panel window. For a src_w x src_h source the result is src_w rows
+ * of src_h pixels:
+ *
+ *     90:  dst[r][c] = src[c][src_w - 1 - r]
+ *     270: dst[r][c] = src[src_h - 1 - c][r]
+ *
+ * Strides are in pixels. No Arduino/LVGL includes, so this builds on the host.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Tile edge in pixels. 16 RGB565 pixels are one 32-byte cache line,
+// which is the ESP32-S3's PSRAM cache line size in the default config.
+#ifndef FLEET_ROTATE_BLOCK
+#define FLEET_ROTATE_BLOCK 16
+#endif
+
+// Default for FleetDisplayConfig::rotation, in degrees (0, 90 or 270)
+#ifndef FLEET_ROTATION
+#define FLEET_ROTATION 0
+#endif
+
+enum FleetRotation
+{
+    FLEET_ROTATION_0 = 0,
+    FLEET_ROTATION_90 = 90,
+    FLEET_ROTATION_270 = 270,
+};
+
+// Reference: one pixel at a time, in lv_draw_sw_rotate()'s loop order.
+// Writes the whole rotated image (src_w rows of src_h pixels). No swap.
+void fleet_rotate_rgb565_naive(uint16_t *dst, const uint16_t *src, int src_w, int src_h, int src_stride,
+                               FleetRotation rot);
+
+// Destination rows [row0, row0 + rows) of the rotated image, tile by tile,
+// byte-swapped if `swap`. dst[0] is the first pixel of row0; rows are
+// src_h pixels apart. `rot` must be FLEET_ROTATION_90 or FLEET_ROTATION_270.
+void fleet_rotate_rgb565(uint16_t *dst, const uint16_t *src, int src_w, int src_h, int src_stride, FleetRotation rot,
+                         int row0, int rows, bool swap);
@@ -0,0 +1,85 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_scheduler (see fleet_scheduler.h)
+ */
+
+#include "fleet_scheduler.h"
+#include "fleet_port.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+bool FleetScheduler::begin()
+{
+    if (sem == nullptr)
+    {
+        sem = xSemaphoreCreateBinary();
+    }
+    return sem != nullptr;
+}
+
+bool FleetScheduler::sleep(uint32_t ms)
+{
+    ms = ms < FLEET_SCHED_MAX_SLEEP_MS ? ms : FLEET_SCHED_MAX_SLEEP_MS;
+
+    // Round up, so we never wake before LVGL's timer is due
+    const TickType_t ticks = (ms * configTICK_RATE_HZ + 999) / 1000;
+    const uint32_t t0 = fleet_micros();
+    const bool woken = xSemaphoreTake(sem, ticks) == pdTRUE;
+
+    stats_.sleeps++;
+    stats_.woken += woken;
+    stats_.slept_us += fleet_micros() - t0;
+    return woken;
+}
+
+void FleetScheduler::wake()
+{
+    xSemaphoreGive(sem);
+}
+
+void FleetScheduler::wakeFromISR()
+{
+    BaseType_t higher_prio_woken = pdFALSE;
+    xSemaphoreGiveFromISR(sem, &higher_prio_woken);
+    portYIELD_FROM_ISR(higher_prio_woken);
+}
+
+#else // Host
+
+#include <chrono>
+
+bool FleetScheduler::begin()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending = false;
+    return true;
+}
+
+bool FleetScheduler::sleep(uint32_t ms)
+{
+    ms = ms < FLEET_SCHED_MAX_SLEEP_MS ? ms : FLEET_SCHED_MAX_SLEEP_MS;
+
+    const uint32_t t0 = fleet_micros();
+    bool woken;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        woken = cv.wait_for(lock, std::chrono::milliseconds(ms), [this] { return pending; });
+        pending = false;
+    }
+
+    stats_.sleeps++;
+    stats_.woken += woken;
+    stats_.slept_us += fleet_micros() - t0;
+    return woken;
+}
+
+void FleetScheduler::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    cv.notify_one();
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_scheduler
+ * Goal:    Replace the fixed `lv_timer_handler(); delay(5);` loop with a
+ * sleep that lasts exactly as long as LVGL says it can, and ends early
+ * when something needs the UI (touch, audio events, an invalidation from
+ * another task).
+ *
+ *     const uint32_t next = lv_timer_handler();
+ *     sched.sleep(next);             // blocks, unless...
+ *     sched.wake();                  // ...any other task calls this
+ *
+ * A wake() that arrives while nobody is sleeping is remembered, so the
+ * next sleep() returns at once. Several wakes before that collapse into
+ * one. On the device this is a binary semaphore (wakeFromISR() for
+ * interrupt handlers). On the host it is a condition variable, so the
+ * timing can be checked on Linux (src/native/bench_scheduler).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Upper bound for one sleep. lv_timer_handler() returns LV_NO_TIMER_READY
+// (0xFFFFFFFF) when nothing is scheduled. Anything polled from the loop
+// (the serial console) is serviced at least this often.
+#ifndef FLEET_SCHED_MAX_SLEEP_MS
+#define FLEET_SCHED_MAX_SLEEP_MS 250
+#endif
+
+struct FleetSchedulerStats
+{
+    uint32_t sleeps;     // sleep() calls
+    uint32_t woken;      // ... that ended early because of wake()
+    uint64_t slept_us;   // time spent blocked in sleep()
+};
+
+class FleetScheduler
+{
+public:
+    bool begin();
+
+    // Block for up to `ms` (clamped to FLEET_SCHED_MAX_SLEEP_MS) or until
+    // wake(). Returns true if woken early.
+    bool sleep(uint32_t ms);
+
+    // Safe from any task/thread
+    void wake();
+#if defined(ARDUINO_ARCH_ESP32)
+    void wakeFromISR();
+#endif
+
+    const FleetSchedulerStats &stats() const { return stats_; }
+    void resetStats() { stats_ = FleetSchedulerStats(); }
+
+private:
+#if defined(ARDUINO_ARCH_ESP32)
+    SemaphoreHandle_t sem = nullptr;
+#else
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool pending = false;
+#endif
+    FleetSchedulerStats stats_ = FleetSchedulerStats();
+};
@@ -0,0 +1,109 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_sim_bus (see fleet_sim_bus.h)
+ */
+
+#include "fleet_sim_bus.h"
+
+uint32_t FleetSimBus::setBusHz(uint32_t new_hz)
+{
+    if (new_hz == 0 || new_hz > m.max_hz)
+    {
+        return 0;
+    }
+    waitIdle();
+    if (m.stuck_above_hz == 0 || new_hz <= m.stuck_above_hz)
+    {
+        hz = new_hz;
+    }
+    return new_hz;
+}
+
+// Bits on the wire, in whole microseconds (rounded up)
+static uint32_t bits_us(uint64_t bits, uint32_t hz, int lanes)
+{
+    const uint64_t per_s = (uint64_t)hz * lanes;
+    return (uint32_t)((bits * 1000000 + per_s - 1) / per_s);
+}
+
+uint32_t FleetSimBus::windowUs() const
+{
+    return m.call_us + bits_us(m.window_bits, hz, 1);
+}
+
+uint32_t FleetSimBus::wireUs(size_t count) const
+{
+    return bits_us((uint64_t)count * 16, hz, m.lanes);
+}
+
+uint32_t FleetSimBus::fillUs() const
+{
+    const size_t n = (size_t)m.width * m.height;
+    const size_t chunks = (n + m.fill_chunk_px - 1) / m.fill_chunk_px;
+    return windowUs() + (uint32_t)chunks * m.call_us + wireUs(n);
+}
+
+void FleetSimBus::waitIdle()
+{
+    if (dma_buf)
+    {
+        if (now_us < dma_done_us)
+        {
+            now_us = dma_done_us;
+        }
+        dma_buf = nullptr;
+    }
+}
+
+void FleetSimBus::fillScreen(uint16_t color)
+{
+    (void)color;
+    waitIdle();
+    now_us += fillUs();
+    fills++;
+    window_left = 0;
+}
+
+void FleetSimBus::setAddrWindow(int x, int y, int w, int h)
+{
+    // The controller latches the window when the command goes out, so it
+    // can't overtake a transfer still running
+    waitIdle();
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > m.width || y + h > m.height)
+    {
+        errors++;
+    }
+    now_us += windowUs();
+    windows++;
+    window_left = (uint64_t)(w > 0 ? w : 0) * (h > 0 ? h : 0);
+}
+
+void FleetSimBus::pushPixels(const uint16_t *px, int count, bool dma)
+{
+    if (px == nullptr || count <= 0 || (uint64_t)count > window_left)
+    {
+        errors++;
+    }
+    if (dma && px == dma_buf && now_us < dma_done_us)
+    {
+        errors++; // refilling the buffer the DMA is still reading
+    }
+    waitIdle();
+    window_left -= (uint64_t)count > window_left ? window_left : (uint64_t)count;
+    pixels += count > 0 ? count : 0;
+    pushes++;
+    if (!dma)
+    {
+        now_us += m.call_us + wireUs(count);
+        return;
+    }
+    dma_pushes++;
+    now_us += m.call_us + m.dma_setup_us;
+    dma_done_us = now_us + wireUs(count);
+    dma_buf = px;
+}
+
+void FleetSimBus::waitDma()
+{
+    waitIdle();
+}
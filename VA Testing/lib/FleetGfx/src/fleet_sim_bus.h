@@ -0,0 +1,92 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_sim_bus
+ * Goal:    A FleetBenchBus for the host: a QSPI panel bus modelled on a
+ * virtual clock, so fleet_panel_bench runs on Linux, deterministically,
+ * and its numbers can be checked against the model.
+ *
+ * Nothing sleeps: every call advances micros() by what the model says it
+ * costs, rounded up to whole microseconds (the device clock's resolution,
+ * and it keeps every interval the benchmark takes exact). Per call:
+ *
+ *     setAddrWindow   call_us + window_bits on one data line
+ *     pushPixels      call_us + the pixels on `lanes` lines (polling)
+ *                     call_us + dma_setup_us, pixels on the wire after
+ *                     that (DMA; the next push or waitDma() waits for it)
+ *     fillScreen      a full-screen window + call_us per fill_chunk_px
+ *                     chunk + the pixels, polling
+ *
+ * It also checks how it is driven, like the panel would: pushes beyond
+ * the window's area, windows off the panel and DMA buffers reused while
+ * in flight are counted in errors. stuck_above_hz plays a re-init that
+ * reports success but leaves the old clock running.
+ *
+ * Why not FleetMockTransport: that one stands in for FleetTransport, the
+ * flush pipeline's asynchronous window/push stream. It has no notion of
+ * time on purpose (completions are stepped by hand) and no fillScreen(),
+ * blocking push or bus clock. The benchmark times exactly those raw
+ * bb_spi_lcd calls, so it needs a bus whose clock moves with the modelled
+ * wire time. Neither interface is a subset of the other.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fleet_panel_bench.h"
+
+struct FleetSimBusModel
+{
+    int width = 320;
+    int height = 480;
+    int lanes = 4;
+    uint32_t max_hz = 80000000;   // setBusHz() above this fails
+    uint32_t call_us = 2;         // driver overhead per call
+    uint32_t dma_setup_us = 6;    // descriptor setup per DMA push
+    uint32_t window_bits = 192;   // CASET + RASET + RAMWR, 1 line
+    uint32_t fill_chunk_px = 4096; // fillScreen()'s internal buffer
+    uint32_t stuck_above_hz = 0;   // setBusHz() above this "succeeds" but
+                                   // keeps the old clock; 0: off
+};
+
+class FleetSimBus : public FleetBenchBus
+{
+public:
+    explicit FleetSimBus(const FleetSimBusModel &model = FleetSimBusModel()) : m(model) {}
+
+    const char *name() const override { return "sim"; }
+    int width() const override { return m.width; }
+    int height() const override { return m.height; }
+    uint32_t setBusHz(uint32_t hz) override;
+    void fillScreen(uint16_t color) override;
+    void setAddrWindow(int x, int y, int w, int h) override;
+    void pushPixels(const uint16_t *px, int count, bool dma) override;
+    void waitDma() override;
+    uint32_t micros() override { return (uint32_t)now_us; }
+
+    // The model's cost of each operation at the current clock, in us
+    uint32_t windowUs() const;
+    uint32_t wireUs(size_t pixels) const;
+    uint32_t fillUs() const;
+
+    const FleetSimBusModel &model() const { return m; }
+    uint32_t busHz() const { return hz; }
+
+    // What the benchmark did to the bus
+    uint32_t fills = 0;
+    uint32_t windows = 0;
+    uint32_t pushes = 0, dma_pushes = 0;
+    uint64_t pixels = 0;
+    uint32_t errors = 0;
+
+private:
+    void waitIdle();
+
+    FleetSimBusModel m;
+    uint32_t hz = 40000000;
+    uint64_t now_us = 0;
+    uint64_t dma_done_us = 0;          // when the DMA in flight finishes
+    const uint16_t *dma_buf = nullptr; // and what it is reading
+    uint64_t window_left = 0;          // pixels the window still takes
+};
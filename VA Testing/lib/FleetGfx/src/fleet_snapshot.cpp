@@ -0,0 +1,89 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_snapshot (see fleet_snapshot.h)
+ */
+
+#include "fleet_snapshot.h"
+
+#include <stdio.h>
+
+void fleet_rgb565_wire_to_rgb888(uint16_t wire, uint8_t rgb[3])
+{
+    // The high byte goes first on the wire, so in memory it's the low byte
+    const uint8_t *b = (const uint8_t *)&wire;
+    const uint16_t c = (uint16_t)((b[0] << 8) | b[1]);
+
+    const uint8_t r5 = (c >> 11) & 0x1F;
+    const uint8_t g6 = (c >> 5) & 0x3F;
+    const uint8_t b5 = c & 0x1F;
+    rgb[0] = (uint8_t)((r5 << 3) | (r5 >> 2));
+    rgb[1] = (uint8_t)((g6 << 2) | (g6 >> 4));
+    rgb[2] = (uint8_t)((b5 << 3) | (b5 >> 2));
+}
+
+bool fleet_snapshot_ppm(const char *path, const uint16_t *wire_px, int width, int height)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == nullptr)
+    {
+        return false;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    uint8_t row[3 * 1024];
+    bool ok = true;
+    for (int y = 0; y < height && ok; y++)
+    {
+        for (int x0 = 0; x0 < width && ok; x0 += 1024)
+        {
+            const int n = (width - x0 < 1024) ? width - x0 : 1024;
+            for (int x = 0; x < n; x++)
+            {
+                fleet_rgb565_wire_to_rgb888(wire_px[y * width + x0 + x], &row[3 * x]);
+            }
+            ok = fwrite(row, 3, n, f) == (size_t)n;
+        }
+    }
+
+    return (fclose(f) == 0) && ok;
+}
+
+int fleet_snapshot_diff_ppm(const char *path, const uint16_t *wire_px, int width, int height)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == nullptr)
+    {
+        return -1;
+    }
+
+    int w = 0, h = 0, maxval = 0;
+    // One whitespace byte separates the header from the pixels
+    if (fscanf(f, "P6 %d %d %d", &w, &h, &maxval) != 3 || fgetc(f) == EOF || w != width || h != height ||
+        maxval != 255)
+    {
+        fclose(f);
+        return -1;
+    }
+    uint8_t row[3 * 1024];
+    int differ = 0;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x0 = 0; x0 < width; x0 += 1024)
+        {
+            const int n = (width - x0 < 1024) ? width - x0 : 1024;
+            if (fread(row, 3, n, f) != (size_t)n)
+            {
+                fclose(f);
+                return -1;
+            }
+            for (int x = 0; x < n; x++)
+            {
+                uint8_t rgb[3];
+                fleet_rgb565_wire_to_rgb888(wire_px[y * width + x0 + x], rgb);
+                differ += rgb[0] != row[3 * x] || rgb[1] != row[3 * x + 1] || rgb[2] != row[3 * x + 2];
+            }
+        }
+    }
+    fclose(f);
+    return differ;
+}
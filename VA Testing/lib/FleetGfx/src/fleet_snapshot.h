@@ -0,0 +1,24 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_snapshot
+ * Goal:    Dump what the panel would show to an image file on the host.
+ *
+ * Input is the panel's wire format (big-endian RGB565, as kept by
+ * FleetFramebufferTransport). Output is binary PPM (P6): no dependencies,
+ * and every image viewer and ImageMagick read it (`convert a.ppm a.png`).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Expand one wire-format pixel to 8-bit R, G, B (low bits replicated)
+void fleet_rgb565_wire_to_rgb888(uint16_t wire, uint8_t rgb[3]);
+
+// Returns false if the file could not be written
+bool fleet_snapshot_ppm(const char *path, const uint16_t *wire_px, int width, int height);
+
+// Compare wire_px with a snapshot written by fleet_snapshot_ppm(): the
+// number of pixels that differ, or -1 if the file can't be read or is
+// another size
+int fleet_snapshot_diff_ppm(const char *path, const uint16_t *wire_px, int width, int height);
@@ -0,0 +1,146 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_swap (see fleet_swap.h)
+ */
+
+#include "fleet_swap.h"
+
+// The pixel buffers are uint16_t; reading them as words must not trip
+// strict aliasing, so every word access goes through this type.
+typedef uint32_t __attribute__((__may_alias__)) fleet_word_t;
+
+static inline uint16_t swap16(uint16_t v)
+{
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+// Swap both 16-bit halves of a word: AABB CCDD -> BBAA DDCC
+static inline uint32_t swap_pair(uint32_t w)
+{
+    return ((w & 0x00FF00FFu) << 8) | ((w >> 8) & 0x00FF00FFu);
+}
+
+void fleet_swap_rgb565_scalar(uint16_t *dst, const uint16_t *src, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        dst[i] = swap16(src[i]);
+    }
+}
+
+void fleet_swap_rgb565_packed32(uint16_t *dst, const uint16_t *src, size_t count)
+{
+    // Word access needs src and dst on the same 4-byte phase. LVGL's draw
+    // buffers and our DMA buffers are always 4-byte aligned, so this only
+    // trips for odd callers.
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 3) != 0)
+    {
+        fleet_swap_rgb565_scalar(dst, src, count);
+        return;
+    }
+
+    // Leading pixel to reach a word boundary
+    if (((uintptr_t)src & 3) != 0 && count > 0)
+    {
+        *dst++ = swap16(*src++);
+        count--;
+    }
+
+    const fleet_word_t *s = (const fleet_word_t *)src;
+    fleet_word_t *d = (fleet_word_t *)dst;
+    size_t words = count / 2;
+
+    // 8 pixels per iteration keeps the Xtensa load/store pipeline busy
+    while (words >= 4)
+    {
+        uint32_t w0 = s[0];
+        uint32_t w1 = s[1];
+        uint32_t w2 = s[2];
+        uint32_t w3 = s[3];
+        d[0] = swap_pair(w0);
+        d[1] = swap_pair(w1);
+        d[2] = swap_pair(w2);
+        d[3] = swap_pair(w3);
+        s += 4;
+        d += 4;
+        words -= 4;
+    }
+    while (words--)
+    {
+        *d++ = swap_pair(*s++);
+    }
+
+    // Trailing odd pixel
+    if (count & 1)
+    {
+        dst[count - 1] = swap16(src[count - 1]);
+    }
+}
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+void fleet_swap_rgb565_pie(uint16_t *dst, const uint16_t *src, size_t count)
+{
+    // EE.VLD/VST.128 silently align the address down to 16 bytes, so both
+    // pointers must share the same 16-byte phase. Otherwise use packed32.
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 15) != 0)
+    {
+        fleet_swap_rgb565_packed32(dst, src, count);
+        return;
+    }
+
+    size_t head = ((16 - ((uintptr_t)src & 15)) & 15) / sizeof(uint16_t);
+    if (head > count)
+    {
+        head = count;
+    }
+    fleet_swap_rgb565_packed32(dst, src, head);
+    src += head;
+    dst += head;
+    count -= head;
+
+    // 16 pixels (two Q registers) per step:
+    //   vunzip.8 splits the 32 bytes into even (low) and odd (high) bytes,
+    //   vzip.8 with the operands reversed interleaves them back odd-first.
+    size_t blocks = count / 16;
+    const uint16_t *s = src;
+    uint16_t *d = dst;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        asm volatile(
+            "ee.vld.128.ip  q0, %0, 16 \n"
+            "ee.vld.128.ip  q1, %0, 16 \n"
+            "ee.vunzip.8    q0, q1     \n"
+            "ee.vzip.8      q1, q0     \n"
+            "ee.vst.128.ip  q1, %1, 16 \n"
+            "ee.vst.128.ip  q0, %1, 16 \n"
+            : "+r"(s), "+r"(d)
+            :
+            : "memory");
+    }
+
+    size_t done = blocks * 16;
+    fleet_swap_rgb565_packed32(dst + done, src + done, count - done);
+}
+#endif
+
+void fleet_swap_rgb565(uint16_t *dst, const uint16_t *src, size_t count)
+{
+#if FLEET_SWAP_IMPL == FLEET_SWAP_IMPL_PIE
+    fleet_swap_rgb565_pie(dst, src, count);
+#elif FLEET_SWAP_IMPL == FLEET_SWAP_IMPL_PACKED32
+    fleet_swap_rgb565_packed32(dst, src, count);
+#else
+    fleet_swap_rgb565_scalar(dst, src, count);
+#endif
+}
+
+const char *fleet_swap_impl_name(void)
+{
+#if FLEET_SWAP_IMPL == FLEET_SWAP_IMPL_PIE
+    return "pie";
+#elif FLEET_SWAP_IMPL == FLEET_SWAP_IMPL_PACKED32
+    return "packed32";
+#else
+    return "scalar";
+#endif
+}
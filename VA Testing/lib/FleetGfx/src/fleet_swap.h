@@ -0,0 +1,55 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_swap
+ * Goal:    RGB565 byte-swap kernels for the panels' big-endian wire format.
+ *
+ * LVGL renders little-endian RGB565, the AXS15231B wants the high byte
+ * first on the wire. These kernels do that conversion for a run of pixels.
+ *
+ * - fleet_swap_rgb565_scalar()   portable reference, one pixel at a time
+ * - fleet_swap_rgb565_packed32() two pixels per 32-bit word
+ * - fleet_swap_rgb565_pie()      ESP32-S3 PIE (128-bit SIMD), 16 pixels per step
+ *
+ * fleet_swap_rgb565() is the one the flush path calls. Which kernel it uses
+ * is picked at compile time with FLEET_SWAP_IMPL (defaults: PIE on the S3,
+ * packed32 everywhere else). All kernels allow dst == src (in-place).
+ *
+ * This file must stay free of Arduino/LVGL includes so it builds on the host.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM)
+#include <sdkconfig.h>
+#endif
+
+#define FLEET_SWAP_IMPL_SCALAR 0
+#define FLEET_SWAP_IMPL_PACKED32 1
+#define FLEET_SWAP_IMPL_PIE 2
+
+#ifndef FLEET_SWAP_IMPL
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define FLEET_SWAP_IMPL FLEET_SWAP_IMPL_PIE
+#else
+#define FLEET_SWAP_IMPL FLEET_SWAP_IMPL_PACKED32
+#endif
+#endif
+
+#if FLEET_SWAP_IMPL == FLEET_SWAP_IMPL_PIE && !defined(CONFIG_IDF_TARGET_ESP32S3)
+#error "FLEET_SWAP_IMPL_PIE needs an ESP32-S3 target"
+#endif
+
+void fleet_swap_rgb565_scalar(uint16_t *dst, const uint16_t *src, size_t count);
+void fleet_swap_rgb565_packed32(uint16_t *dst, const uint16_t *src, size_t count);
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+void fleet_swap_rgb565_pie(uint16_t *dst, const uint16_t *src, size_t count);
+#endif
+
+// Swap `count` pixels from src into dst using the compile-time kernel
+void fleet_swap_rgb565(uint16_t *dst, const uint16_t *src, size_t count);
+
+// Name of the kernel behind fleet_swap_rgb565(), for boot logs
+const char *fleet_swap_impl_name(void);
@@ -0,0 +1,228 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_te (see fleet_te.h)
+ */
+
+#include "fleet_te.h"
+#include "fleet_port.h"
+
+// Called from the GPIO interrupt on the device, so no locks. The count
+// goes up last: a waiter that sees the new count also sees its stamp.
+#if defined(ARDUINO_ARCH_ESP32)
+IRAM_ATTR
+#endif
+void FleetTe::pulse(uint32_t now_us)
+{
+    if (count.load() > 0)
+    {
+        const uint32_t dt = now_us - last_us.load();
+        const uint32_t p = period_us.load();
+        period_us = p ? (p * 7 + dt) / 8 : dt;
+    }
+    last_us = now_us;
+    count++;
+}
+
+void FleetTe::resetStats()
+{
+    stats_ = FleetTeStats();
+    lag_us.reset();
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <Arduino.h>
+#include <esp_random.h>
+
+bool FleetTe::beginSignal()
+{
+    if (sem == nullptr)
+    {
+        sem = xSemaphoreCreateBinary();
+    }
+    return sem != nullptr;
+}
+
+void IRAM_ATTR FleetTe::gpioIsr(void *arg)
+{
+    FleetTe *self = (FleetTe *)arg;
+    self->pulse((uint32_t)esp_timer_get_time());
+
+    BaseType_t higher_prio_woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->sem, &higher_prio_woken);
+    portYIELD_FROM_ISR(higher_prio_woken);
+}
+
+bool FleetTe::beginGpio(int pin)
+{
+    end();
+    if (pin < 0 || !beginSignal())
+    {
+        return false;
+    }
+    gpio = pin;
+    pinMode(pin, INPUT);
+    attachInterruptArg(pin, gpioIsr, this, RISING);
+    return true;
+}
+
+// One-shot timer, re-armed around an undisturbed schedule so the jitter
+// doesn't accumulate into drift
+void FleetTe::timerCb(void *arg)
+{
+    FleetTe *self = (FleetTe *)arg;
+    self->pulse((uint32_t)esp_timer_get_time());
+    xSemaphoreGive(self->sem);
+
+    self->sim_next_us += self->sim_period_us;
+    int64_t at = self->sim_next_us;
+    if (self->sim_jitter_us > 0)
+    {
+        at += (int64_t)(esp_random() % (2 * self->sim_jitter_us + 1)) - self->sim_jitter_us;
+    }
+    const int64_t now = esp_timer_get_time();
+    esp_timer_start_once(self->timer, at > now ? at - now : 0);
+}
+
+bool FleetTe::beginSimulated(uint32_t period, uint32_t jitter)
+{
+    end();
+    if (period == 0 || !beginSignal())
+    {
+        return false;
+    }
+    sim_period_us = period;
+    sim_jitter_us = jitter < period / 2 ? jitter : period / 2;
+
+    esp_timer_create_args_t args = {};
+    args.callback = timerCb;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "fleet_te_sim";
+    if (esp_timer_create(&args, &timer) != ESP_OK)
+    {
+        timer = nullptr;
+        return false;
+    }
+    sim_next_us = esp_timer_get_time() + period;
+    return esp_timer_start_once(timer, period) == ESP_OK;
+}
+
+void FleetTe::end()
+{
+    if (gpio >= 0)
+    {
+        detachInterrupt(gpio);
+        gpio = -1;
+    }
+    if (timer != nullptr)
+    {
+        esp_timer_stop(timer);
+        esp_timer_delete(timer);
+        timer = nullptr;
+    }
+}
+
+bool FleetTe::waitPulse(uint32_t target, uint32_t timeout_ms)
+{
+    const uint32_t t0 = fleet_micros();
+    bool ok = true;
+    // The semaphore may hold a give from an older pulse; the count decides
+    while ((int32_t)(count.load() - target) < 0)
+    {
+        const uint32_t elapsed_ms = (fleet_micros() - t0) / 1000;
+        if (elapsed_ms >= timeout_ms)
+        {
+            ok = false;
+            break;
+        }
+        const TickType_t ticks = ((timeout_ms - elapsed_ms) * configTICK_RATE_HZ + 999) / 1000;
+        xSemaphoreTake(sem, ticks);
+    }
+
+    const uint32_t now = fleet_micros();
+    stats_.waits++;
+    stats_.timeouts += !ok;
+    stats_.waited_us += now - t0;
+    if (ok)
+    {
+        lag_us.record(now - last_us.load());
+    }
+    return ok;
+}
+
+#else // Host
+
+#include <chrono>
+#include <random>
+
+bool FleetTe::beginSignal()
+{
+    return true;
+}
+
+void FleetTe::simMain(uint32_t period, uint32_t jitter)
+{
+    std::minstd_rand rng(12345);
+    auto next = std::chrono::steady_clock::now();
+    while (sim_running.load())
+    {
+        next += std::chrono::microseconds(period);
+        auto at = next;
+        if (jitter > 0)
+        {
+            at += std::chrono::microseconds((int32_t)(rng() % (2 * jitter + 1)) - (int32_t)jitter);
+        }
+        std::this_thread::sleep_until(at);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pulse(fleet_micros());
+        }
+        cv.notify_all();
+    }
+}
+
+bool FleetTe::beginSimulated(uint32_t period, uint32_t jitter)
+{
+    end();
+    if (period == 0)
+    {
+        return false;
+    }
+    jitter = jitter < period / 2 ? jitter : period / 2;
+    sim_running = true;
+    sim = std::thread(&FleetTe::simMain, this, period, jitter);
+    return true;
+}
+
+void FleetTe::end()
+{
+    sim_running = false;
+    if (sim.joinable())
+    {
+        sim.join();
+    }
+}
+
+bool FleetTe::waitPulse(uint32_t target, uint32_t timeout_ms)
+{
+    const uint32_t t0 = fleet_micros();
+    bool ok;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ok = cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                         [&] { return (int32_t)(count.load() - target) >= 0; });
+    }
+
+    const uint32_t now = fleet_micros();
+    stats_.waits++;
+    stats_.timeouts += !ok;
+    stats_.waited_us += now - t0;
+    if (ok)
+    {
+        lag_us.record(now - last_us.load());
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_te
+ * Goal:    Track the panel's tearing-effect (TE) signal, so flushes can
+ * start in vertical blanking and the render loop can run at the panel's
+ * refresh rate.
+ *
+ * The controller pulses TE once per scan-out, at the start of vertical
+ * blanking. If the write starts right then and the bus beats the scan,
+ * the panel never shows half of one frame and half of the next.
+ *
+ *     FleetTe te;
+ *     te.beginGpio(FLEET_TE_PIN);        // the real pin (ESP32)
+ *     te.beginSimulated(16667, 200);     // or a timer: 60 Hz, +-200 us
+ *
+ *     te.waitPulse(te.pulses() + 1, 50); // block until the next blanking
+ *
+ * Pulses are counted, so "the N-th pulse from now" is easy to wait for
+ * and a pulse that fires before the wait starts is not lost. The
+ * simulated source runs on the host too (src/native/bench_te), so the
+ * pacing in FleetDisplay can be tested without a panel.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "fleet_metrics.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// GPIO wired to the panel's TE output, -1 if there is none
+#ifndef FLEET_TE_PIN
+#define FLEET_TE_PIN -1
+#endif
+
+// Longest wait for one pulse before flushing anyway (TE not wired, panel
+// asleep)
+#ifndef FLEET_TE_TIMEOUT_MS
+#define FLEET_TE_TIMEOUT_MS 50
+#endif
+
+// How long after a pulse a write may still start and count as "in the
+// blanking". A caller that arrives later waits for the next pulse.
+#ifndef FLEET_TE_BLANKING_US
+#define FLEET_TE_BLANKING_US 1000
+#endif
+
+struct FleetTeStats
+{
+    uint32_t waits;    // waitPulse() calls
+    uint32_t timeouts; // ... that gave up
+    uint64_t waited_us; // time spent blocked in waitPulse()
+};
+
+class FleetTe
+{
+public:
+    ~FleetTe() { end(); }
+
+#if defined(ARDUINO_ARCH_ESP32)
+    // Count rising edges on `pin`
+    bool beginGpio(int pin);
+#endif
+    // Pulse every `period_us`, each one early or late by up to `jitter_us`
+    bool beginSimulated(uint32_t period_us, uint32_t jitter_us = 0);
+    void end();
+
+    // Pulses so far, and when the latest one came (fleet_micros())
+    uint32_t pulses() const { return count.load(); }
+    uint32_t lastPulseUs() const { return last_us.load(); }
+
+    // Measured time between pulses, smoothed; 0 until two have arrived
+    uint32_t periodUs() const { return period_us.load(); }
+
+    // Block until pulses() reaches `target` or `timeout_ms` passes.
+    // Returns false on timeout.
+    bool waitPulse(uint32_t target, uint32_t timeout_ms);
+
+    const FleetTeStats &stats() const { return stats_; }
+    // Pulse -> return from a successful waitPulse(), i.e. how far into the
+    // blanking the caller gets to start
+    const FleetHistogram &lag() const { return lag_us; }
+    void resetStats();
+
+private:
+    bool beginSignal();
+    void pulse(uint32_t now_us); // count and time it (the caller wakes the waiter)
+
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> last_us{0};
+    std::atomic<uint32_t> period_us{0};
+    FleetTeStats stats_ = FleetTeStats();
+    FleetHistogram lag_us;
+
+#if defined(ARDUINO_ARCH_ESP32)
+    static void IRAM_ATTR gpioIsr(void *arg);
+    static void timerCb(void *arg);
+    SemaphoreHandle_t sem = nullptr;
+    int gpio = -1;
+    esp_timer_handle_t timer = nullptr;
+    uint32_t sim_period_us = 0;
+    uint32_t sim_jitter_us = 0;
+    int64_t sim_next_us = 0; // undisturbed time of the next pulse
+#else
+    void simMain(uint32_t period, uint32_t jitter);
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread sim;
+    std::atomic<bool> sim_running{false};
+#endif
+};
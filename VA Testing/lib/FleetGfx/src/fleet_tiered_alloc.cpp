@@ -0,0 +1,396 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_tiered_alloc (see fleet_tiered_alloc.h)
+ */
+
+#include "fleet_tiered_alloc.h"
+#include "fleet_port.h"
+
+#include <string.h>
+
+FleetTieredAlloc fleet_lv_alloc;
+
+// In front of every block, so release() knows the tier and the size
+struct alignas(8) FleetAllocHeader
+{
+    uint32_t size; // whole block, header included
+    uint16_t tier;
+    uint16_t magic;
+};
+
+static const uint16_t HEADER_MAGIC = 0xA11C;
+
+static const char *const tier_names[FLEET_TIER_COUNT] = {"internal", "psram"};
+
+static size_t block_total(size_t size)
+{
+    return (size + sizeof(FleetAllocHeader) + 7) & ~(size_t)7;
+}
+
+static FleetAllocHeader *header_of(const void *ptr)
+{
+    return (FleetAllocHeader *)ptr - 1;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <esp_heap_caps.h>
+
+#define TIER_LOCK() portENTER_CRITICAL(&mux)
+#define TIER_UNLOCK() portEXIT_CRITICAL(&mux)
+
+static uint32_t tier_caps(FleetTier tier)
+{
+    return tier == FLEET_TIER_PSRAM ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+}
+
+bool FleetTieredAlloc::begin(const FleetTieredConfig &config)
+{
+    cfg = config;
+    memset(st, 0, sizeof(st));
+    if (cfg.psram_max && !heap_caps_get_total_size(MALLOC_CAP_SPIRAM))
+    {
+        // No PSRAM on this module: everything goes internal
+        cfg.psram_max = 0;
+        cfg.small_max = SIZE_MAX;
+    }
+    return true;
+}
+
+void FleetTieredAlloc::end()
+{
+}
+
+// Outside the lock: heap_caps takes the heap's own lock
+bool FleetTieredAlloc::heapAllows(FleetTier tier, size_t total) const
+{
+    return tier == FLEET_TIER_PSRAM || heap_caps_get_free_size(tier_caps(tier)) >= total + cfg.internal_reserve;
+}
+
+void *FleetTieredAlloc::allocFrom(FleetTier tier, size_t total)
+{
+    return heap_caps_malloc(total, tier_caps(tier));
+}
+
+void FleetTieredAlloc::freeTo(FleetTier, void *block, size_t)
+{
+    heap_caps_free(block);
+}
+
+FleetTierStats FleetTieredAlloc::stats(FleetTier tier) const
+{
+    TIER_LOCK();
+    FleetTierStats s = st[tier];
+    TIER_UNLOCK();
+    s.free_bytes = heap_caps_get_free_size(tier_caps(tier));
+    s.largest_free = heap_caps_get_largest_free_block(tier_caps(tier));
+    return s;
+}
+
+#else // Host: one first-fit arena per tier, sized to the tier's cap
+
+#include <iterator>
+#include <map>
+#include <stdlib.h>
+
+#define TIER_LOCK() mutex.lock()
+#define TIER_UNLOCK() mutex.unlock()
+
+struct FleetTieredAlloc::Arena
+{
+    uint8_t *base;
+    size_t size;
+    std::map<size_t, size_t> free_list; // offset -> length, never adjacent
+
+    void *take(size_t len)
+    {
+        for (auto it = free_list.begin(); it != free_list.end(); ++it)
+        {
+            if (it->second < len)
+            {
+                continue;
+            }
+            const size_t off = it->first;
+            const size_t rest = it->second - len;
+            free_list.erase(it);
+            if (rest)
+            {
+                free_list[off + len] = rest;
+            }
+            return base + off;
+        }
+        return nullptr;
+    }
+
+    void give(void *block, size_t len)
+    {
+        size_t off = (uint8_t *)block - base;
+        auto next = free_list.lower_bound(off);
+        if (next != free_list.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == off)
+            {
+                off = prev->first;
+                len += prev->second;
+                free_list.erase(prev);
+            }
+        }
+        if (next != free_list.end() && off + len == next->first)
+        {
+            len += next->second;
+            free_list.erase(next);
+        }
+        free_list[off] = len;
+    }
+
+    size_t freeBytes() const
+    {
+        size_t total = 0;
+        for (const auto &f : free_list)
+        {
+            total += f.second;
+        }
+        return total;
+    }
+
+    size_t largestFree() const
+    {
+        size_t best = 0;
+        for (const auto &f : free_list)
+        {
+            best = f.second > best ? f.second : best;
+        }
+        return best;
+    }
+};
+
+bool FleetTieredAlloc::begin(const FleetTieredConfig &config)
+{
+    end();
+    cfg = config;
+    memset(st, 0, sizeof(st));
+    const size_t caps[FLEET_TIER_COUNT] = {cfg.internal_max, cfg.psram_max};
+    for (int t = 0; t < FLEET_TIER_COUNT; t++)
+    {
+        arenas[t] = new Arena();
+        arenas[t]->size = caps[t] & ~(size_t)7;
+        arenas[t]->base = arenas[t]->size ? (uint8_t *)malloc(arenas[t]->size) : nullptr;
+        if (arenas[t]->size && !arenas[t]->base)
+        {
+            end();
+            return false;
+        }
+        if (arenas[t]->size)
+        {
+            arenas[t]->free_list[0] = arenas[t]->size;
+        }
+    }
+    return true;
+}
+
+void FleetTieredAlloc::end()
+{
+    for (int t = 0; t < FLEET_TIER_COUNT; t++)
+    {
+        if (arenas[t])
+        {
+            free(arenas[t]->base);
+            delete arenas[t];
+            arenas[t] = nullptr;
+        }
+    }
+}
+
+// The arena is the tier's cap; nothing else to leave free
+bool FleetTieredAlloc::heapAllows(FleetTier tier, size_t) const
+{
+    return arenas[tier] != nullptr;
+}
+
+void *FleetTieredAlloc::allocFrom(FleetTier tier, size_t total)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return arenas[tier]->take(total);
+}
+
+void FleetTieredAlloc::freeTo(FleetTier tier, void *block, size_t total)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (arenas[tier])
+    {
+        arenas[tier]->give(block, total);
+    }
+}
+
+FleetTierStats FleetTieredAlloc::stats(FleetTier tier) const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    FleetTierStats s = st[tier];
+    s.free_bytes = arenas[tier] ? arenas[tier]->freeBytes() : 0;
+    s.largest_free = arenas[tier] ? arenas[tier]->largestFree() : 0;
+    return s;
+}
+
+#endif
+
+// Reserve `total` bytes of the tier's cap under the lock (check and add
+// in one step, so two tasks can't both take the last of it), then
+// allocate outside it; hand the reservation back if that fails. The peak
+// is taken with the reservation, so it is never below what was in use.
+void *FleetTieredAlloc::allocTier(FleetTier tier, size_t total)
+{
+    const size_t cap = tier == FLEET_TIER_PSRAM ? cfg.psram_max : cfg.internal_max;
+    TIER_LOCK();
+    FleetTierStats &s = st[tier];
+    const bool reserved = s.used + total <= cap;
+    if (reserved)
+    {
+        s.used += total;
+        s.peak = s.used > s.peak ? s.used : s.peak;
+    }
+    TIER_UNLOCK();
+    if (!reserved)
+    {
+        return nullptr;
+    }
+
+    void *block = heapAllows(tier, total) ? allocFrom(tier, total) : nullptr;
+    if (!block)
+    {
+        TIER_LOCK();
+        st[tier].used -= total;
+        TIER_UNLOCK();
+    }
+    return block;
+}
+
+void *FleetTieredAlloc::allocate(size_t size)
+{
+    const size_t total = block_total(size);
+    const FleetTier want = size <= cfg.small_max ? FLEET_TIER_INTERNAL : FLEET_TIER_PSRAM;
+    FleetTier got = want;
+    void *block = allocTier(want, total);
+    if (!block)
+    {
+        got = want == FLEET_TIER_INTERNAL ? FLEET_TIER_PSRAM : FLEET_TIER_INTERNAL;
+        block = allocTier(got, total);
+    }
+
+    TIER_LOCK();
+    if (!block)
+    {
+        st[want].failures++;
+    }
+    else
+    {
+        FleetTierStats &s = st[got];
+        s.blocks++;
+        s.allocs++;
+        s.spills += got != want;
+    }
+    TIER_UNLOCK();
+
+    if (!block)
+    {
+#if FLEET_ALLOC_TRACE
+        fleet_log("alloc: a 0 %u", (unsigned)size);
+#endif
+        return nullptr;
+    }
+    FleetAllocHeader *h = (FleetAllocHeader *)block;
+    h->size = (uint32_t)total;
+    h->tier = (uint16_t)got;
+    h->magic = HEADER_MAGIC;
+#if FLEET_ALLOC_TRACE
+    fleet_log("alloc: a %p %u", (void *)(h + 1), (unsigned)size);
+#endif
+    return h + 1;
+}
+
+void FleetTieredAlloc::release(void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    FleetAllocHeader *h = header_of(ptr);
+    if (h->magic != HEADER_MAGIC || h->tier >= FLEET_TIER_COUNT)
+    {
+        fleet_log("alloc: bad free %p", ptr);
+        return;
+    }
+#if FLEET_ALLOC_TRACE
+    fleet_log("alloc: f %p", ptr);
+#endif
+    const FleetTier tier = (FleetTier)h->tier;
+    const size_t total = h->size;
+    h->magic = 0;
+
+    TIER_LOCK();
+    st[tier].used -= total;
+    st[tier].blocks--;
+    TIER_UNLOCK();
+
+    freeTo(tier, h, total);
+}
+
+void *FleetTieredAlloc::reallocate(void *ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return allocate(size);
+    }
+    const size_t old_size = blockSize(ptr);
+    // Shrinking by less than half: keep the block, as lv_realloc callers
+    // (label text, arrays) tend to grow right back
+    if (size <= old_size && size >= old_size / 2)
+    {
+#if FLEET_ALLOC_TRACE
+        fleet_log("alloc: r %p %p %u", ptr, ptr, (unsigned)size);
+#endif
+        return ptr;
+    }
+    void *p = allocate(size);
+    if (!p)
+    {
+        return nullptr;
+    }
+    memcpy(p, ptr, size < old_size ? size : old_size);
+    release(ptr);
+    return p;
+}
+
+size_t FleetTieredAlloc::blockSize(const void *ptr)
+{
+    return ptr ? header_of(ptr)->size - sizeof(FleetAllocHeader) : 0;
+}
+
+unsigned FleetTieredAlloc::fragmentation(FleetTier tier) const
+{
+    const FleetTierStats s = stats(tier);
+    return s.free_bytes ? (unsigned)(100 - (uint64_t)s.largest_free * 100 / s.free_bytes) : 0;
+}
+
+void FleetTieredAlloc::resetPeaks()
+{
+    TIER_LOCK();
+    for (int t = 0; t < FLEET_TIER_COUNT; t++)
+    {
+        st[t].peak = st[t].used;
+        st[t].allocs = st[t].spills = st[t].failures = 0;
+    }
+    TIER_UNLOCK();
+}
+
+void FleetTieredAlloc::dump() const
+{
+    for (int t = 0; t < FLEET_TIER_COUNT; t++)
+    {
+        const FleetTierStats s = stats((FleetTier)t);
+        fleet_log("alloc: %-8s used %u peak %u blocks %u allocs %u spills %u fails %u free %u largest %u frag %u%%",
+                  tier_names[t], (unsigned)s.used, (unsigned)s.peak, (unsigned)s.blocks, (unsigned)s.allocs,
+                  (unsigned)s.spills, (unsigned)s.failures, (unsigned)s.free_bytes, (unsigned)s.largest_free,
+                  fragmentation((FleetTier)t));
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_tiered_alloc
+ * Goal:    LVGL's heap, split by size: small, hot objects (widgets,
+ * styles, short strings) in internal SRAM, big buffers (layers, decoded
+ * images, long transcripts) in PSRAM.
+ *
+ * This replaces LVGL's fixed 64 KB builtin pool (lv_conf.h switches to
+ * LV_STDLIB_CUSTOM, lib/FleetDisplay/src/fleet_lv_mem.cpp forwards to
+ * fleet_lv_alloc):
+ *
+ *   - size <= small_max      -> internal, while LVGL's internal use stays
+ *                               under internal_max and the system keeps
+ *                               internal_reserve free; otherwise PSRAM
+ *   - size >  small_max      -> PSRAM; internal if PSRAM is full
+ *
+ * Each tier tracks bytes in use, peak and live blocks. It also counts
+ * "spills", allocations that had to go to the other tier. Fragmentation
+ * is 100 - largest free block / free bytes, in percent. On the device
+ * that comes from heap_caps; on the host each tier is a fixed-size
+ * first-fit arena, so the device's limits can be replayed
+ * (src/native/stress_tiered_alloc).
+ *
+ * With -D FLEET_ALLOC_TRACE=1 every call is logged as one line:
+ *
+ *     alloc: a <ptr> <size>        allocate (ptr 0: failed)
+ *     alloc: f <ptr>               release
+ *     alloc: r <ptr> <ptr> <size>  reallocate kept the block in place
+ *
+ * (a reallocate that moves logs as an a + f pair), which the host stress
+ * test replays.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#else
+#include <mutex>
+#endif
+
+#ifndef FLEET_ALLOC_SMALL_MAX
+#define FLEET_ALLOC_SMALL_MAX 512
+#endif
+#ifndef FLEET_ALLOC_INTERNAL_MAX
+#define FLEET_ALLOC_INTERNAL_MAX (96 * 1024)
+#endif
+#ifndef FLEET_ALLOC_INTERNAL_RESERVE
+#define FLEET_ALLOC_INTERNAL_RESERVE (48 * 1024)
+#endif
+#ifndef FLEET_ALLOC_PSRAM_MAX
+#define FLEET_ALLOC_PSRAM_MAX (4 * 1024 * 1024)
+#endif
+#ifndef FLEET_ALLOC_TRACE
+#define FLEET_ALLOC_TRACE 0
+#endif
+
+enum FleetTier
+{
+    FLEET_TIER_INTERNAL,
+    FLEET_TIER_PSRAM,
+    FLEET_TIER_COUNT,
+};
+
+struct FleetTieredConfig
+{
+    size_t small_max = FLEET_ALLOC_SMALL_MAX;           // largest "small" allocation
+    size_t internal_max = FLEET_ALLOC_INTERNAL_MAX;     // cap on our internal use
+    size_t internal_reserve = FLEET_ALLOC_INTERNAL_RESERVE; // device: internal heap left for others
+    size_t psram_max = FLEET_ALLOC_PSRAM_MAX;           // cap on our PSRAM use; 0: no PSRAM tier
+};
+
+struct FleetTierStats
+{
+    size_t used;         // bytes handed out (headers included)
+    size_t peak;         // highest `used` since begin()/resetPeaks()
+    uint32_t blocks;     // live allocations
+    uint32_t allocs;     // allocations served, running total
+    uint32_t spills;     // ... that wanted the other tier
+    uint32_t failures;   // requests for this tier that neither tier could serve
+    size_t free_bytes;   // free in the tier's heap (arena on the host)
+    size_t largest_free; // largest free block in it
+};
+
+class FleetTieredAlloc
+{
+public:
+    bool begin(const FleetTieredConfig &cfg = FleetTieredConfig());
+    void end();
+
+    void *allocate(size_t size);
+    void *reallocate(void *ptr, size_t size);
+    void release(void *ptr);
+
+    // Usable size of a block from allocate(), 0 for nullptr
+    static size_t blockSize(const void *ptr);
+
+    FleetTierStats stats(FleetTier tier) const;
+    unsigned fragmentation(FleetTier tier) const; // percent
+    void resetPeaks();
+
+    // One line per tier via fleet_log()
+    void dump() const;
+
+    const FleetTieredConfig &config() const { return cfg; }
+
+private:
+    void *allocTier(FleetTier tier, size_t total);
+    void *allocFrom(FleetTier tier, size_t total);
+    void freeTo(FleetTier tier, void *block, size_t total);
+    bool heapAllows(FleetTier tier, size_t total) const;
+
+    FleetTieredConfig cfg;
+    FleetTierStats st[FLEET_TIER_COUNT] = {};
+#if defined(ARDUINO_ARCH_ESP32)
+    mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#else
+    struct Arena;
+    Arena *arenas[FLEET_TIER_COUNT] = {};
+    mutable std::mutex mutex;
+#endif
+};
+
+// The instance behind LVGL's lv_malloc() (see fleet_lv_mem.cpp)
+extern FleetTieredAlloc fleet_lv_alloc;
@@ -0,0 +1,169 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_trace (see fleet_trace.h)
+ */
+
+#include "fleet_trace.h"
+#include "fleet_port.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+uint64_t fleet_trace_ticks(void)
+{
+    return (uint64_t)esp_timer_get_time();
+}
+
+int fleet_trace_tid(void)
+{
+    return (int)((uintptr_t)xTaskGetCurrentTaskHandle() & 0xffff);
+}
+
+int fleet_trace_cpu(void)
+{
+    return (int)xPortGetCoreID();
+}
+
+#if FLEET_PROFILE
+static const char *thread_name(void)
+{
+    return pcTaskGetName(nullptr);
+}
+
+static portMUX_TYPE trace_lock = portMUX_INITIALIZER_UNLOCKED;
+#define TRACE_LOCK() portENTER_CRITICAL(&trace_lock)
+#define TRACE_UNLOCK() portEXIT_CRITICAL(&trace_lock)
+#endif
+
+#else // Host
+
+#include <chrono>
+#include <mutex>
+#include <pthread.h>
+
+uint64_t fleet_trace_ticks(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int fleet_trace_tid(void)
+{
+    return (int)((uintptr_t)pthread_self() & 0xffff);
+}
+
+int fleet_trace_cpu(void)
+{
+    return 0;
+}
+
+#if FLEET_PROFILE
+static const char *thread_name(void)
+{
+    return "host";
+}
+
+static std::mutex trace_lock;
+#define TRACE_LOCK() trace_lock.lock()
+#define TRACE_UNLOCK() trace_lock.unlock()
+#endif
+
+#endif
+
+#if FLEET_PROFILE
+
+struct TraceEvent
+{
+    uint64_t ts;
+    const char *name;
+    const char *thread;
+    uint16_t tid;
+    uint8_t cpu;
+    char phase;
+};
+
+static TraceEvent events[FLEET_TRACE_EVENTS];
+static uint32_t event_count = 0;
+static uint32_t dropped = 0;
+
+void fleet_trace_event(const char *name, char phase)
+{
+    const uint64_t ts = fleet_trace_ticks();
+    const char *thread = thread_name();
+    const uint16_t tid = (uint16_t)fleet_trace_tid();
+    const uint8_t cpu = (uint8_t)fleet_trace_cpu();
+
+    TRACE_LOCK();
+    if (event_count < FLEET_TRACE_EVENTS)
+    {
+        events[event_count++] = {ts, name, thread, tid, cpu, phase};
+    }
+    else
+    {
+        dropped++;
+    }
+    TRACE_UNLOCK();
+}
+
+void fleet_trace_flush(void)
+{
+    // Print in small batches so writers only ever wait for a copy
+    static TraceEvent batch[32];
+    uint32_t printed = 0;
+    uint32_t lost = 0;
+    for (;;)
+    {
+        uint32_t n = 0;
+        TRACE_LOCK();
+        if (printed < event_count)
+        {
+            n = event_count - printed;
+            n = n < 32 ? n : 32;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                batch[i] = events[printed + i];
+            }
+        }
+        else
+        {
+            // Everything printed: clear under the same lock, so an event
+            // written since the last batch can't be thrown away unseen
+            lost = dropped;
+            event_count = 0;
+            dropped = 0;
+        }
+        TRACE_UNLOCK();
+        if (n == 0)
+        {
+            break;
+        }
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            const TraceEvent &ev = batch[i];
+            fleet_log("%s-%u [%u] %u.%06u: tracing_mark_write: %c|1|%s", ev.thread, (unsigned)ev.tid,
+                      (unsigned)ev.cpu, (unsigned)(ev.ts / 1000000), (unsigned)(ev.ts % 1000000), ev.phase, ev.name);
+        }
+        printed += n;
+    }
+    fleet_log("fleet_trace: %u events, %u dropped", (unsigned)printed, (unsigned)lost);
+}
+
+#else
+
+void fleet_trace_event(const char *name, char phase)
+{
+    (void)name;
+    (void)phase;
+}
+
+void fleet_trace_flush(void)
+{
+    fleet_log("fleet_trace: not compiled in (build with -D FLEET_PROFILE=1)");
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_trace
+ * Goal:    Begin/end trace points for our own flush and DMA code, in the
+ * same text format as LVGL's built-in profiler, so one host script
+ * (tools/fleet_trace_to_chrome.py) turns both into a Chrome/Perfetto trace.
+ *
+ * Only compiled in with -D FLEET_PROFILE=1 (the *_profile envs, which
+ * also turn on LV_USE_PROFILER in lv_conf.h). Otherwise the macros are
+ * empty.
+ *
+ * LVGL's profiler is not safe to call from the DMA worker task, so our
+ * events go into a separate fixed-size buffer that any task may write to.
+ * Both use fleet_trace_ticks() as the clock and fleet_trace_tid() as the
+ * track, so the events line up. The buffer doesn't wrap: it keeps the
+ * first FLEET_TRACE_EVENTS events after a flush, and once it is full new
+ * events are dropped (and counted) rather than stalling the DMA path. A
+ * wrapping ring would overwrite B events whose E is still to come.
+ *
+ * Output lines look like:
+ *     fleet_dma-3048 [0] 12.345678: tracing_mark_write: B|1|dma_push
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef FLEET_PROFILE
+#define FLEET_PROFILE 0
+#endif
+
+// Event buffer size in events (24 bytes each)
+#ifndef FLEET_TRACE_EVENTS
+#define FLEET_TRACE_EVENTS 1024
+#endif
+
+#if FLEET_PROFILE
+#define FLEET_TRACE_BEGIN(name) fleet_trace_event(name, 'B')
+#define FLEET_TRACE_END(name) fleet_trace_event(name, 'E')
+#else
+#define FLEET_TRACE_BEGIN(name) do { } while (0)
+#define FLEET_TRACE_END(name) do { } while (0)
+#endif
+
+// Microseconds, 64 bit (fleet_micros() wraps after ~71 minutes)
+uint64_t fleet_trace_ticks(void);
+
+// Track id and core of the calling task/thread
+int fleet_trace_tid(void);
+int fleet_trace_cpu(void);
+
+// `name` must be a string literal (only the pointer is stored)
+void fleet_trace_event(const char *name, char phase);
+
+// Print and clear the event buffer via fleet_log()
+void fleet_trace_flush(void);
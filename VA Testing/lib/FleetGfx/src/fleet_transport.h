@@ -0,0 +1,64 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_transport
+ * Goal:    The one interface between the flush logic and "the wire".
+ *
+ * A transport takes an ordered stream of window changes and pixel pushes
+ * and executes them asynchronously. Every push carries a small tag that is
+ * handed back, in submission order, to the done callback once the pixels
+ * have left the buffer. That callback is the "DMA done" event the flush
+ * pipeline runs on.
+ *
+ * Implementations:
+ * - FleetBbSpiTransport  bb_spi_lcd + a FreeRTOS DMA worker (ESP32 only)
+ * - FleetMockTransport   records everything, completes on demand (host)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Push tags, OR'ed together
+#define FLEET_TAG_LAST 0x01   // final push of the current area
+#define FLEET_TAG_BUFFER 0x02 // push reads one of the pipeline's DMA buffers
+
+class FleetTransport
+{
+public:
+    // Runs once per finished push, in order. May be called from the
+    // transport's own task, never from an ISR.
+    typedef void (*done_cb_t)(void *ctx, uint8_t tag);
+
+    virtual ~FleetTransport() {}
+
+    void setDoneCallback(done_cb_t cb, void *ctx)
+    {
+        done_cb = cb;
+        done_ctx = ctx;
+    }
+
+    // Queue a window change. It applies to the pushes queued after it.
+    virtual void setWindow(int x, int y, int w, int h) = 0;
+
+    // Queue `count` pixels already in wire format. `pixels` must not be
+    // touched until the done callback for this push has fired.
+    virtual void push(const uint16_t *pixels, size_t count, uint8_t tag) = 0;
+
+    // Block until at least one more push has completed. Returns at once if
+    // nothing is in flight. Spurious returns are allowed; callers re-check.
+    virtual void waitForDone() = 0;
+
+protected:
+    void signalDone(uint8_t tag)
+    {
+        if (done_cb)
+        {
+            done_cb(done_ctx, tag);
+        }
+    }
+
+private:
+    done_cb_t done_cb = nullptr;
+    void *done_ctx = nullptr;
+};
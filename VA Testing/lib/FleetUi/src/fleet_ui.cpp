@@ -0,0 +1,22 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui (see fleet_ui.h)
+ */
+
+#include "fleet_ui.h"
+#include "fleet_font_cache.h"
+#include "lv_version.h"
+
+void fleet_ui_hello_world(const char *tagline)
+{
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x222222), LV_PART_MAIN);
+
+    lv_obj_t *label = lv_label_create(scr);
+    // Use LVGL's formatting helper and include the LVGL version string
+    lv_label_set_text_fmt(label, "Hello, LVGL %s\n\n%s", lv_version_info(), tagline);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+    lv_obj_set_style_text_font(label, fleet_font_cached(&lv_font_montserrat_14), LV_PART_MAIN);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
+}
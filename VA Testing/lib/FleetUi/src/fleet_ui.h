@@ -0,0 +1,16 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui
+ * Goal:    The screens themselves, kept out of the examples' main.cpp so the
+ * device builds and the host (`native` env) render exactly the same UI.
+ *
+ * Everything here draws on the default display's active screen and only
+ * uses the LVGL API, no hardware.
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+// The ex01 "Hello, LVGL <version>" screen. `tagline` goes under the title.
+void fleet_ui_hello_world(const char *tagline);
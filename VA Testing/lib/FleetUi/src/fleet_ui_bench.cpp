@@ -0,0 +1,635 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui_bench (see fleet_ui_bench.h)
+ */
+
+#include "fleet_ui_bench.h"
+#include "fleet_font_cache.h"
+#include "fleet_port.h"
+#include "fleet_tiered_alloc.h"
+
+// sizeof(lv_obj_t), which LV_OBJ_STYLE_CACHE grows
+#include "src/core/lv_obj_private.h"
+
+// The 48 px font is only in builds with -D FLEET_BENCH_FONTS=1 (lv_conf.h).
+// Without it the scenes still build, with the default font, and
+// fleet_ui_bench_all() says their numbers don't compare.
+#if LV_FONT_MONTSERRAT_48
+#define BENCH_FONT_LARGE (&lv_font_montserrat_48)
+#else
+#define BENCH_FONT_LARGE LV_FONT_DEFAULT
+#endif
+
+static void warn_no_large_font(void)
+{
+#if !LV_FONT_MONTSERRAT_48
+    fleet_log("bench: no 48 px font in this build (-D FLEET_BENCH_FONTS=1); text scenes use LV_FONT_DEFAULT");
+#endif
+}
+
+static const char *const scene_names[FLEET_BENCH_SCENE_COUNT] = {
+    "large_text",
+    "gradients",
+    "spinners",
+    "transcript",
+    "voice",
+};
+
+const char *fleet_ui_bench_name(FleetBenchScene scene)
+{
+    return scene < FLEET_BENCH_SCENE_COUNT ? scene_names[scene] : "?";
+}
+
+// --- Building blocks, shared by the scenes ---
+
+static void gradient_bg(lv_obj_t *obj, uint32_t from, uint32_t to, lv_grad_dir_t dir)
+{
+    lv_obj_set_style_bg_color(obj, lv_color_hex(from), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_color(obj, lv_color_hex(to), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_dir(obj, dir, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+}
+
+static lv_obj_t *card(lv_obj_t *parent, int32_t w, int32_t h, uint32_t from, uint32_t to)
+{
+    lv_obj_t *c = lv_obj_create(parent);
+    lv_obj_remove_flag(c, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(c, w, h);
+    lv_obj_set_style_radius(c, 16, LV_PART_MAIN);
+    lv_obj_set_style_border_width(c, 0, LV_PART_MAIN);
+    gradient_bg(c, from, to, LV_GRAD_DIR_HOR);
+    return c;
+}
+
+static lv_obj_t *text(lv_obj_t *parent, const char *str, const lv_font_t *font, int32_t width)
+{
+    lv_obj_t *label = lv_label_create(parent);
+    lv_label_set_text(label, str);
+    lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(label, fleet_font_cached(font), LV_PART_MAIN);
+    if (width > 0)
+    {
+        lv_obj_set_width(label, width);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    }
+    return label;
+}
+
+static lv_obj_t *spinner(lv_obj_t *parent, int32_t size, int32_t width, uint32_t color, uint32_t period_ms)
+{
+    lv_obj_t *s = lv_spinner_create(parent);
+    lv_spinner_set_anim_params(s, period_ms, 200);
+    lv_obj_set_size(s, size, size);
+    lv_obj_set_style_arc_width(s, width, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(s, width, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(s, lv_color_hex(color), LV_PART_INDICATOR);
+    return s;
+}
+
+// --- Scenes ---
+
+static void scene_large_text(lv_obj_t *scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), LV_PART_MAIN);
+
+    lv_obj_t *clock = text(scr, "12:34", BENCH_FONT_LARGE, 0);
+    lv_obj_align(clock, LV_ALIGN_TOP_MID, 0, 16);
+
+    lv_obj_t *reply = text(scr, "Tomorrow will be sunny with a high of 23 degrees.", BENCH_FONT_LARGE,
+                           lv_display_get_horizontal_resolution(NULL) - 20);
+    lv_obj_align(reply, LV_ALIGN_TOP_LEFT, 10, 90);
+}
+
+static void scene_gradients(lv_obj_t *scr)
+{
+    gradient_bg(scr, 0x1e3c72, 0x2a5298, LV_GRAD_DIR_VER);
+
+    const int32_t w = lv_display_get_horizontal_resolution(NULL) - 20;
+    const int32_t h = (lv_display_get_vertical_resolution(NULL) - 50) / 4;
+    static const uint32_t colors[4][2] = {
+        {0xff512f, 0xdd2476}, {0x11998e, 0x38ef7d}, {0xf7971e, 0xffd200}, {0x8e2de2, 0x4a00e0}};
+    for (int i = 0; i < 4; i++)
+    {
+        lv_obj_t *c = card(scr, w, h, colors[i][0], colors[i][1]);
+        lv_obj_set_style_bg_opa(c, LV_OPA_80, LV_PART_MAIN);
+        lv_obj_align(c, LV_ALIGN_TOP_MID, 0, 10 + i * (h + 10));
+    }
+}
+
+static void scene_spinners(lv_obj_t *scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), LV_PART_MAIN);
+
+    lv_obj_center(spinner(scr, 220, 18, 0x38ef7d, 1000));
+    lv_obj_center(spinner(scr, 150, 12, 0x00c6ff, 700));
+    lv_obj_center(spinner(scr, 80, 8, 0xffd200, 500));
+
+    // Level meter under the spinners, like a mic input indicator
+    lv_obj_t *arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 120, 120);
+    lv_arc_set_value(arc, 65);
+    lv_obj_remove_flag(arc, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_MID, 0, -10);
+}
+
+static void scene_transcript(lv_obj_t *scr)
+{
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), LV_PART_MAIN);
+    const int32_t w = lv_display_get_horizontal_resolution(NULL) - 20;
+
+    lv_obj_t *reply = text(scr, "Sure! Tomorrow looks sunny and warm, around 23 degrees by noon.",
+                           BENCH_FONT_LARGE, w);
+    lv_obj_align(reply, LV_ALIGN_TOP_LEFT, 10, 10);
+
+    static const char *const lines[] = {
+        "> what's the weather like tomorrow",
+        "> and do I need an umbrella",
+        "No rain expected until Thursday evening.",
+        "> remind me to water the plants at six",
+        "Reminder set for 6:00 PM: water the plants.",
+    };
+    for (int i = 0; i < 5; i++)
+    {
+        lv_obj_t *line = text(scr, lines[i], &lv_font_montserrat_14, w);
+        lv_obj_align(line, LV_ALIGN_BOTTOM_LEFT, 10, -10 - (4 - i) * 22);
+    }
+}
+
+static void scene_voice(lv_obj_t *scr)
+{
+    gradient_bg(scr, 0x0f2027, 0x2c5364, LV_GRAD_DIR_VER);
+
+    lv_obj_t *clock = text(scr, "12:34", BENCH_FONT_LARGE, 0);
+    lv_obj_align(clock, LV_ALIGN_TOP_MID, 0, 16);
+
+    lv_obj_align(spinner(scr, 140, 12, 0x38ef7d, 1000), LV_ALIGN_CENTER, 0, -20);
+
+    const int32_t w = lv_display_get_horizontal_resolution(NULL) - 20;
+    lv_obj_t *c = card(scr, w, 110, 0x232526, 0x414345);
+    lv_obj_align(c, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_t *reply = text(c, "Okay, setting a timer for ten minutes. I'll let you know when it's done.",
+                           &lv_font_montserrat_14, w - 40);
+    lv_obj_center(reply);
+}
+
+void fleet_ui_bench_scene(FleetBenchScene scene)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_remove_local_style_prop(scr, LV_STYLE_BG_GRAD_DIR, LV_PART_MAIN);
+
+    switch (scene)
+    {
+    case FLEET_BENCH_LARGE_TEXT:
+        scene_large_text(scr);
+        break;
+    case FLEET_BENCH_GRADIENTS:
+        scene_gradients(scr);
+        break;
+    case FLEET_BENCH_SPINNERS:
+        scene_spinners(scr);
+        break;
+    case FLEET_BENCH_TRANSCRIPT:
+        scene_transcript(scr);
+        break;
+    case FLEET_BENCH_VOICE:
+    default:
+        scene_voice(scr);
+        break;
+    }
+}
+
+void fleet_ui_bench_run(FleetBenchScene scene, uint32_t frames, uint32_t warmup, FleetHistogram *frame_us)
+{
+    lv_lock();
+    fleet_ui_bench_scene(scene);
+    lv_obj_t *scr = lv_screen_active();
+
+    for (uint32_t i = 0; i < warmup + frames; i++)
+    {
+        lv_anim_refr_now();
+        lv_obj_invalidate(scr);
+
+        const uint32_t t0 = fleet_micros();
+        lv_refr_now(NULL);
+        const uint32_t dt = fleet_micros() - t0;
+        if (i >= warmup)
+        {
+            frame_us->record(dt);
+        }
+    }
+    lv_unlock();
+}
+
+void fleet_ui_bench_all(uint32_t frames, uint32_t warmup)
+{
+    fleet_log("bench: %d draw unit(s), %u frames per scene", LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned)frames);
+    warn_no_large_font();
+    fleet_log("scene,units,frames,min_us,avg_us,max_us,fps");
+    for (int s = 0; s < FLEET_BENCH_SCENE_COUNT; s++)
+    {
+        FleetHistogram h;
+        fleet_ui_bench_run((FleetBenchScene)s, frames, warmup, &h);
+        const uint32_t avg = h.mean() ? h.mean() : 1;
+        fleet_log("%s,%d,%u,%u,%u,%u,%u.%u", fleet_ui_bench_name((FleetBenchScene)s), LV_DRAW_SW_DRAW_UNIT_CNT,
+                  (unsigned)h.count(), (unsigned)h.min(), (unsigned)h.mean(), (unsigned)h.max(),
+                  (unsigned)(1000000 / avg), (unsigned)(10000000 / avg % 10));
+    }
+}
+
+void fleet_ui_bench_glyphs_all(uint32_t frames, uint32_t warmup)
+{
+    if (fleet_font_cache_stats().budget == 0)
+    {
+        fleet_log("glyphs: no glyph cache in this build (-D FLEET_GLYPH_CACHE_BYTES)");
+        return;
+    }
+    warn_no_large_font();
+    static const FleetBenchScene scenes[] = {FLEET_BENCH_LARGE_TEXT, FLEET_BENCH_TRANSCRIPT};
+    fleet_log("glyphs: %u byte PSRAM glyph cache, %u frames per run", (unsigned)fleet_font_cache_stats().budget,
+              (unsigned)frames);
+    fleet_log("scene,glyph_cache,frames,avg_us,max_us,fps,hit_pct,glyphs,bytes,evictions");
+    for (FleetBenchScene scene : scenes)
+    {
+        uint32_t avg_us[2] = {};
+        for (int on = 0; on < 2; on++)
+        {
+            // Each run starts with an empty cache
+            fleet_font_cache_begin(fleet_font_cache_stats().budget);
+            fleet_font_cache_enable(on != 0);
+            FleetHistogram h;
+            fleet_ui_bench_run(scene, frames, warmup, &h);
+            const FleetGlyphCacheStats s = fleet_font_cache_stats();
+            const uint32_t lookups = s.hits + s.misses;
+            const uint32_t avg = h.mean() ? h.mean() : 1;
+            fleet_log("%s,%d,%u,%u,%u,%u.%u,%u,%u,%u,%u", fleet_ui_bench_name(scene), on, (unsigned)h.count(),
+                      (unsigned)h.mean(), (unsigned)h.max(), (unsigned)(1000000 / avg),
+                      (unsigned)(10000000 / avg % 10), (unsigned)(lookups ? s.hits * 100ull / lookups : 0),
+                      (unsigned)s.entries, (unsigned)s.bytes, (unsigned)s.evictions);
+            avg_us[on] = avg;
+        }
+        const int32_t saved = (int32_t)avg_us[0] - (int32_t)avg_us[1];
+        fleet_log("# %s: cache saves %d us/frame (%d%% of bypassed)", fleet_ui_bench_name(scene), (int)saved,
+                  (int)(saved * 100 / (int32_t)avg_us[0]));
+    }
+    fleet_font_cache_enable(true);
+}
+
+// --- Churn: items scrolling through a screen ---
+
+static const char *const bubble_texts[] = {
+    "What's the weather tomorrow?",
+    "Tomorrow will be sunny with a high of 23 degrees and a light breeze from the west.",
+    "Set a timer for ten minutes",
+    "Okay, ten minutes, starting now.",
+    "Play something relaxing",
+    "Here's a playlist of calm piano music.",
+};
+
+static const char *const row_icons[] = {LV_SYMBOL_AUDIO, LV_SYMBOL_BELL, LV_SYMBOL_WIFI, LV_SYMBOL_SETTINGS};
+static const char *const row_titles[] = {"Morning playlist", "Kitchen timer", "Living room speaker",
+                                         "Do not disturb until 7:00"};
+static const char *const row_details[] = {"12 songs", "10:00", "Online", "On"};
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+static uint32_t lv_alloc_count(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    return fleet_lv_alloc.stats(FLEET_TIER_INTERNAL).allocs + fleet_lv_alloc.stats(FLEET_TIER_PSRAM).allocs;
+#else
+    return 0;
+#endif
+}
+
+static size_t lv_alloc_used(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    return fleet_lv_alloc.stats(FLEET_TIER_INTERNAL).used + fleet_lv_alloc.stats(FLEET_TIER_PSRAM).used;
+#else
+    return 0;
+#endif
+}
+
+static lv_obj_t *churn_item(FleetUiPool &pool, lv_obj_t *parent, FleetPoolKind kind, uint32_t i)
+{
+    if (kind == FLEET_POOL_BUBBLE)
+    {
+        return pool.bubble(parent, bubble_texts[i % COUNT_OF(bubble_texts)], i % 2 == 0);
+    }
+    return pool.row(parent, row_icons[i % COUNT_OF(row_icons)], row_titles[i % COUNT_OF(row_titles)],
+                    row_details[i % COUNT_OF(row_details)]);
+}
+
+void fleet_ui_bench_churn(FleetPoolKind kind, bool recycle, uint32_t items, FleetChurnResult *result)
+{
+    lv_lock();
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_remove_local_style_prop(scr, LV_STYLE_BG_GRAD_DIR, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), LV_PART_MAIN);
+
+    lv_obj_t *list = lv_obj_create(scr);
+    lv_obj_remove_style_all(list);
+    lv_obj_set_size(list, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_pad_all(list, 8, LV_PART_MAIN);
+    lv_obj_set_style_pad_row(list, 6, LV_PART_MAIN);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    FleetUiPool pool;
+    pool.begin(recycle ? FLEET_CHURN_VISIBLE : 0);
+    for (uint32_t i = 0; i < (uint32_t)FLEET_CHURN_VISIBLE; i++)
+    {
+        churn_item(pool, list, kind, i);
+    }
+    lv_refr_now(NULL);
+
+    result->allocs = 0;
+    for (uint32_t i = FLEET_CHURN_VISIBLE; i < FLEET_CHURN_VISIBLE + items; i++)
+    {
+        const uint32_t allocs0 = lv_alloc_count();
+        const uint32_t t0 = fleet_micros();
+        pool.release(lv_obj_get_child(list, 0));
+        lv_obj_t *item = churn_item(pool, list, kind, i);
+        const uint32_t t1 = fleet_micros();
+        result->allocs += lv_alloc_count() - allocs0;
+
+        lv_obj_scroll_to_view(item, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+        const uint32_t t2 = fleet_micros();
+        result->build_us.record(t1 - t0);
+        result->frame_us.record(t2 - t1);
+    }
+    result->pool = pool.stats(kind);
+
+    // The items use the pool's styles: delete them before the pool goes
+    lv_obj_delete(list);
+    pool.end();
+    lv_unlock();
+}
+
+void fleet_ui_bench_churn_all(uint32_t items)
+{
+    static const char *const kind_names[FLEET_POOL_KIND_COUNT] = {"bubble", "row"};
+    fleet_log("churn: %u items through %d visible", (unsigned)items, FLEET_CHURN_VISIBLE);
+    fleet_log("widget,mode,items,build_avg_us,build_max_us,frame_avg_us,allocs_per_item,created,reused");
+    for (int k = 0; k < FLEET_POOL_KIND_COUNT; k++)
+    {
+        for (int recycle = 0; recycle < 2; recycle++)
+        {
+            FleetChurnResult r;
+            fleet_ui_bench_churn((FleetPoolKind)k, recycle != 0, items, &r);
+            const uint32_t n = r.build_us.count() ? r.build_us.count() : 1;
+            fleet_log("%s,%s,%u,%u,%u,%u,%u.%u,%u,%u", kind_names[k], recycle ? "pool" : "create", (unsigned)items,
+                      (unsigned)r.build_us.mean(), (unsigned)r.build_us.max(), (unsigned)r.frame_us.mean(),
+                      (unsigned)(r.allocs / n), (unsigned)(r.allocs * 10 / n % 10), (unsigned)r.pool.created,
+                      (unsigned)r.pool.reused);
+        }
+    }
+}
+
+// --- Styles: lookups on style-heavy screens ---
+
+static const char *const style_screen_names[FLEET_STYLE_SCREEN_COUNT] = {
+    "settings",
+    "transcript",
+    "home",
+};
+
+const char *fleet_ui_style_screen_name(FleetStyleScreen screen)
+{
+    return screen < FLEET_STYLE_SCREEN_COUNT ? style_screen_names[screen] : "?";
+}
+
+static lv_obj_t *flex_box(lv_obj_t *parent, lv_flex_flow_t flow, int32_t w, int32_t h)
+{
+    lv_obj_t *box = lv_obj_create(parent);
+    lv_obj_set_size(box, w, h);
+    lv_obj_set_flex_flow(box, flow);
+    lv_obj_set_style_pad_all(box, 8, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(box, 6, LV_PART_MAIN);
+    lv_obj_set_style_radius(box, 12, LV_PART_MAIN);
+    lv_obj_set_style_border_width(box, 0, LV_PART_MAIN);
+    return box;
+}
+
+static lv_obj_t *themed_button(lv_obj_t *parent, const char *str)
+{
+    lv_obj_t *btn = lv_button_create(parent);
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_text(label, str);
+    lv_obj_center(label);
+    return btn;
+}
+
+static void style_screen_settings(lv_obj_t *scr)
+{
+    static const char *const sections[] = {"Voice", "Display", "Network"};
+    static const char *const rows[] = {"Wake word", "Follow-up mode", "Brightness", "Auto update"};
+    lv_obj_t *col = flex_box(scr, LV_FLEX_FLOW_COLUMN, lv_pct(100), lv_pct(100));
+    for (const char *section : sections)
+    {
+        lv_obj_t *c = flex_box(col, LV_FLEX_FLOW_COLUMN, lv_pct(100), LV_SIZE_CONTENT);
+        lv_obj_set_style_bg_color(c, lv_color_hex(0x1f2937), LV_PART_MAIN);
+        text(c, section, &lv_font_montserrat_14, 0);
+        for (int i = 0; i < 4; i++)
+        {
+            lv_obj_t *row = flex_box(c, LV_FLEX_FLOW_ROW, lv_pct(100), LV_SIZE_CONTENT);
+            lv_obj_set_flex_align(row, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+            lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN);
+            text(row, rows[i], &lv_font_montserrat_14, 0);
+            if (i % 2 == 0)
+            {
+                lv_obj_t *sw = lv_switch_create(row);
+                if (i == 0)
+                {
+                    lv_obj_add_state(sw, LV_STATE_CHECKED);
+                }
+            }
+            else
+            {
+                themed_button(row, "Edit");
+            }
+        }
+    }
+}
+
+static void style_screen_transcript(lv_obj_t *scr)
+{
+    lv_obj_t *col = flex_box(scr, LV_FLEX_FLOW_COLUMN, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_bg_color(col, lv_color_hex(0x101418), LV_PART_MAIN);
+    for (int i = 0; i < 20; i++)
+    {
+        lv_obj_t *b = flex_box(col, LV_FLEX_FLOW_COLUMN, lv_pct(85), LV_SIZE_CONTENT);
+        lv_obj_set_style_bg_color(b, lv_color_hex(i % 2 ? 0x374151 : 0x2563eb), LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(b, 6, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(b, LV_OPA_30, LV_PART_MAIN);
+        lv_obj_t *label = text(b, bubble_texts[i % COUNT_OF(bubble_texts)], &lv_font_montserrat_14, lv_pct(100));
+        lv_obj_set_style_text_line_space(label, 2, LV_PART_MAIN);
+    }
+}
+
+static void style_screen_home(lv_obj_t *scr)
+{
+    static const char *const icons[] = {LV_SYMBOL_WIFI, LV_SYMBOL_BLUETOOTH, LV_SYMBOL_BATTERY_3};
+    static const char *const buttons[] = {LV_SYMBOL_AUDIO " Music", LV_SYMBOL_BELL " Timer", LV_SYMBOL_HOME " Lights",
+                                          LV_SYMBOL_LIST " Lists",  LV_SYMBOL_CALL " Call",  LV_SYMBOL_SETTINGS " Setup"};
+    lv_obj_t *col = flex_box(scr, LV_FLEX_FLOW_COLUMN, lv_pct(100), lv_pct(100));
+    gradient_bg(col, 0x0f2027, 0x2c5364, LV_GRAD_DIR_VER);
+
+    lv_obj_t *bar = flex_box(col, LV_FLEX_FLOW_ROW, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_t *clock = text(bar, "12:34", &lv_font_montserrat_14, 0);
+    lv_obj_set_flex_grow(clock, 1);
+    for (const char *icon : icons)
+    {
+        text(bar, icon, &lv_font_montserrat_14, 0);
+    }
+
+    lv_obj_t *center = flex_box(col, LV_FLEX_FLOW_COLUMN, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_align(center, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_bg_opa(center, LV_OPA_TRANSP, LV_PART_MAIN);
+    spinner(center, 100, 10, 0x38ef7d, 1000);
+    text(center, "Listening...", &lv_font_montserrat_14, 0);
+
+    lv_obj_t *grid = flex_box(col, LV_FLEX_FLOW_ROW_WRAP, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_grow(grid, 1);
+    lv_obj_set_style_bg_opa(grid, LV_OPA_TRANSP, LV_PART_MAIN);
+    for (const char *b : buttons)
+    {
+        lv_obj_t *btn = themed_button(grid, b);
+        lv_obj_set_size(btn, lv_pct(47), 56);
+    }
+}
+
+static void style_screen(FleetStyleScreen screen, lv_obj_t *scr)
+{
+    switch (screen)
+    {
+    case FLEET_STYLE_SETTINGS:
+        style_screen_settings(scr);
+        break;
+    case FLEET_STYLE_TRANSCRIPT:
+        style_screen_transcript(scr);
+        break;
+    case FLEET_STYLE_HOME:
+    default:
+        style_screen_home(scr);
+        break;
+    }
+}
+
+static uint32_t count_objects(lv_obj_t *obj)
+{
+    uint32_t n = 1;
+    const uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        n += count_objects(lv_obj_get_child(obj, i));
+    }
+    return n;
+}
+
+static void mark_layout_dirty(lv_obj_t *obj)
+{
+    lv_obj_mark_layout_as_dirty(obj);
+    const uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        mark_layout_dirty(lv_obj_get_child(obj, i));
+    }
+}
+
+// What layout and draw ask of every object, main part, current state
+static const lv_style_prop_t lookup_props[] = {
+    LV_STYLE_WIDTH,    LV_STYLE_HEIGHT, LV_STYLE_PAD_TOP,      LV_STYLE_PAD_LEFT, LV_STYLE_LAYOUT,
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BORDER_WIDTH, LV_STYLE_RADIUS,   LV_STYLE_SHADOW_WIDTH,
+    LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_OPA, LV_STYLE_TRANSFORM_ROTATION,
+};
+
+// Passes over the screen per lookup sample, to stay well above the
+// microsecond timer resolution
+#define LOOKUP_PASSES 10
+
+static uint32_t lookup_all(lv_obj_t *obj, uint32_t *sink)
+{
+    uint32_t n = 0;
+    for (lv_style_prop_t prop : lookup_props)
+    {
+        *sink += (uint32_t)lv_obj_get_style_prop(obj, LV_PART_MAIN, prop).num;
+        n++;
+    }
+    const uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        n += lookup_all(lv_obj_get_child(obj, i), sink);
+    }
+    return n;
+}
+
+void fleet_ui_bench_styles(FleetStyleScreen screen, uint32_t frames, FleetStyleResult *result)
+{
+    lv_lock();
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_remove_local_style_prop(scr, LV_STYLE_BG_GRAD_DIR, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101418), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(scr, 0, LV_PART_MAIN);
+    lv_refr_now(NULL);
+
+    // Build (and tear down) a few times: creation resolves styles too
+    size_t heap0 = 0;
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        lv_obj_clean(scr);
+        heap0 = lv_alloc_used();
+        const uint32_t t0 = fleet_micros();
+        style_screen(screen, scr);
+        lv_obj_update_layout(scr);
+        result->build_us.record(fleet_micros() - t0);
+    }
+    result->heap_bytes = (uint32_t)(lv_alloc_used() - heap0);
+    result->objects = count_objects(scr) - 1;
+
+    uint32_t sink = 0;
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        mark_layout_dirty(scr);
+        uint32_t t0 = fleet_micros();
+        lv_obj_update_layout(scr);
+        result->layout_us.record(fleet_micros() - t0);
+
+        lv_obj_invalidate(scr);
+        t0 = fleet_micros();
+        lv_refr_now(NULL);
+        result->draw_us.record(fleet_micros() - t0);
+
+        t0 = fleet_micros();
+        result->lookups = 0;
+        for (int pass = 0; pass < LOOKUP_PASSES; pass++)
+        {
+            result->lookups += lookup_all(scr, &sink);
+        }
+        result->lookup_us.record(fleet_micros() - t0);
+    }
+    (void)sink;
+    lv_unlock();
+}
+
+void fleet_ui_bench_styles_all(uint32_t frames)
+{
+    fleet_log("styles: LV_OBJ_STYLE_CACHE %d, sizeof(lv_obj_t) %u, %u runs per screen", LV_OBJ_STYLE_CACHE,
+              (unsigned)sizeof(lv_obj_t), (unsigned)frames);
+    fleet_log("screen,style_cache,objects,heap_bytes,bytes_per_obj,build_us,layout_us,draw_us,lookup_ns");
+    for (int s = 0; s < FLEET_STYLE_SCREEN_COUNT; s++)
+    {
+        FleetStyleResult r;
+        fleet_ui_bench_styles((FleetStyleScreen)s, frames, &r);
+        const uint32_t objects = r.objects ? r.objects : 1;
+        const uint32_t lookups = r.lookups ? r.lookups : 1;
+        fleet_log("%s,%d,%u,%u,%u,%u,%u,%u,%u", fleet_ui_style_screen_name((FleetStyleScreen)s), LV_OBJ_STYLE_CACHE,
+                  (unsigned)r.objects, (unsigned)r.heap_bytes, (unsigned)(r.heap_bytes / objects),
+                  (unsigned)r.build_us.mean(), (unsigned)r.layout_us.mean(), (unsigned)r.draw_us.mean(),
+                  (unsigned)((uint64_t)r.lookup_us.mean() * 1000 / lookups));
+    }
+}
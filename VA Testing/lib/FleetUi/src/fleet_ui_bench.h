@@ -0,0 +1,110 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui_bench
+ * Goal:    Benchmark scenes that look like what the voice assistant will
+ * actually draw, and a runner that times full-screen frames of them.
+ *
+ * Used by the draw-unit comparison (FLEET_DRAW_UNITS=1 vs 2) on the device
+ * (ex02_bench_scenes) and on the host (native_bench_scenes*). Frames are
+ * whole-screen redraws driven with lv_refr_now(), so the numbers are
+ * render + flush cost only, without LVGL's refresh period in the way.
+ *
+ * The churn benchmark scrolls chat bubbles or list rows through a screen,
+ * one new item per frame, with and without FleetUiPool recycling
+ * (fleet_ui_pool.h).
+ *
+ * The glyph benchmark runs the text scenes with the PSRAM glyph cache
+ * (fleet_font_cache.h) bypassed and in use. All scene text goes through
+ * fleet_font_cached().
+ *
+ * The style benchmark times building, laying out, drawing and reading
+ * the styles of style-heavy screens. Run it in a build with and without
+ * -D FLEET_STYLE_CACHE=1 (LV_OBJ_STYLE_CACHE) and compare the lines.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#include "fleet_metrics.h"
+#include "fleet_ui_pool.h"
+
+enum FleetBenchScene
+{
+    FLEET_BENCH_LARGE_TEXT, // clock + reply text in Montserrat 48
+    FLEET_BENCH_GRADIENTS,  // full-screen and card gradients, rounded
+    FLEET_BENCH_SPINNERS,   // "listening"/"thinking" spinners and arcs
+    FLEET_BENCH_TRANSCRIPT, // a long reply in Montserrat 48 over a 14 px transcript
+    FLEET_BENCH_VOICE,      // all of the above on one screen
+    FLEET_BENCH_SCENE_COUNT
+};
+
+const char *fleet_ui_bench_name(FleetBenchScene scene);
+
+// Replace the active screen's content with `scene`
+void fleet_ui_bench_scene(FleetBenchScene scene);
+
+// Build `scene`, render `warmup` untimed frames, then time `frames`
+// full-screen frames (animations are stepped before each). Takes the LVGL
+// lock, so it is safe with LV_USE_OS as long as nothing else renders.
+void fleet_ui_bench_run(FleetBenchScene scene, uint32_t frames, uint32_t warmup, FleetHistogram *frame_us);
+
+// Run every scene and fleet_log() one line per scene (CSV-friendly)
+void fleet_ui_bench_all(uint32_t frames, uint32_t warmup);
+
+// The text scenes with the glyph cache bypassed, then in use (cold at
+// the start of the warmup): one fleet_log() line each with frame time and
+// hit rate, then what the cache saved per frame. Says so and returns if
+// the build has no glyph cache.
+void fleet_ui_bench_glyphs_all(uint32_t frames, uint32_t warmup);
+
+struct FleetChurnResult
+{
+    FleetHistogram build_us; // release the oldest item + add one
+    FleetHistogram frame_us; // scroll, layout, render and flush after it
+    uint32_t allocs;         // lv_malloc calls while building (tiered allocator only, else 0)
+    FleetUiPoolStats pool;
+};
+
+// Items on screen at once in the churn benchmark. Odd, so a recycled
+// bubble always switches sides and text (the pool's worst case).
+#define FLEET_CHURN_VISIBLE 11
+
+// Fill a screen with FLEET_CHURN_VISIBLE items of `kind`, then scroll
+// `items` more through it, one per frame. `recycle` keeps released items
+// in a FleetUiPool; otherwise each is deleted and the next one created.
+void fleet_ui_bench_churn(FleetPoolKind kind, bool recycle, uint32_t items, FleetChurnResult *result);
+
+// Both kinds, both ways, one fleet_log() line each (CSV-friendly)
+void fleet_ui_bench_churn_all(uint32_t items);
+
+enum FleetStyleScreen
+{
+    FLEET_STYLE_SETTINGS,   // nested flex cards of themed buttons and switches
+    FLEET_STYLE_TRANSCRIPT, // a flex column of styled transcript labels
+    FLEET_STYLE_HOME,       // status bar, spinner, wrapped grid of buttons
+    FLEET_STYLE_SCREEN_COUNT
+};
+
+const char *fleet_ui_style_screen_name(FleetStyleScreen screen);
+
+struct FleetStyleResult
+{
+    FleetHistogram build_us;  // create the screen
+    FleetHistogram layout_us; // every object marked dirty, then one layout pass
+    FleetHistogram draw_us;   // full-screen render + flush
+    FleetHistogram lookup_us; // a fixed set of properties read on every object, a few passes
+    uint32_t objects;         // objects on the screen
+    uint32_t lookups;         // property reads per lookup_us sample
+    uint32_t heap_bytes;      // lv_malloc bytes the screen holds (tiered allocator only, else 0)
+};
+
+// Build `screen` `frames` times (deleting it in between), time layout,
+// draw and lookups `frames` times on the last one
+void fleet_ui_bench_styles(FleetStyleScreen screen, uint32_t frames, FleetStyleResult *result);
+
+// Every screen, one fleet_log() line each (CSV-friendly), with the style
+// cache setting and sizeof(lv_obj_t) in the header line
+void fleet_ui_bench_styles_all(uint32_t frames);
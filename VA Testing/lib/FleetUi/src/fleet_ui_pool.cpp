@@ -0,0 +1,234 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui_pool (see fleet_ui_pool.h)
+ */
+
+#include "fleet_ui_pool.h"
+
+#include <string.h>
+
+// user_data of a pooled subtree: kind + 1, and the bubble variant
+#define TAG_KIND_MASK 0xffu
+#define TAG_FROM_USER 0x100u
+
+static uintptr_t tag_of(lv_obj_t *obj)
+{
+    return (uintptr_t)lv_obj_get_user_data(obj);
+}
+
+static void set_tag(lv_obj_t *obj, uintptr_t tag)
+{
+    lv_obj_set_user_data(obj, (void *)tag);
+}
+
+// Skips the realloc and the invalidation when a reused label already
+// shows the text (icons, repeated details)
+static void set_text(lv_obj_t *label, const char *str)
+{
+    if (strcmp(lv_label_get_text(label), str) != 0)
+    {
+        lv_label_set_text(label, str);
+    }
+}
+
+// A bare object with one of our styles: no theme styles to resolve
+static lv_obj_t *bare(lv_obj_t *obj, const lv_style_t *style)
+{
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, style, LV_PART_MAIN);
+    lv_obj_remove_flag(obj, (lv_obj_flag_t)(LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE));
+    return obj;
+}
+
+void FleetUiPool::initStyles()
+{
+    if (styles_ready)
+    {
+        return;
+    }
+    styles_ready = true;
+
+    lv_style_init(&bubble_row);
+    lv_style_set_width(&bubble_row, lv_pct(100));
+    lv_style_set_height(&bubble_row, LV_SIZE_CONTENT);
+    lv_style_set_layout(&bubble_row, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&bubble_row, LV_FLEX_FLOW_ROW);
+    lv_style_set_flex_main_place(&bubble_row, LV_FLEX_ALIGN_START);
+
+    lv_style_init(&bubble_row_user);
+    lv_style_set_flex_main_place(&bubble_row_user, LV_FLEX_ALIGN_END);
+
+    lv_style_init(&card);
+    lv_style_set_width(&card, lv_pct(80));
+    lv_style_set_height(&card, LV_SIZE_CONTENT);
+    lv_style_set_radius(&card, 14);
+    lv_style_set_pad_all(&card, 10);
+    lv_style_set_bg_opa(&card, LV_OPA_COVER);
+
+    lv_style_init(&card_user);
+    lv_style_set_bg_color(&card_user, lv_color_hex(0x2563eb));
+
+    lv_style_init(&card_assistant);
+    lv_style_set_bg_color(&card_assistant, lv_color_hex(0x374151));
+
+    lv_style_init(&text);
+    lv_style_set_text_color(&text, lv_color_white());
+    lv_style_set_text_font(&text, &lv_font_montserrat_14);
+
+    lv_style_init(&bubble_text);
+    lv_style_set_width(&bubble_text, lv_pct(100));
+
+    lv_style_init(&list_row);
+    lv_style_set_width(&list_row, lv_pct(100));
+    lv_style_set_height(&list_row, LV_SIZE_CONTENT);
+    lv_style_set_pad_hor(&list_row, 10);
+    lv_style_set_pad_ver(&list_row, 8);
+    lv_style_set_pad_column(&list_row, 8);
+    lv_style_set_radius(&list_row, 8);
+    lv_style_set_bg_color(&list_row, lv_color_hex(0x1f2937));
+    lv_style_set_bg_opa(&list_row, LV_OPA_COVER);
+    lv_style_set_layout(&list_row, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&list_row, LV_FLEX_FLOW_ROW);
+    lv_style_set_flex_cross_place(&list_row, LV_FLEX_ALIGN_CENTER);
+
+    lv_style_init(&icon);
+    lv_style_set_text_color(&icon, lv_color_hex(0x38ef7d));
+
+    lv_style_init(&title);
+    lv_style_set_flex_grow(&title, 1);
+
+    lv_style_init(&detail);
+    lv_style_set_text_color(&detail, lv_color_hex(0x9ca3af));
+}
+
+void FleetUiPool::begin(uint16_t max_idle_per_kind)
+{
+    initStyles();
+    max_idle = max_idle_per_kind < MAX_IDLE ? max_idle_per_kind : MAX_IDLE;
+    if (parking == nullptr && max_idle > 0)
+    {
+        // A screen that is never loaded: parked objects cost no layout or draw
+        parking = lv_obj_create(NULL);
+        lv_obj_remove_style_all(parking);
+    }
+}
+
+void FleetUiPool::end()
+{
+    if (parking != nullptr)
+    {
+        lv_obj_delete(parking);
+        parking = nullptr;
+    }
+    for (int k = 0; k < FLEET_POOL_KIND_COUNT; k++)
+    {
+        st[k].idle = 0;
+    }
+}
+
+lv_obj_t *FleetUiPool::createBubble(lv_obj_t *parent)
+{
+    lv_obj_t *row_obj = bare(lv_obj_create(parent), &bubble_row);
+    lv_obj_t *card_obj = bare(lv_obj_create(row_obj), &card);
+    lv_obj_add_style(card_obj, &card_assistant, LV_PART_MAIN);
+    lv_obj_t *label = bare(lv_label_create(card_obj), &text);
+    lv_obj_add_style(label, &bubble_text, LV_PART_MAIN);
+    set_tag(row_obj, FLEET_POOL_BUBBLE + 1);
+    return row_obj;
+}
+
+lv_obj_t *FleetUiPool::createRow(lv_obj_t *parent)
+{
+    lv_obj_t *row_obj = bare(lv_obj_create(parent), &list_row);
+    lv_obj_add_style(bare(lv_label_create(row_obj), &text), &icon, LV_PART_MAIN);
+    lv_obj_t *title_label = bare(lv_label_create(row_obj), &text);
+    lv_obj_add_style(title_label, &title, LV_PART_MAIN);
+    lv_label_set_long_mode(title_label, LV_LABEL_LONG_DOT);
+    lv_obj_add_style(bare(lv_label_create(row_obj), &text), &detail, LV_PART_MAIN);
+    set_tag(row_obj, FLEET_POOL_ROW + 1);
+    return row_obj;
+}
+
+lv_obj_t *FleetUiPool::take(FleetPoolKind kind, lv_obj_t *parent)
+{
+    FleetUiPoolStats &s = st[kind];
+    if (s.idle > 0)
+    {
+        lv_obj_t *obj = idle[kind][--s.idle];
+        lv_obj_set_parent(obj, parent);
+        s.reused++;
+        return obj;
+    }
+    s.created++;
+    return kind == FLEET_POOL_BUBBLE ? createBubble(parent) : createRow(parent);
+}
+
+lv_obj_t *FleetUiPool::bubble(lv_obj_t *parent, const char *str, bool from_user)
+{
+    lv_obj_t *row_obj = take(FLEET_POOL_BUBBLE, parent);
+    lv_obj_t *card_obj = lv_obj_get_child(row_obj, 0);
+
+    // Swap the variant only when it changes: every add/remove_style
+    // re-resolves the object's styles
+    const uintptr_t tag = tag_of(row_obj);
+    if (((tag & TAG_FROM_USER) != 0) != from_user)
+    {
+        if (from_user)
+        {
+            lv_obj_add_style(row_obj, &bubble_row_user, LV_PART_MAIN);
+            lv_obj_remove_style(card_obj, &card_assistant, LV_PART_MAIN);
+            lv_obj_add_style(card_obj, &card_user, LV_PART_MAIN);
+        }
+        else
+        {
+            lv_obj_remove_style(row_obj, &bubble_row_user, LV_PART_MAIN);
+            lv_obj_remove_style(card_obj, &card_user, LV_PART_MAIN);
+            lv_obj_add_style(card_obj, &card_assistant, LV_PART_MAIN);
+        }
+        set_tag(row_obj, tag ^ TAG_FROM_USER);
+    }
+    set_text(lv_obj_get_child(card_obj, 0), str);
+    return row_obj;
+}
+
+lv_obj_t *FleetUiPool::row(lv_obj_t *parent, const char *icon_sym, const char *title_str, const char *detail_str)
+{
+    lv_obj_t *row_obj = take(FLEET_POOL_ROW, parent);
+    set_text(lv_obj_get_child(row_obj, 0), icon_sym);
+    set_text(lv_obj_get_child(row_obj, 1), title_str);
+    set_text(lv_obj_get_child(row_obj, 2), detail_str);
+    return row_obj;
+}
+
+void FleetUiPool::release(lv_obj_t *obj)
+{
+    const uintptr_t kind = (tag_of(obj) & TAG_KIND_MASK) - 1;
+    if (kind >= FLEET_POOL_KIND_COUNT)
+    {
+        // Not one of ours
+        lv_obj_delete(obj);
+        return;
+    }
+    FleetUiPoolStats &s = st[kind];
+    if (parking != nullptr && s.idle < max_idle)
+    {
+        lv_obj_set_parent(obj, parking);
+        idle[kind][s.idle++] = obj;
+        s.parked++;
+    }
+    else
+    {
+        lv_obj_delete(obj);
+        s.deleted++;
+    }
+}
+
+void FleetUiPool::resetStats()
+{
+    for (int k = 0; k < FLEET_POOL_KIND_COUNT; k++)
+    {
+        const uint16_t idle_now = st[k].idle;
+        st[k] = FleetUiPoolStats();
+        st[k].idle = idle_now;
+    }
+}
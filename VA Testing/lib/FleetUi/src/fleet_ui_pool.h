@@ -0,0 +1,84 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Module:  fleet_ui_pool
+ * Goal:    Recycle the widget subtrees a voice screen churns through
+ * (chat bubbles, list rows) instead of deleting and re-creating them.
+ *
+ * Creating a bubble is three objects, their style lists, a label text and
+ * the children arrays, all through lv_malloc, plus a full style
+ * resolution. release() instead parks the subtree on a screen that is
+ * never loaded, so it costs no layout or drawing there. The next
+ * bubble()/row() takes it back, moves it under the new parent and only
+ * swaps the text and the variant style.
+ *
+ * Styles are shared lv_style_t objects owned by the pool (no local styles
+ * per widget), for created and reused subtrees alike. A pool with
+ * max_idle 0 always creates and deletes: that is the baseline in
+ * fleet_ui_bench_churn().
+ *
+ * Objects handed out keep their kind in user_data; leave it alone. Call
+ * everything with the LVGL lock held.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "lvgl.h"
+
+enum FleetPoolKind
+{
+    FLEET_POOL_BUBBLE, // row > card > label
+    FLEET_POOL_ROW,    // row > icon, title, detail labels
+    FLEET_POOL_KIND_COUNT
+};
+
+struct FleetUiPoolStats
+{
+    uint32_t created;  // built from scratch
+    uint32_t reused;   // taken back from the idle list
+    uint32_t parked;   // released into the idle list
+    uint32_t deleted;  // released with the idle list full (or max_idle 0)
+    uint16_t idle;     // parked right now
+};
+
+class FleetUiPool
+{
+public:
+    static const int MAX_IDLE = 32;
+
+    // max_idle: subtrees kept per kind (at most MAX_IDLE, 0 = no pooling).
+    // Sized to what scrolls off one screen, the rest is deleted.
+    void begin(uint16_t max_idle = 16);
+    void end(); // deletes everything parked
+
+    // A chat bubble, right-aligned for the user, left for the assistant
+    lv_obj_t *bubble(lv_obj_t *parent, const char *text, bool from_user);
+
+    // A list row: icon (an LV_SYMBOL_*), title, detail on the right
+    lv_obj_t *row(lv_obj_t *parent, const char *icon, const char *title, const char *detail);
+
+    // Give back a bubble() or row(); it disappears from its parent
+    void release(lv_obj_t *obj);
+
+    const FleetUiPoolStats &stats(FleetPoolKind kind) const { return st[kind]; }
+    void resetStats();
+
+private:
+    lv_obj_t *take(FleetPoolKind kind, lv_obj_t *parent);
+    lv_obj_t *createBubble(lv_obj_t *parent);
+    lv_obj_t *createRow(lv_obj_t *parent);
+
+    lv_obj_t *parking = nullptr;
+    lv_obj_t *idle[FLEET_POOL_KIND_COUNT][MAX_IDLE];
+    uint16_t max_idle = 0;
+    FleetUiPoolStats st[FLEET_POOL_KIND_COUNT] = {};
+
+    void initStyles();
+
+    lv_style_t bubble_row, bubble_row_user;
+    lv_style_t card, card_user, card_assistant;
+    lv_style_t text, bubble_text;
+    lv_style_t list_row, icon, title, detail;
+    bool styles_ready = false;
+};
@@ -1,50 +1,163 @@
 /*
- * ex00_hello_bb_spi
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: ex00_hello_bb_spi
+ * Target:  Guition S3 3.5" QSPI (JC3248W535)
+ * Goal:    Raw panel throughput, bb_spi_lcd only (no LVGL, no flush
+ * pipeline): what fillScreen(), pushPixels() with and without
+ * DRAW_WITH_DMA and setAddrWindow() cost at each bus clock. The ceiling
+ * every LVGL number in ex01/ex02 sits under.
  *
- * Target: Guition S3 3.5" (JC3248W535)
+ * Runs fleet_panel_bench (lib/FleetGfx) once at boot and prints the
+ * throughput and window tables as CSV on the serial console; send 'b' to
+ * run it again. The screen flashes red/green/blue and stripes while it
+ * runs. The small windows aren't full-width, so the AXS15231B draws them
+ * in the wrong place; the bus time is what's measured.
  *
- * Purpose: A minimal "Hello, Screen!" test to verify the bb_spi_lcd
- * driver, hardware connections, and display controller (AXS15231B).
+ * bb_spi_lcd has no clock setter and no teardown, so each clock re-runs
+ * the manual begin() from ex01 at the new frequency, with no DMA in
+ * flight. A clock whose begin() fails is skipped. So is one that didn't
+ * take: fleet_panel_bench times a fill after every switch, and a rate
+ * faster than the wire allows, or no different from the previous clock,
+ * is reported as "clock didn't take" instead of as rows.
  *
- * This test does NOT use LVGL.
- * It only initializes the display and fills the screen with solid
- * colors (Red, Green, Blue) in a loop.
+ * Build flags:
+ *   -D FLEET_BENCH_BUS_MHZ=10,20,40,80  clocks to sweep (80 MHz APB
+ *                                        dividers; others get rounded)
+ *   -D FLEET_BENCH_FRAMES=20            full-screen frames per test
+ *   -D FLEET_BENCH_WINDOW_ITERS=100     transactions per window size
+ *   -D FLEET_BENCH_STRIP_ROWS=24        rows per DMA strip (x2 buffers)
+ *
+ * The same benchmark runs on the host against a simulated bus:
+ * pio run -e native_bench_panel_throughput -t exec
  */
 
 #include <Arduino.h>
 #include <bb_spi_lcd.h> // Our "secret weapon" driver
 
-#define PANEL DISPLAY_CYD_535 // Guition 3.5" AXS15231B
+#include "fleet_panel_bench.h"
+#include "fleet_port.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+
+#ifndef FLEET_BENCH_BUS_MHZ
+#define FLEET_BENCH_BUS_MHZ 10, 20, 40, 80
+#endif
+#ifndef FLEET_BENCH_FRAMES
+#define FLEET_BENCH_FRAMES 20
+#endif
+#ifndef FLEET_BENCH_WINDOW_ITERS
+#define FLEET_BENCH_WINDOW_ITERS 100
+#endif
+#ifndef FLEET_BENCH_STRIP_ROWS
+#define FLEET_BENCH_STRIP_ROWS 24
+#endif
 
 // Instantiate the driver object
 BB_SPI_LCD lcd;
 
+// fleet_panel_bench's view of the panel: bb_spi_lcd, timed by esp_timer
+class LcdBus : public FleetBenchBus
+{
+public:
+    const char *name() const override { return "AXS15231B (bb_spi_lcd)"; }
+    // lcd.width()/height() are wrong with the manual begin() (see ex01)
+    int width() const override { return LCD_WIDTH; }
+    int height() const override { return LCD_HEIGHT; }
+
+    uint32_t setBusHz(uint32_t hz) override
+    {
+        if (hz == bus_hz)
+        {
+            return hz;
+        }
+        // begin() resets the driver's state: nothing may still be reading
+        // a buffer through the old one
+        if (bus_hz != 0)
+        {
+            lcd.waitDMA();
+        }
+        const int rc = lcd.begin(31, 0, hz, 45, 8, -1, 1); // itype, flags(0), freq, cs(45), dc(8), rst(-1), bl(1)
+        if (rc < 0)
+        {
+            fleet_log("bb_spi_lcd begin() at %u Hz failed (%d)", (unsigned)hz, rc);
+            bus_hz = 0;
+            return 0;
+        }
+        bus_hz = hz;
+        return hz;
+    }
+
+    void fillScreen(uint16_t color) override { lcd.fillScreen(color); }
+    void setAddrWindow(int x, int y, int w, int h) override { lcd.setAddrWindow(x, y, w, h); }
+
+    void pushPixels(const uint16_t *px, int count, bool dma) override
+    {
+        lcd.pushPixels((uint16_t *)px, count, dma ? DRAW_TO_LCD | DRAW_WITH_DMA : DRAW_TO_LCD);
+    }
+
+    void waitDma() override { lcd.waitDMA(); }
+    uint32_t micros() override { return fleet_micros(); }
+
+private:
+    uint32_t bus_hz = 0; // clock of the last begin() that succeeded
+};
+
+static const uint32_t bus_mhz[] = {FLEET_BENCH_BUS_MHZ};
+static uint32_t bus_hz[sizeof(bus_mhz) / sizeof(bus_mhz[0])];
+static uint16_t *strips[2];
+static LcdBus bus;
+static FleetPanelBench bench;
+
+static void run_bench()
+{
+    FleetPanelBenchConfig cfg;
+    cfg.bus_hz = bus_hz;
+    cfg.bus_count = sizeof(bus_hz) / sizeof(bus_hz[0]);
+    cfg.lanes = 4;
+    cfg.frames = FLEET_BENCH_FRAMES;
+    cfg.window_iters = FLEET_BENCH_WINDOW_ITERS;
+    cfg.strip[0] = strips[0];
+    cfg.strip[1] = strips[1];
+    cfg.strip_px = (size_t)LCD_WIDTH * FLEET_BENCH_STRIP_ROWS;
+
+    fleet_log("Running panel benchmark...");
+    if (bench.run(&bus, cfg))
+    {
+        bench.print();
+    }
+    fleet_log("Send 'b' to run it again.");
+}
+
 void setup()
 {
     Serial.begin(115200);
     // Wait a moment for the serial monitor to connect
     delay(2000);
     Serial.println("--- ex00_hello_bb_spi ---");
-    Serial.println("Initializing display...");
 
-    // Initialize the display driver
-    lcd.begin(PANEL);
+    for (size_t i = 0; i < sizeof(bus_mhz) / sizeof(bus_mhz[0]); i++)
+    {
+        bus_hz[i] = bus_mhz[i] * 1000000;
+    }
+    // pushPixels() with DRAW_WITH_DMA reads the buffers from the GDMA
+    const size_t bytes = (size_t)LCD_WIDTH * FLEET_BENCH_STRIP_ROWS * sizeof(uint16_t);
+    strips[0] = (uint16_t *)fleet_malloc(bytes, FLEET_MEM_DMA);
+    strips[1] = (uint16_t *)fleet_malloc(bytes, FLEET_MEM_DMA);
+    if (!strips[0] || !strips[1])
+    {
+        fleet_log("FATAL ERROR: DMA strip allocation failed (%u bytes x 2)", (unsigned)bytes);
+        while (1);
+    }
 
-    Serial.println("Display initialized.");
-    Serial.println("Starting color cycle loop...");
+    run_bench();
 }
 
 void loop()
 {
-    Serial.println("Filling screen RED");
-    lcd.fillScreen(0xf800); // 16-bit color (565) - RED
-    delay(2000);
-
-    Serial.println("Filling screen GREEN");
-    lcd.fillScreen(0x07e0); // 16-bit color (565) - GREEN
-    delay(2000);
-
-    Serial.println("Filling screen BLUE");
-    lcd.fillScreen(0x001f); // 16-bit color (565) - BLUE
-    delay(2000);
-}
\ No newline at end of file
+    if (fleet_console_read() == 'b')
+    {
+        run_bench();
+    }
+    delay(10);
+}
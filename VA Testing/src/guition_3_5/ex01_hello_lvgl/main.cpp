@@ -9,17 +9,21 @@
  * Status:  CORRECTED IMPLEMENTATION (Nov 13, 2025)
  * - Uses LVGL v9.4 API (lv_display_t, etc.)
  * - Uses MANUAL pin definitions (the pre-defined panel was wrong)
- * - Uses correct "glue" pattern from cyd_demo.ino
+ * - Uses correct "glue" pattern from cyd_demo.ino, now shared with
+ *   every example in lib/FleetDisplay
  */
 
 #include <Arduino.h>
 #include "lvgl.h"
 #include "lv_version.h"
-#if defined(ARDUINO_ARCH_ESP32)
-#include <esp_heap_caps.h>
-#endif
 
 #include <bb_spi_lcd.h> // 2. The "F1 Car" (bitbank's driver)
+#include "fleet_asset_fs.h"
+#include "fleet_display.h" // 3. The "Glue" (lib/FleetDisplay)
+#include "fleet_images.h"  // images/*.png, converted at build time
+#include "fleet_port.h"
+#include "fleet_render_task.h"
+#include "fleet_ui.h"
 
 // --- Step 1: Define our "Ground Truth" Pins ---
 // This is the manual configuration. We are NOT using a
@@ -45,60 +49,43 @@
 
 BB_SPI_LCD lcd;
 
-// --- Step 3: Manually define the "Glue" parts ---
-static lv_draw_buf_t disp_buf;
-static lv_display_t *disp;
-static lv_color_t *buf1;
-static uint16_t *dma_buf = nullptr;
-static uint16_t dma_buf_static[512]; // Fallback buffer
+// --- Step 3: The "Glue" ---
+// Draw buffers, DMA strip buffers and the flush callback all live in
+// FleetDisplay now (lib/FleetDisplay). Flush mode and DMA budget are set
+// with FLEET_RENDER_SWAPPED / FLEET_DMA_BUDGET_BYTES build flags.
+static FleetDisplay display;
+
+// Optional TE pacing (see fleet_te.h): -D FLEET_TE_PIN=<gpio> syncs flushes
+// to the panel's TE line. Without the pin, -D FLEET_TE_SIM_HZ=<hz> paces the
+// loop from a timer instead (no tearing benefit, same loop behaviour).
+#ifndef FLEET_TE_SIM_HZ
+#define FLEET_TE_SIM_HZ 0
+#endif
+#if FLEET_TE_PIN >= 0 || FLEET_TE_SIM_HZ > 0
+static FleetTe te;
+#endif
+
+#if FLEET_RENDER_TASK
+// LVGL runs in its own FreeRTOS task (-D FLEET_RENDER_TASK=1), loop() only
+// forwards console commands to it
+static FleetRenderTask render_task;
 
-// LVGL tick callback using Arduino millis()
-static uint32_t my_tick(void)
+static void console_command(void *ctx)
 {
-    return millis();
+    display.handleCommand((int)(intptr_t)ctx);
 }
-
-// Define the size of our buffer. 1/10th of the screen.
-#define DRAW_BUF_SIZE (LCD_WIDTH * LCD_HEIGHT / 10) // Size in *pixels*
+#endif
 
 // --- Step 4: The "Expediter" (Flush Callback) ---
-// This is the "recipe" from the bitbank examples.
-void my_disp_flush(lv_display_t *disp_ptr, const lv_area_t *area, uint8_t *px_map)
-{
-    BB_SPI_LCD *lcd = (BB_SPI_LCD *)lv_display_get_user_data(disp_ptr);
-
-    const int w = area->x2 - area->x1 + 1;
-    const int h = area->y2 - area->y1 + 1;
-
-    // Position the LCD window and push the pixel block row-by-row
-    lcd->setAddrWindow(area->x1, area->y1, w, h);
-    uint16_t *src = (uint16_t *)px_map;
-    for (int y = 0; y < h; y++)
-    {
-        for (int x = 0; x < w; x++)
-        {
-            dma_buf[x] = __builtin_bswap16(src[x]);
-        }
-        lcd->pushPixels(dma_buf, w, DRAW_TO_LCD | DRAW_WITH_DMA);
-        src += w;
-    }
-
-    lv_display_flush_ready(disp_ptr);
-}
+// See FleetDisplay::flushCb(): swapped pixels go straight to the DMA,
+// legacy ones are converted strip by strip, and lv_display_flush_ready()
+// is called from the DMA-done event.
 
 // --- Step 5: A simple "Hello World" UI ---
+// The screen lives in lib/FleetUi so the host build renders the same thing
 void create_hello_world_ui()
 {
-    lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0x222222), LV_PART_MAIN);
-
-    lv_obj_t *label = lv_label_create(scr);
-    // Use LVGL's formatting helper and include the LVGL version string
-    lv_label_set_text_fmt(label, "Hello, LVGL %s\n\nThis is the MANUAL PIN\n'recipe' test.", lv_version_info());
-    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, LV_PART_MAIN);
-    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
+    fleet_ui_hello_world("This is the MANUAL PIN\n'recipe' test.");
 }
 
 void setup()
@@ -111,8 +98,8 @@ void setup()
 
     // 1. Initialize the "Chef" (LVGL)
     lv_init();
-    // Provide LVGL with a tick source using Arduino millis()
-    lv_tick_set_cb(my_tick);
+    // Provide LVGL with a tick source (Arduino millis())
+    lv_tick_set_cb(fleet_millis);
     Serial.println("LVGL (lv_init) done.");
 
     // 2. Initialize the "F1 Car" (hardware driver)
@@ -124,70 +111,70 @@ void setup()
     
     // lcd.setRotation(270); // Landscape mode // HW rotation not working on this device?
     Serial.println("Display Driver (bb_spi_lcd) manually initialized.");
-    int w = 320; //lcd.width();  // This should now be 320
-    int h = 480; //lcd.height(); // This should now be 480
-    Serial.printf("LCD dimensions: %d w x %d h\n", w, h);
-
-    //if (w != 480 || h != 320) {
-        //Serial.println("CRITICAL: LCD dimensions are incorrect! Check rotation?");
-        // Note: DRAW_BUF_SIZE is based on 320x480, but rotation
-        // is handled by LVGL. The buffer size should be correct
-        // regardless of rotation.
-    //}
-
-    // 3. Allocate the DMA row buffer (example calls this dma_buf)
-    // We do this *before* allocating the LVGL buffer
-    dma_buf = (uint16_t *)heap_caps_malloc(sizeof(uint16_t) * w, MALLOC_CAP_DMA);
-    if (dma_buf == nullptr)
-    {
-        // Fallback: use the static buffer
-        dma_buf = dma_buf_static;
-        Serial.println("Warning: DMA buffer allocation failed, using static fallback");
-    } else {
-        Serial.printf("DMA row buffer allocated (%d bytes)\n", sizeof(uint16_t) * w);
-    }
 
-    // 4. Allocate LVGL draw buffer in PSRAM
-    uint32_t iSize = DRAW_BUF_SIZE; // Use our 320x480-based define
-    buf1 = (lv_color_t *)heap_caps_malloc(iSize, MALLOC_CAP_SPIRAM);
-    if (buf1 == nullptr)
+    // 3. Glue LVGL to the LCD. lcd.width()/height() are wrong with the
+    // manual begin(), so pass the panel size explicitly.
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.panel = "AXS15231B"; // full-width windows only (see fleet_panel.h)
+    if (!display.begin(&lcd, cfg))
     {
-        Serial.println("FATAL ERROR: Failed to allocate draw buffer in PSRAM!");
         while (1);
     }
-    Serial.printf("LVGL draw buffer allocated in PSRAM (%d bytes)\n", iSize);
-
-    // 5. Create and configure the LVGL display (v9 API)
-    disp = lv_display_create(w, h); // Use dimensions *after* rotation
-    if (disp == nullptr)
+    Serial.println("LVGL display created and configured.");
+    // Boot splash, pre-swapped: straight from flash to the panel, no LVGL
+    display.pushImage(&fleet_img_splash);
+#if FLEET_TE_PIN >= 0
+    if (!te.beginGpio(FLEET_TE_PIN))
     {
-        Serial.println("FATAL ERROR: lv_display_create failed");
+        Serial.println("FATAL ERROR: Failed to attach the TE interrupt");
         while (1);
     }
-
-    // This is the correct v9.4+ buffer init "recipe"
-    if (lv_draw_buf_init(&disp_buf, w, iSize / (sizeof(uint16_t) * w), LV_COLOR_FORMAT_NATIVE, LV_STRIDE_AUTO, buf1, iSize) != LV_RESULT_OK) {
-        Serial.println("FATAL ERROR: lv_draw_buf_init failed");
-        while(1);
+    display.syncToTe(&te);
+#elif FLEET_TE_SIM_HZ > 0
+    if (!te.beginSimulated(1000000 / FLEET_TE_SIM_HZ))
+    {
+        Serial.println("FATAL ERROR: Failed to start the simulated TE timer");
+        while (1);
     }
-    Serial.println("LVGL draw buffer initialized.");
-
-    lv_display_set_draw_buffers(disp, &disp_buf, nullptr);
-    lv_display_set_flush_cb(disp, my_disp_flush);
-    lv_display_set_user_data(disp, &lcd); // "Glue" the lcd object to the display
-    lv_display_set_color_format(disp, LV_COLOR_FORMAT_NATIVE);
-    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
-    lv_display_set_default(disp);
-    Serial.println("LVGL display created and configured.");
+    display.syncToTe(&te);
+#endif
+    // Images and fonts from the "assets" partition, as "A:..." in LVGL.
+    // Without a packed image this only logs: the UI uses built-in fonts.
+    fleet_assets.mountPartition();
+    fleet_asset_fs_begin();
 
-    // 6. Create our simple UI
+    // 4. Create our simple UI
     create_hello_world_ui();
+#if FLEET_RENDER_TASK
+    // 5. Hand LVGL over to its own task. From here on, other tasks go
+    // through render_task.post() or render_task.lock()/unlock().
+    if (!render_task.begin(&display))
+    {
+        while (1);
+    }
+    Serial.println("UI created. Render task running.");
+#else
     Serial.println("UI created. Starting loop.");
+#endif
 }
 
 void loop()
 {
     // --- Step 7: Keep LVGL running ---
-    lv_timer_handler();
-    delay(5);
-}
\ No newline at end of file
+#if FLEET_RENDER_TASK
+    const int c = fleet_console_read();
+    if (c >= 0)
+    {
+        render_task.post(console_command, (void *)(intptr_t)c);
+    }
+    delay(20);
+#else
+    // Serial console: 'm' metrics, 'r' reset, 't' trace (profile builds)
+    display.handleCommand(fleet_console_read());
+    // Runs LVGL, then sleeps until its next timer (no fixed delay(5)).
+    // Touch/audio handlers call display.scheduler().wake() to cut it short.
+    display.runOnce();
+#endif
+}
@@ -0,0 +1,83 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: ex02_bench_scenes
+ * Target:  Guition S3 3.5" QSPI (JC3248W535)
+ * Goal:    Time full-screen frames of typical voice-assistant screens
+ * (large text, gradients, spinners) with one or two LVGL software
+ * draw units, to see what the second core buys us.
+ *
+ *          pio run -e guition_3_5_ex02_bench_scenes -t upload -t monitor
+ *          pio run -e guition_3_5_ex02_bench_scenes_2units -t upload -t monitor
+ *
+ * Each run prints one CSV line per scene, the text scenes with and
+ * without the PSRAM glyph cache (fleet_font_cache.h), then the widget churn table
+ * (chat bubbles / list rows created vs recycled, see fleet_ui_pool.h)
+ * and the style lookup table (compare with the _style_cache env); send
+ * 'b' to run it again. The scenes live in lib/FleetUi
+ * (fleet_ui_bench), so the host builds (native_bench_scenes*,
+ * native_bench_ui_pool) run exactly the same frames.
+ */
+
+#include <Arduino.h>
+#include "lvgl.h"
+
+#include <bb_spi_lcd.h>
+#include "fleet_display.h"
+#include "fleet_port.h"
+#include "fleet_ui_bench.h"
+
+// Same panel setup as ex01_hello_lvgl (manual pins, portrait)
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+
+#define BENCH_FRAMES 60
+#define BENCH_WARMUP 5
+#define CHURN_ITEMS 100
+#define STYLE_RUNS 20
+
+static BB_SPI_LCD lcd;
+static FleetDisplay display;
+
+void setup()
+{
+    Serial.begin(115200);
+    delay(2000);
+    Serial.println("--- Guition S3 3.5\" LVGL draw-unit benchmark ---");
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+
+    lcd.begin(31, 0, 40000000, 45, 8, -1, 1);
+
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.panel = "AXS15231B"; // full-width windows only (see fleet_panel.h)
+    cfg.log_every = 0; // the benchmark prints its own numbers
+    if (!display.begin(&lcd, cfg))
+    {
+        while (1);
+    }
+
+    fleet_ui_bench_all(BENCH_FRAMES, BENCH_WARMUP);
+    fleet_ui_bench_glyphs_all(BENCH_FRAMES, BENCH_WARMUP);
+    fleet_ui_bench_churn_all(CHURN_ITEMS);
+    fleet_ui_bench_styles_all(STYLE_RUNS);
+}
+
+void loop()
+{
+    const int c = fleet_console_read();
+    if (c == 'b')
+    {
+        fleet_ui_bench_all(BENCH_FRAMES, BENCH_WARMUP);
+        fleet_ui_bench_glyphs_all(BENCH_FRAMES, BENCH_WARMUP);
+        fleet_ui_bench_churn_all(CHURN_ITEMS);
+        fleet_ui_bench_styles_all(STYLE_RUNS);
+    }
+    else
+    {
+        display.handleCommand(c);
+    }
+    display.runOnce();
+}
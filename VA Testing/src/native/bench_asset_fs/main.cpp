@@ -0,0 +1,432 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_asset_fs
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    Check the asset partition path end to end on the host: pack a
+ * directory with tools/fleet_asset_pack.py, mount the image from a file
+ * (mmap, like esp_partition_mmap on the device) and read it back through
+ * FleetAssetPack, LVGL's lv_fs ("A:") and a zero-copy image descriptor:
+ *
+ *   - the image and every file pass their CRCs; a flipped byte fails
+ *   - lv_fs read/seek/tell/dir return the packed files' bytes and names
+ *   - an RGB565 .bin image draws the same pixels from the zero-copy
+ *     descriptor and from "A:" through the bin decoder
+ *
+ * and prints lv_fs read throughput against reading the mapping directly.
+ *
+ * Run:     pio run -e native_bench_asset_fs -t exec
+ *          .pio/build/native_bench_asset_fs/program --image assets.bin
+ *
+ * --image checks an existing image instead (CRCs and lv_fs only). Needs
+ * python3 on the PATH otherwise. Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "lvgl.h"
+
+#include "fleet_asset_fs.h"
+#include "fleet_asset_pack.h"
+#include "fleet_check.h"
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+#define IMG_SIZE 64
+#define IMG_X 10
+#define IMG_Y 20
+#define BLOB_BYTES (100 * 1024)
+#define READ_PASSES 200
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+// The files to pack, by name
+struct SourceFile
+{
+    const char *name;
+    std::vector<uint8_t> data;
+};
+
+static uint16_t checker_px(int x, int y)
+{
+    return ((x / 8) + (y / 8)) % 2 ? 0xF800 : 0x001F; // red / blue
+}
+
+// An LVGL v9 .bin image: 12-byte header, then RGB565 rows
+static std::vector<uint8_t> checker_bin()
+{
+    lv_image_header_t h;
+    memset(&h, 0, sizeof(h));
+    h.magic = LV_IMAGE_HEADER_MAGIC;
+    h.cf = LV_COLOR_FORMAT_RGB565;
+    h.w = IMG_SIZE;
+    h.h = IMG_SIZE;
+    h.stride = IMG_SIZE * 2;
+    std::vector<uint8_t> out(sizeof(h) + IMG_SIZE * IMG_SIZE * 2);
+    memcpy(out.data(), &h, sizeof(h));
+    uint16_t *px = (uint16_t *)(out.data() + sizeof(h));
+    for (int y = 0; y < IMG_SIZE; y++)
+    {
+        for (int x = 0; x < IMG_SIZE; x++)
+        {
+            px[y * IMG_SIZE + x] = checker_px(x, y);
+        }
+    }
+    return out;
+}
+
+static std::vector<SourceFile> make_sources()
+{
+    std::vector<SourceFile> files;
+    const char *hello = "Hello from the asset partition\n";
+    files.push_back({"hello.txt", std::vector<uint8_t>(hello, hello + strlen(hello))});
+    files.push_back({"img/checker.bin", checker_bin()});
+    const char *note = "nested";
+    files.push_back({"img/icons/note.txt", std::vector<uint8_t>(note, note + strlen(note))});
+    std::vector<uint8_t> blob(BLOB_BYTES);
+    uint32_t seed = 12345;
+    for (uint8_t &b : blob)
+    {
+        seed = seed * 1103515245u + 12345u;
+        b = (uint8_t)(seed >> 16);
+    }
+    files.push_back({"blob.bin", blob});
+    return files;
+}
+
+static bool write_tree(const std::string &root, const std::vector<SourceFile> &files)
+{
+    for (const SourceFile &f : files)
+    {
+        const std::string path = root + "/" + f.name;
+        for (size_t i = root.size() + 1; i < path.size(); i++)
+        {
+            if (path[i] == '/')
+            {
+                mkdir(path.substr(0, i).c_str(), 0755);
+            }
+        }
+        FILE *fp = fopen(path.c_str(), "wb");
+        if (fp == nullptr || fwrite(f.data.data(), 1, f.data.size(), fp) != f.data.size())
+        {
+            return false;
+        }
+        fclose(fp);
+    }
+    return true;
+}
+
+// Pack and mount a temporary tree; fills `files` with what went in
+static bool pack_sources(std::vector<SourceFile> &files, std::string &image)
+{
+    char dir[] = "/tmp/fleet_assets_XXXXXX";
+    if (mkdtemp(dir) == nullptr)
+    {
+        return false;
+    }
+    const std::string root = std::string(dir) + "/assets";
+    mkdir(root.c_str(), 0755);
+    files = make_sources();
+    if (!write_tree(root, files))
+    {
+        return false;
+    }
+    image = std::string(dir) + "/assets.bin";
+    const std::string cmd = "python3 tools/fleet_asset_pack.py \"" + root + "\" -o \"" + image + "\"";
+    printf("%s\n", cmd.c_str());
+    return system(cmd.c_str()) == 0;
+}
+
+static void check_pack(const std::vector<SourceFile> &files)
+{
+    printf("FleetAssetPack: %d files, %u bytes\n", fleet_assets.count(), (unsigned)fleet_assets.size());
+    check(fleet_assets.verify(), "image CRC");
+    for (int i = 0; i < fleet_assets.count(); i++)
+    {
+        const FleetAssetEntry *e = fleet_assets.entry(i);
+        check(fleet_assets.verify(e), "file CRC");
+        check((e->offset % FLEET_ASSET_ALIGN) == 0, "file not 16-byte aligned");
+        check(fleet_assets.find(e->name) == e, "find() by name");
+    }
+    check(fleet_assets.find("nope.txt") == nullptr && fleet_assets.find("img") == nullptr, "find() of a missing name");
+    for (const SourceFile &f : files)
+    {
+        const FleetAssetEntry *e = fleet_assets.find(f.name);
+        check(e != nullptr && e->size == f.data.size() && memcmp(fleet_assets.data(e), f.data.data(), e->size) == 0,
+              "packed file differs from its source");
+    }
+
+    // A flipped byte must fail the CRC; a bad magic must not mount
+    std::vector<uint8_t> copy(fleet_assets.image(), fleet_assets.image() + fleet_assets.size());
+    FleetAssetPack other;
+    check(other.mount(copy.data(), copy.size()) && other.verify(), "mount() of an in-memory copy");
+    copy[copy.size() - 1] ^= 0x40;
+    check(!other.verify(), "flipped byte passed the CRC");
+    copy[0] ^= 0xFF;
+    check(!other.mount(copy.data(), copy.size()), "bad magic mounted");
+    check(!other.mount(copy.data(), 8), "truncated image mounted");
+}
+
+static std::vector<uint8_t> fs_read_all(const char *path)
+{
+    std::vector<uint8_t> out;
+    lv_fs_file_t f;
+    if (lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK)
+    {
+        return out;
+    }
+    uint8_t buf[1000];
+    uint32_t n = 0;
+    while (lv_fs_read(&f, buf, sizeof(buf), &n) == LV_FS_RES_OK && n > 0)
+    {
+        out.insert(out.end(), buf, buf + n);
+    }
+    lv_fs_close(&f);
+    return out;
+}
+
+static std::vector<std::string> fs_list(const char *path)
+{
+    std::vector<std::string> out;
+    lv_fs_dir_t d;
+    if (lv_fs_dir_open(&d, path) != LV_FS_RES_OK)
+    {
+        return out;
+    }
+    char fn[64];
+    while (lv_fs_dir_read(&d, fn, sizeof(fn)) == LV_FS_RES_OK && fn[0] != '\0')
+    {
+        out.push_back(fn);
+    }
+    lv_fs_dir_close(&d);
+    return out;
+}
+
+static void check_fs(const std::vector<SourceFile> &files)
+{
+    printf("lv_fs drive %c:\n", FLEET_ASSET_FS_LETTER);
+    char path[64];
+    for (const SourceFile &f : files)
+    {
+        snprintf(path, sizeof(path), "%c:%s", FLEET_ASSET_FS_LETTER, f.name);
+        check(fs_read_all(path) == f.data, "lv_fs read differs from the source");
+        snprintf(path, sizeof(path), "%c:/%s", FLEET_ASSET_FS_LETTER, f.name);
+        check(fs_read_all(path) == f.data, "lv_fs read with a leading '/'");
+    }
+
+    lv_fs_file_t f;
+    check(lv_fs_open(&f, "A:missing.bin", LV_FS_MODE_RD) != LV_FS_RES_OK, "opened a missing file");
+    check(lv_fs_open(&f, "A:hello.txt", LV_FS_MODE_WR) != LV_FS_RES_OK, "opened for writing");
+    if (lv_fs_open(&f, "A:blob.bin", LV_FS_MODE_RD) == LV_FS_RES_OK)
+    {
+        const FleetAssetEntry *e = fleet_assets.find("blob.bin");
+        uint32_t pos = 0, n = 0;
+        uint8_t b[4];
+        check(lv_fs_seek(&f, 1000, LV_FS_SEEK_SET) == LV_FS_RES_OK && lv_fs_tell(&f, &pos) == LV_FS_RES_OK &&
+                  pos == 1000,
+              "seek/tell SET");
+        check(lv_fs_read(&f, b, 4, &n) == LV_FS_RES_OK && n == 4 && memcmp(b, fleet_assets.data(e) + 1000, 4) == 0,
+              "read after seek");
+        check(lv_fs_seek(&f, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(&f, &pos) == LV_FS_RES_OK &&
+                  pos == e->size,
+              "seek END");
+        check(lv_fs_read(&f, b, 4, &n) == LV_FS_RES_OK && n == 0, "read at EOF");
+        lv_fs_close(&f);
+    }
+    else
+    {
+        check(false, "open A:blob.bin");
+    }
+
+    const std::vector<std::string> root = fs_list("A:");
+    const std::vector<std::string> img = fs_list("A:img");
+    printf("  A: ->");
+    for (const std::string &s : root)
+    {
+        printf(" %s", s.c_str());
+    }
+    printf("\n  A:img ->");
+    for (const std::string &s : img)
+    {
+        printf(" %s", s.c_str());
+    }
+    printf("\n");
+    check(root == std::vector<std::string>({"blob.bin", "hello.txt", "/img"}), "listing of A:");
+    check(img == std::vector<std::string>({"checker.bin", "/icons"}), "listing of A:img");
+    lv_fs_dir_t d;
+    check(lv_fs_dir_open(&d, "A:nodir") != LV_FS_RES_OK, "opened a missing directory");
+}
+
+// Draw `src` at IMG_X/IMG_Y on a black screen; count checker mismatches
+static int draw_mismatches(const void *src)
+{
+    lv_obj_t *scr = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_t *img = lv_image_create(scr);
+    lv_image_set_src(img, src);
+    lv_obj_set_pos(img, IMG_X, IMG_Y);
+    lv_screen_load(scr);
+    lv_refr_now(nullptr);
+
+    int bad = 0;
+    for (int y = 0; y < IMG_SIZE; y++)
+    {
+        for (int x = 0; x < IMG_SIZE; x++)
+        {
+            bad += panel.pixel(IMG_X + x, IMG_Y + y) != checker_px(x, y);
+        }
+    }
+    bad += panel.pixel(IMG_X + IMG_SIZE, IMG_Y) != 0; // nothing drawn past the edge
+    return bad;
+}
+
+static void check_image()
+{
+    printf("Images:\n");
+    lv_image_dsc_t dsc;
+    const FleetAssetEntry *e = fleet_assets.find("img/checker.bin");
+    if (!fleet_asset_image("img/checker.bin", &dsc) || e == nullptr)
+    {
+        check(false, "fleet_asset_image() of img/checker.bin");
+        return;
+    }
+    check(dsc.data == fleet_assets.data(e) + sizeof(lv_image_header_t), "descriptor doesn't point into the mapping");
+    check(dsc.header.w == IMG_SIZE && dsc.header.h == IMG_SIZE && dsc.header.cf == LV_COLOR_FORMAT_RGB565,
+          "descriptor header");
+    check(!fleet_asset_image("hello.txt", &dsc), "fleet_asset_image() took a text file");
+
+    check(fleet_asset_image("A:img/checker.bin", &dsc) && dsc.data == fleet_assets.data(e) + sizeof(lv_image_header_t),
+          "fleet_asset_image() with the drive letter");
+    const int direct = draw_mismatches(&dsc);
+    const int via_fs = draw_mismatches("A:img/checker.bin");
+    printf("  zero-copy descriptor: %d bad pixels, A: path: %d bad pixels\n", direct, via_fs);
+    check(direct == 0, "zero-copy image drew wrong pixels");
+    check(via_fs == 0, "A: image drew wrong pixels");
+}
+
+static void bench_reads()
+{
+    const FleetAssetEntry *e = fleet_assets.find("blob.bin");
+    if (e == nullptr)
+    {
+        return;
+    }
+    std::vector<uint8_t> buf(4096);
+    uint32_t sum = 0;
+
+    uint32_t t0 = fleet_micros();
+    for (int pass = 0; pass < READ_PASSES; pass++)
+    {
+        lv_fs_file_t f;
+        lv_fs_open(&f, "A:blob.bin", LV_FS_MODE_RD);
+        uint32_t n = 0;
+        while (lv_fs_read(&f, buf.data(), (uint32_t)buf.size(), &n) == LV_FS_RES_OK && n > 0)
+        {
+            sum += buf[n - 1];
+        }
+        lv_fs_close(&f);
+    }
+    const uint32_t fs_us = fleet_micros() - t0;
+
+    t0 = fleet_micros();
+    for (int pass = 0; pass < READ_PASSES; pass++)
+    {
+        const uint8_t *p = fleet_assets.data(e);
+        for (uint32_t off = 0; off < e->size; off += (uint32_t)buf.size())
+        {
+            const uint32_t n = e->size - off < buf.size() ? e->size - off : (uint32_t)buf.size();
+            memcpy(buf.data(), p + off, n);
+            sum += buf[n - 1];
+        }
+    }
+    const uint32_t direct_us = fleet_micros() - t0;
+
+    const double mb = (double)e->size * READ_PASSES / (1024.0 * 1024.0);
+    printf("Reads of %u bytes x %d, 4 KB chunks (checksum %u):\n", (unsigned)e->size, READ_PASSES, (unsigned)sum);
+    printf("  lv_fs      %8.1f MB/s\n", mb / (fs_us ? fs_us : 1) * 1e6);
+    printf("  mapping    %8.1f MB/s\n", mb / (direct_us ? direct_us : 1) * 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    const char *image_arg = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--image") == 0 && i + 1 < argc)
+        {
+            image_arg = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--image assets.bin]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<SourceFile> files;
+    std::string image;
+    if (image_arg != nullptr)
+    {
+        image = image_arg;
+    }
+    else if (!pack_sources(files, image))
+    {
+        printf("FATAL ERROR: packing the test assets failed\n");
+        return 1;
+    }
+    if (!fleet_assets.mountFile(image.c_str()))
+    {
+        printf("FATAL ERROR: cannot mount %s\n", image.c_str());
+        return 1;
+    }
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+    fleet_asset_fs_begin();
+
+    if (image_arg != nullptr)
+    {
+        // Whatever is in it: CRCs, and lv_fs returns the mapped bytes
+        printf("FleetAssetPack: %d files, %u bytes\n", fleet_assets.count(), (unsigned)fleet_assets.size());
+        check(fleet_assets.verify(), "image CRC");
+        for (int i = 0; i < fleet_assets.count(); i++)
+        {
+            const FleetAssetEntry *e = fleet_assets.entry(i);
+            char path[64];
+            snprintf(path, sizeof(path), "%c:%s", FLEET_ASSET_FS_LETTER, e->name);
+            const std::vector<uint8_t> got = fs_read_all(path);
+            check(fleet_assets.verify(e), e->name);
+            check(got.size() == e->size && memcmp(got.data(), fleet_assets.data(e), e->size) == 0, e->name);
+        }
+    }
+    else
+    {
+        check_pack(files);
+        check_fs(files);
+        check_image();
+    }
+    bench_reads();
+
+    fleet_assets.unmount();
+    return fleet_check_exit();
+}
@@ -0,0 +1,78 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_buf_size
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check fleet_draw_buf_size() at run time for the configurations
+ * FleetDisplay::begin() actually asks it for:
+ *
+ *   - ex01: portrait 320 x 480, PARTIAL, 1/10 screen
+ *   - ex01_hello_lvgl_copilot: 320 x 480, rotated in the flush, one
+ *     full-screen buffer
+ *   - DIRECT mode (FLEET_DIRECT_MODE=1): the whole 320 x 480 frame
+ *
+ * For each: rows, pixels and bytes as expected, bytes = 2 x pixels (the
+ * pixels-as-bytes bug gave bytes = pixels), whole rows only, never more
+ * than 1/divisor of the screen, and a size lv_draw_buf_init() accepts
+ * with lv_conf.h's LV_DRAW_BUF_ALIGN. Also the one-row minimum.
+ *
+ * Run:     pio run -e native_bench_buf_size -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+
+#include "fleet_buf_size.h"
+#include "fleet_check.h"
+
+// lv_conf.h: LV_DRAW_BUF_ALIGN (buffer start and size), and
+// LV_DRAW_BUF_STRIDE_ALIGN (row stride), in bytes
+#define DRAW_BUF_ALIGN 4
+#define DRAW_BUF_STRIDE_ALIGN 1
+
+struct Case
+{
+    const char *name;
+    uint32_t width, height, divisor;
+    uint32_t rows, pixels, bytes; // expected
+};
+
+static const Case cases[] = {
+    {"ex01 portrait", 320, 480, 10, 48, 15360, 30720},
+    {"copilot rotation 270", 320, 480, 1, 480, 153600, 307200},
+    {"DIRECT full frame", 320, 480, 1, 480, 153600, 307200},
+    {"one row minimum", 320, 5, 10, 1, 320, 640},
+};
+
+static void check(bool ok, const Case &c, const char *what)
+{
+    checkf(ok, "%s: %s", c.name, what);
+}
+
+int main()
+{
+    for (const Case &c : cases)
+    {
+        // Through volatiles, so this is the run-time path, not the
+        // static_asserts in the header again
+        volatile uint32_t w = c.width, h = c.height, div = c.divisor;
+        const FleetDrawBufSize s = fleet_draw_buf_size(w, h, div);
+        printf("%-20s %3u x %3u / %2u: %3u rows, %6u px, %6u bytes\n", c.name, (unsigned)c.width,
+               (unsigned)c.height, (unsigned)c.divisor, (unsigned)s.rows, (unsigned)s.pixels.value,
+               (unsigned)s.bytes.value);
+
+        check(s.width == c.width, c, "width");
+        check(s.rows == c.rows, c, "rows");
+        check(s.pixels.value == c.pixels, c, "pixels");
+        check(s.bytes.value == c.bytes, c, "bytes");
+        check(s.bytes.value == s.pixels.value * 2, c, "bytes isn't 2 x pixels");
+        check(s.pixels.value == s.width * s.rows, c, "pixels isn't whole rows");
+        check(s.rows >= 1, c, "no rows");
+        check(s.rows == 1 || s.pixels.value <= c.width * c.height / c.divisor, c, "more than 1/divisor of the screen");
+        check(s.bytes.value % DRAW_BUF_ALIGN == 0, c, "size not LV_DRAW_BUF_ALIGN aligned");
+        check((s.width * FLEET_BYTES_PER_PIXEL) % DRAW_BUF_STRIDE_ALIGN == 0, c, "stride not aligned");
+        check(fleet_pixels(s.bytes).value == s.pixels.value, c, "bytes -> pixels round trip");
+    }
+
+    return fleet_check_exit();
+}
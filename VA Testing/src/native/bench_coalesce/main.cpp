@@ -0,0 +1,166 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_coalesce
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check FleetCoalescer on invalidation patterns our screens
+ * produce, and show what it saves under the per-transaction cost model:
+ * every input pixel is still covered, the modelled cost never goes up,
+ * and nothing is drawn outside the bounding box of the input.
+ *
+ * Run:     pio run -e native_bench_coalesce -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "fleet_check.h"
+#include "fleet_coalesce.h"
+
+#define SCREEN_W 320
+#define SCREEN_H 480
+#define MAX_RECTS 32 // LVGL's LV_INV_BUF_SIZE
+
+struct Pattern
+{
+    const char *name;
+    FleetRect rects[MAX_RECTS];
+    int n;
+};
+
+static void add(Pattern &p, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    p.rects[p.n++] = {x, y, x + w - 1, y + h - 1};
+}
+
+// Every pixel of `in` is inside some rect of `out`, and `out` stays
+// within the bounding box of `in`
+static bool covers(const FleetRect *in, int n_in, const FleetRect *out, int n_out)
+{
+    std::vector<uint8_t> mask(SCREEN_W * SCREEN_H, 0);
+    FleetRect box = in[0];
+    for (int i = 0; i < n_in; i++)
+    {
+        for (int32_t y = in[i].y1; y <= in[i].y2; y++)
+        {
+            memset(&mask[y * SCREEN_W + in[i].x1], 1, in[i].x2 - in[i].x1 + 1);
+        }
+        box.x1 = in[i].x1 < box.x1 ? in[i].x1 : box.x1;
+        box.y1 = in[i].y1 < box.y1 ? in[i].y1 : box.y1;
+        box.x2 = in[i].x2 > box.x2 ? in[i].x2 : box.x2;
+        box.y2 = in[i].y2 > box.y2 ? in[i].y2 : box.y2;
+    }
+    for (int i = 0; i < n_out; i++)
+    {
+        const FleetRect &r = out[i];
+        if (r.x1 < box.x1 || r.y1 < box.y1 || r.x2 > box.x2 || r.y2 > box.y2)
+        {
+            return false;
+        }
+        for (int32_t y = r.y1; y <= r.y2; y++)
+        {
+            memset(&mask[y * SCREEN_W + r.x1], 0, r.x2 - r.x1 + 1);
+        }
+    }
+    for (uint8_t m : mask)
+    {
+        if (m)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void run(FleetCoalescer &co, const Pattern &p, int expect_max_out = MAX_RECTS, int expect_min_out = 1)
+{
+    FleetRect out[MAX_RECTS];
+    memcpy(out, p.rects, sizeof(FleetRect) * p.n);
+
+    const uint64_t cost_in = co.cost(p.rects, p.n);
+    const int n = co.run(out, p.n);
+    const uint64_t cost_out = co.cost(out, n);
+
+    printf("  %-22s %3d -> %2d areas, %8u -> %8u bytes (-%2u%%)\n", p.name, p.n, n, (unsigned)cost_in,
+           (unsigned)cost_out, (unsigned)((cost_in - cost_out) * 100 / cost_in));
+    check(n >= 1 && n <= p.n, "area count out of range");
+    check(cost_out <= cost_in, "modelled cost went up");
+    check(covers(p.rects, p.n, out, n), "output does not cover the input (or leaves its bounding box)");
+    check(n <= expect_max_out, "too few merges");
+    check(n >= expect_min_out, "merged areas that should stay apart");
+}
+
+int main()
+{
+    FleetCoalescer co(FLEET_TXN_OVERHEAD_BYTES);
+    printf("Coalescing at %u overhead bytes per transaction, %dx%d screen:\n", (unsigned)FLEET_TXN_OVERHEAD_BYTES,
+           SCREEN_W, SCREEN_H);
+
+    // Status-bar icons: small neighbours on one row -> one strip
+    Pattern icons = {"status_icons", {}, 0};
+    for (int i = 0; i < 8; i++)
+    {
+        add(icons, 8 + i * 24, 4, 16, 16);
+    }
+    run(co, icons, 1);
+
+    // Spinner arcs: LVGL invalidates each moving arc's box separately
+    Pattern spinners = {"spinner_arcs", {}, 0};
+    add(spinners, 50, 130, 220, 24);
+    add(spinners, 50, 326, 220, 24);
+    add(spinners, 50, 154, 24, 172);
+    add(spinners, 246, 154, 24, 172);
+    add(spinners, 85, 165, 150, 150);
+    run(co, spinners);
+
+    // Two far corners: the bounding box would be most of the screen
+    Pattern corners = {"far_corners", {}, 0};
+    add(corners, 0, 0, 40, 20);
+    add(corners, SCREEN_W - 40, SCREEN_H - 20, 40, 20);
+    run(co, corners, 2, 2);
+
+    // Overlapping redraws of one widget -> one area
+    Pattern overlap = {"overlapping", {}, 0};
+    add(overlap, 100, 100, 60, 60);
+    add(overlap, 110, 110, 60, 60);
+    add(overlap, 120, 120, 60, 60);
+    add(overlap, 130, 100, 40, 30);
+    run(co, overlap, 1);
+
+    // Blinking cursor far below a clock tick in the status bar
+    Pattern cursor = {"cursor_and_status", {}, 0};
+    add(cursor, 280, 4, 36, 16);
+    add(cursor, 30, 400, 2, 20);
+    run(co, cursor, 2, 2);
+
+    // Full screen plus stragglers inside it -> one area
+    Pattern full = {"full_screen", {}, 0};
+    add(full, 0, 0, SCREEN_W, SCREEN_H);
+    add(full, 10, 10, 20, 20);
+    add(full, 200, 300, 50, 8);
+    run(co, full, 1);
+
+    // Random small areas, as a busy screen might produce; fixed seed
+    srand(1234);
+    for (int round = 0; round < 4; round++)
+    {
+        Pattern rnd = {"random_small", {}, 0};
+        const int n = 8 + round * 8;
+        for (int i = 0; i < n; i++)
+        {
+            const int32_t w = 4 + rand() % 40, h = 4 + rand() % 40;
+            add(rnd, rand() % (SCREEN_W - w), rand() % (SCREEN_H - h), w, h);
+        }
+        run(co, rnd);
+    }
+
+    const FleetCoalesceStats &cs = co.stats();
+    printf("Total: %u runs, %u -> %u transactions, %u -> %u bus bytes, %u -> %u pixels\n", (unsigned)cs.runs,
+           (unsigned)cs.areas_in, (unsigned)cs.areas_out, (unsigned)cs.cost_in, (unsigned)cs.cost_out,
+           (unsigned)cs.px_in, (unsigned)cs.px_out);
+
+    return fleet_check_exit();
+}
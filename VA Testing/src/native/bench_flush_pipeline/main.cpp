@@ -0,0 +1,209 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_flush_pipeline
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Step FleetFlushPipeline's state machine one DMA completion at
+ * a time on FleetMockTransport, and check:
+ *
+ *   - ready fires once per area, only after its LAST push completes
+ *   - zero copy pushes the caller's own pointer, split at setMaxPush()
+ *   - the copy path alternates the two DMA buffers, tags every push
+ *     BUFFER, never refills a buffer still in flight (the mock reads
+ *     pixels at completion time) and swaps correctly
+ *   - flushRotated() cuts the window into bands of whole strip rows that
+ *     add up to the reference rotation
+ *   - begin(), flushCopy() and flushRotated() reject configurations that
+ *     used to hang (no buffers, a strip shorter than a row)
+ *
+ * Run:     pio run -e native_bench_flush_pipeline -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "fleet_check.h"
+#include "fleet_flush_pipeline.h"
+#include "fleet_mock_transport.h"
+#include "fleet_rotate.h"
+
+static int ready_calls = 0;
+
+static void on_ready(void *ctx)
+{
+    (void)ctx;
+    ready_calls++;
+}
+
+static std::vector<uint16_t> pattern(size_t n)
+{
+    std::vector<uint16_t> px(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        px[i] = (uint16_t)(i * 2654435761u >> 7);
+    }
+    return px;
+}
+
+static uint16_t swapped(uint16_t v)
+{
+    return (uint16_t)(v << 8 | v >> 8);
+}
+
+// Complete the pushes still in flight one at a time; ready must stay
+// silent until the one tagged LAST
+static void complete_checking_ready(FleetMockTransport &mock, FleetFlushPipeline &pipe, int ready_before)
+{
+    while (mock.inFlight() > 0)
+    {
+        check(ready_calls == ready_before, "ready fired before the last push completed");
+        check(pipe.state() == FleetFlushPipeline::FLUSHING, "pipeline went IDLE before the last push");
+        mock.completeOne();
+    }
+    check(ready_calls == ready_before + 1, "ready didn't fire exactly once");
+    check(pipe.state() == FleetFlushPipeline::IDLE, "pipeline not IDLE after the last push");
+    check(!mock.completed.empty() && (mock.completed.back().tag & FLEET_TAG_LAST), "last push not tagged LAST");
+}
+
+static void check_zero_copy()
+{
+    FleetMockTransport mock;
+    FleetFlushPipeline pipe;
+    check(pipe.begin(&mock, nullptr, nullptr, 0), "begin() without buffers (zero copy only)");
+    const int w = 40, h = 10;
+    const std::vector<uint16_t> px = pattern(w * h);
+
+    // One push, straight from the caller's buffer
+    check(pipe.flush(5, 6, w, h, px.data(), false, on_ready, nullptr), "zero-copy flush()");
+    check(mock.inFlight() == 1 && mock.windows == 1, "zero copy: one window, one push");
+    complete_checking_ready(mock, pipe, 0);
+    const FleetMockTransport::Push &p = mock.completed[0];
+    check(p.src == px.data(), "zero copy didn't push the caller's pointer");
+    check(p.tag == FLEET_TAG_LAST, "zero-copy push tagged BUFFER");
+    check(p.x == 5 && p.y == 6 && p.w == w && p.h == h, "zero copy: wrong window");
+
+    // Split at setMaxPush(): consecutive slices of the same buffer
+    mock.completed.clear();
+    pipe.setMaxPush(150);
+    check(pipe.flush(0, 0, w, h, px.data(), false, on_ready, nullptr), "split zero-copy flush()");
+    complete_checking_ready(mock, pipe, 1);
+    check(mock.completed.size() == 3, "400 px at max 150 isn't 3 pushes");
+    size_t off = 0;
+    for (size_t i = 0; i < mock.completed.size(); i++)
+    {
+        const FleetMockTransport::Push &q = mock.completed[i];
+        check(q.src == px.data() + off, "split push isn't the next slice of the caller's buffer");
+        check(!(q.tag & FLEET_TAG_BUFFER), "zero-copy push tagged BUFFER");
+        check(((q.tag & FLEET_TAG_LAST) != 0) == (i + 1 == mock.completed.size()), "LAST on the wrong push");
+        off += q.pixels.size();
+    }
+    check(off == px.size(), "split pushes don't add up to the area");
+
+    // Swapping needs the DMA buffers, and there are none: refused, not hung
+    check(!pipe.flush(0, 0, w, h, px.data(), true, on_ready, nullptr), "swap flush() without buffers accepted");
+    check(!pipe.flushCopy(0, 0, w, h, px.data(), false, on_ready, nullptr), "flushCopy() without buffers accepted");
+    check(!pipe.flushRotated(0, 0, w, h, px.data(), FLEET_ROTATION_90, false, on_ready, nullptr),
+          "flushRotated() without buffers accepted");
+    check(mock.inFlight() == 0 && ready_calls == 2 && pipe.state() == FleetFlushPipeline::IDLE,
+          "a refused flush queued something");
+}
+
+static void check_copy()
+{
+    const int w = 8, h = 10, rows = 4;
+    std::vector<uint16_t> buf_a(w * rows), buf_b(w * rows);
+    FleetMockTransport mock;
+    FleetFlushPipeline pipe;
+    check(pipe.begin(&mock, buf_a.data(), buf_b.data(), buf_a.size()), "begin() with two buffers");
+    const std::vector<uint16_t> px = pattern(w * h);
+
+    const int before = ready_calls;
+    check(pipe.flush(0, 0, w, h, px.data(), true, on_ready, nullptr), "swap flush()");
+    // Three strips, two buffers: the third waited for the first to finish
+    check(mock.completed.size() == 1 && mock.inFlight() == 2, "third strip didn't wait for a free buffer");
+    complete_checking_ready(mock, pipe, before);
+
+    check(mock.completed.size() == 3, "80 px in 32 px strips isn't 3 pushes");
+    const uint16_t *expect_buf[] = {buf_a.data(), buf_b.data(), buf_a.data()};
+    size_t off = 0;
+    for (size_t i = 0; i < mock.completed.size(); i++)
+    {
+        const FleetMockTransport::Push &p = mock.completed[i];
+        check(p.src == expect_buf[i], "DMA buffers don't alternate a, b, a");
+        check((p.tag & FLEET_TAG_BUFFER) != 0, "copy push not tagged BUFFER");
+        check(((p.tag & FLEET_TAG_LAST) != 0) == (i == 2), "LAST on the wrong push");
+        check(p.pixels.size() == (i < 2 ? (size_t)w * rows : (size_t)w * 2), "strip isn't whole rows");
+        bool same = true;
+        for (size_t k = 0; k < p.pixels.size(); k++)
+        {
+            same = same && p.pixels[k] == swapped(px[off + k]);
+        }
+        check(same, "strip pixels wrong (not swapped, or buffer refilled in flight)");
+        off += p.pixels.size();
+    }
+
+    // begin() refuses what takeBuf() can't serve
+    FleetFlushPipeline bad;
+    check(!bad.begin(&mock, nullptr, buf_b.data(), buf_b.size()), "begin() took buf_b without buf_a");
+    check(!bad.begin(&mock, buf_a.data(), buf_b.data(), 0), "begin() took buffers of 0 pixels");
+    check(!bad.begin(nullptr, buf_a.data(), buf_b.data(), buf_a.size()), "begin() took no transport");
+}
+
+static void check_rotated(FleetRotation rot)
+{
+    // Window 6 x 10 on the panel; LVGL rendered 6 rows of 10 pixels. 20
+    // px strips hold 3 window rows: bands of 3, 3, 3, 1
+    const int w = 6, h = 10;
+    const size_t buf_px = w * 3 + 2;
+    std::vector<uint16_t> buf_a(buf_px), buf_b(buf_px);
+    FleetMockTransport mock;
+    FleetFlushPipeline pipe;
+    pipe.begin(&mock, buf_a.data(), buf_b.data(), buf_px);
+    const std::vector<uint16_t> src = pattern(w * h);
+
+    std::vector<uint16_t> want(w * h);
+    fleet_rotate_rgb565_naive(want.data(), src.data(), h, w, h, rot);
+
+    const int before = ready_calls;
+    check(pipe.flushRotated(2, 3, w, h, src.data(), rot, true, on_ready, nullptr), "flushRotated()");
+    complete_checking_ready(mock, pipe, before);
+
+    static const int bands[] = {3, 3, 3, 1};
+    check(mock.completed.size() == 4, "10 rows in 3-row strips isn't 4 bands");
+    size_t off = 0;
+    for (size_t i = 0; i < mock.completed.size() && i < 4; i++)
+    {
+        const FleetMockTransport::Push &p = mock.completed[i];
+        check(p.pixels.size() == (size_t)bands[i] * w, "band isn't whole window rows");
+        check(p.src == (i & 1 ? buf_b.data() : buf_a.data()), "rotated strips don't alternate buffers");
+        check(p.x == 2 && p.y == 3 && p.w == w && p.h == h, "rotated: wrong window");
+        bool same = true;
+        for (size_t k = 0; k < p.pixels.size(); k++)
+        {
+            same = same && p.pixels[k] == swapped(want[off + k]);
+        }
+        check(same, "band pixels differ from the reference rotation");
+        off += p.pixels.size();
+    }
+    check(off == want.size(), "bands don't add up to the window");
+
+    // A strip shorter than one row used to loop forever
+    FleetFlushPipeline narrow;
+    narrow.begin(&mock, buf_a.data(), buf_b.data(), w - 1);
+    const size_t pushes = mock.completed.size();
+    check(!narrow.flushRotated(0, 0, w, h, src.data(), rot, false, on_ready, nullptr),
+          "flushRotated() took strips shorter than a row");
+    check(mock.inFlight() == 0 && mock.completed.size() == pushes, "refused rotation pushed something");
+}
+
+int main()
+{
+    check_zero_copy();
+    check_copy();
+    check_rotated(FLEET_ROTATION_90);
+    check_rotated(FLEET_ROTATION_270);
+
+    return fleet_check_exit();
+}
@@ -0,0 +1,233 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_glyph_cache
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check FleetGlyphCache (lib/FleetGfx) without LVGL: hits return
+ * exactly the bitmap that was put, the byte budget holds, the least
+ * recently used glyph goes first, nothing bigger than a glyph is kept, and
+ * a stream of reply text at two font sizes gets the hit rate we expect for
+ * its budget.
+ *
+ * Two threads, like two draw units, then hammer a cache small enough that
+ * put() keeps evicting what get() is copying out of: every hit must still
+ * be the right bitmap (build with -fsanitize=address to catch a freed
+ * entry being read).
+ *
+ * Run:     pio run -e native_bench_glyph_cache -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "fleet_check.h"
+#include "fleet_glyph_cache.h"
+
+// Stand-ins for two fonts; only their addresses matter
+static const int font_14 = 14;
+static const int font_48 = 48;
+
+static FleetGlyphKey key_of(const int *font, uint32_t glyph)
+{
+    const uint16_t px = (uint16_t)*font;
+    // Glyph boxes vary a little with the letter, like real ones
+    return {font, glyph, (uint16_t)(px * 2 / 3 + glyph % 5), (uint16_t)(px + glyph % 3)};
+}
+
+// The bitmap a font would render: any deterministic pattern will do
+static void render(const FleetGlyphKey &k, uint8_t *dst, uint32_t stride)
+{
+    for (uint16_t y = 0; y < k.h; y++)
+    {
+        for (uint16_t x = 0; x < k.w; x++)
+        {
+            dst[y * stride + x] = (uint8_t)(k.glyph * 7 + x * 13 + y * 29 + (uintptr_t)k.font);
+        }
+    }
+}
+
+static void check_round_trip()
+{
+    FleetGlyphCache cache;
+    cache.begin(64 * 1024);
+    const uint32_t stride = 80; // wider than any box, like LVGL's aligned strides
+    std::vector<uint8_t> src(stride * 64), want(stride * 64), got(stride * 64);
+
+    for (uint32_t g = 32; g < 127; g++)
+    {
+        const FleetGlyphKey k = key_of(&font_48, g);
+        check(!cache.get(k, got.data(), stride), "hit on an empty cache");
+        render(k, src.data(), stride);
+        cache.put(k, src.data(), stride);
+    }
+    bool same = true;
+    for (uint32_t g = 32; g < 127; g++)
+    {
+        const FleetGlyphKey k = key_of(&font_48, g);
+        memset(got.data(), 0, got.size());
+        if (!cache.get(k, got.data(), stride))
+        {
+            continue; // evicted; the budget check below covers that
+        }
+        render(k, want.data(), stride);
+        for (uint16_t y = 0; y < k.h; y++)
+        {
+            same = same && memcmp(&got[y * stride], &want[y * stride], k.w) == 0;
+        }
+    }
+    check(same, "cached bitmap differs from the one put");
+    const FleetGlyphCacheStats s = cache.stats();
+    printf("  round trip: %u entries, %u bytes of %u, %u evictions\n", (unsigned)s.entries, (unsigned)s.bytes,
+           (unsigned)s.budget, (unsigned)s.evictions);
+    check(s.bytes <= s.budget, "over budget");
+    check(s.entries + s.evictions == 127 - 32, "entries lost");
+    cache.end();
+}
+
+static void check_lru_order()
+{
+    // Room for exactly four 16x16 glyphs
+    FleetGlyphCache cache;
+    cache.begin(4 * 256);
+    uint8_t buf[256] = {};
+    auto key = [](uint32_t g) { return FleetGlyphKey{&font_14, g, 16, 16}; };
+    for (uint32_t g = 0; g < 4; g++)
+    {
+        cache.put(key(g), buf, 16);
+    }
+    cache.get(key(0), buf, 16); // 0 is now the most recently used
+    cache.put(key(4), buf, 16); // evicts 1, the least recently used
+    check(cache.get(key(0), buf, 16), "most recently used glyph evicted");
+    check(!cache.get(key(1), buf, 16), "least recently used glyph kept");
+    check(cache.get(key(4), buf, 16), "new glyph missing");
+    check(cache.stats().evictions == 1, "expected one eviction");
+
+    // A glyph bigger than a quarter of the budget is not worth keeping
+    static uint8_t big[32 * 32] = {};
+    cache.put(FleetGlyphKey{&font_48, 1, 32, 32}, big, 32);
+    check(!cache.get(FleetGlyphKey{&font_48, 1, 32, 32}, big, 32), "oversized glyph cached");
+    cache.end();
+
+    // Nor is anything bigger than a glyph, however large the budget
+    static uint8_t huge[128 * 128] = {};
+    cache.begin(1024 * 1024);
+    cache.put(FleetGlyphKey{&font_48, 2, 128, 128}, huge, 128);
+    check(!cache.get(FleetGlyphKey{&font_48, 2, 128, 128}, huge, 128), "128x128 bitmap cached");
+    cache.put(FleetGlyphKey{&font_48, 3, 48, 50}, huge, 48);
+    check(cache.get(FleetGlyphKey{&font_48, 3, 48, 50}, huge, 48), "48 px glyph not cached");
+    cache.end();
+}
+
+static void check_two_draw_units()
+{
+    // Room for about six 48 px glyphs; four hot ones, and 40 others
+    // pushing them out
+    FleetGlyphCache cache;
+    cache.begin(6 * 32 * 48);
+    std::atomic<int> bad{0}, hits{0};
+
+    auto draw_unit = [&](uint32_t seed)
+    {
+        std::vector<uint8_t> got(64 * 64), want(64 * 64);
+        for (uint32_t i = 0; i < 100000; i++)
+        {
+            const FleetGlyphKey k = key_of(&font_48, i % 3 ? 32 + i % 4 : 40 + i * seed % 40);
+            if (cache.get(k, got.data(), 64))
+            {
+                hits++;
+                render(k, want.data(), 64);
+                for (uint16_t y = 0; y < k.h; y++)
+                {
+                    if (memcmp(&got[y * 64], &want[y * 64], k.w) != 0)
+                    {
+                        bad++;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                render(k, got.data(), 64);
+                cache.put(k, got.data(), 64);
+            }
+        }
+    };
+    std::thread a(draw_unit, 3), b(draw_unit, 11);
+    a.join();
+    b.join();
+
+    const FleetGlyphCacheStats s = cache.stats();
+    printf("  two draw units: %u hits, %u evictions, %u entries, %u bytes of %u\n", (unsigned)hits.load(),
+           (unsigned)s.evictions, (unsigned)s.entries, (unsigned)s.bytes, (unsigned)s.budget);
+    check(bad == 0, "a hit returned the wrong bitmap while evicting");
+    check(hits > 0 && s.evictions > 0, "no contention: both hits and evictions expected");
+    check(s.bytes <= s.budget, "over budget");
+    cache.end();
+}
+
+static void text_hit_rate(size_t budget)
+{
+    static const char *const replies[] = {
+        "Tomorrow will be sunny with a high of 23 degrees.",
+        "Okay, setting a timer for ten minutes. I'll let you know when it's done.",
+        "Here's a playlist of calm piano music.",
+        "Your next meeting is at 3:30 PM with the design team.",
+    };
+    FleetGlyphCache cache;
+    cache.begin(budget);
+    std::vector<uint8_t> buf(64 * 64);
+
+    // 200 frames: a 48 px reply and a 14 px transcript, redrawn each frame
+    for (int frame = 0; frame < 200; frame++)
+    {
+        const char *big = replies[frame / 50 % 4];
+        const char *small = replies[(frame / 50 + 1) % 4];
+        for (const char *p = big; *p; p++)
+        {
+            const FleetGlyphKey k = key_of(&font_48, (uint8_t)*p);
+            if (!cache.get(k, buf.data(), 64))
+            {
+                render(k, buf.data(), 64);
+                cache.put(k, buf.data(), 64);
+            }
+        }
+        for (const char *p = small; *p; p++)
+        {
+            const FleetGlyphKey k = key_of(&font_14, (uint8_t)*p);
+            if (!cache.get(k, buf.data(), 64))
+            {
+                render(k, buf.data(), 64);
+                cache.put(k, buf.data(), 64);
+            }
+        }
+    }
+    const FleetGlyphCacheStats s = cache.stats();
+    const uint32_t lookups = s.hits + s.misses;
+    const unsigned pct = lookups ? (unsigned)((uint64_t)s.hits * 100 / lookups) : 0;
+    printf("  text, %6u byte budget: %3u%% hits, %3u entries, %6u bytes, %5u evictions\n", (unsigned)budget, pct,
+           (unsigned)s.entries, (unsigned)s.bytes, (unsigned)s.evictions);
+    check(s.bytes <= budget, "over budget");
+    if (budget >= 64 * 1024)
+    {
+        // Every distinct glyph fits: only first uses miss
+        check(pct >= 95, "hit rate too low for a budget that holds every glyph");
+    }
+    cache.end();
+}
+
+int main()
+{
+    printf("Glyph cache checks:\n");
+    check_round_trip();
+    check_lru_order();
+    check_two_draw_units();
+    text_hit_rate(8 * 1024);
+    text_hit_rate(32 * 1024);
+    text_hit_rate(256 * 1024);
+
+    return fleet_check_exit();
+}
@@ -0,0 +1,321 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_image_convert
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    Check the descriptors tools/fleet_image_convert.py built from
+ * the PNGs in images/, on the ex01 display setup (FleetDisplay on the
+ * in-memory framebuffer, AXS15231B rules). The converter only checks its
+ * packing against its own PNG decoder, so first:
+ *
+ *   - LVGL's PNG decoder (lodepng, -D FLEET_LODEPNG=1 in this env) reads
+ *     each PNG again, and every descriptor pixel must be exactly that
+ *     pixel quantised to nearest, alpha exact
+ *
+ * then what reaches the glass:
+ *
+ *   - the splash is in the display's wire format, stride- and 16-byte
+ *     aligned
+ *   - pushImage() and a full-screen lv_image both put exactly its bytes
+ *     on the panel (no conversion anywhere)
+ *   - the RGB565A8 icon blends: opaque pixels exact, transparent ones
+ *     leave the background
+ *   - pushImage() refuses what it can't send as is
+ *
+ * then times full-screen redraws of the pre-swapped splash against a
+ * native RGB565 copy of it, and pushImage() against both.
+ *
+ * Run:     pio run -e native_bench_image_convert -t exec
+ *          .pio/build/native_bench_image_convert/program --frames 100 --images images
+ *
+ * The PNGs are read from images/ relative to the working directory (the
+ * project directory under `-t exec`).
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "lvgl.h"
+
+// lv_draw_buf_t's header and data, lv_image_decoder_dsc_t
+#include "src/draw/lv_draw_buf_private.h"
+#include "src/draw/lv_image_decoder_private.h"
+
+#include "fleet_check.h"
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_images.h"
+#include "fleet_port.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+// tools/fleet_image_convert.py's rgb565(), written again from its doc
+static uint16_t rgb565_nearest(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (uint16_t)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+static bool read_file(const char *path, std::vector<uint8_t> *out)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == nullptr)
+    {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+    {
+        out->insert(out->end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return !out->empty();
+}
+
+// Decode `file` with lodepng and compare every pixel of `img` with it
+static void check_against_png(const char *images_dir, const char *file, const lv_image_dsc_t *img)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", images_dir, file);
+    std::vector<uint8_t> png;
+    if (!read_file(path, &png))
+    {
+        checkf(false, "can't read %s (run from the project directory, or pass --images DIR)", path);
+        return;
+    }
+
+    // A PNG in memory: LVGL hands RAW_ALPHA variables to the PNG decoder
+    lv_image_dsc_t src = {};
+    src.header.magic = LV_IMAGE_HEADER_MAGIC;
+    src.header.cf = LV_COLOR_FORMAT_RAW_ALPHA;
+    src.data_size = png.size();
+    src.data = png.data();
+    lv_image_decoder_dsc_t dsc;
+    if (lv_image_decoder_open(&dsc, &src, nullptr) != LV_RESULT_OK || dsc.decoded == nullptr)
+    {
+        check(false, "lodepng couldn't decode the PNG");
+        return;
+    }
+    const lv_draw_buf_t *ref = dsc.decoded;
+    const bool same_shape = ref->header.cf == LV_COLOR_FORMAT_ARGB8888 && ref->header.w == img->header.w &&
+                            ref->header.h == img->header.h;
+    check(same_shape, "lodepng's decode isn't an ARGB8888 image of the descriptor's size");
+
+    const bool big_endian = img->header.cf == LV_COLOR_FORMAT_RGB565_SWAPPED;
+    const bool has_alpha = img->header.cf == LV_COLOR_FORMAT_RGB565A8;
+    const uint32_t stride = img->header.stride;
+    const uint8_t *alpha = img->data + stride * img->header.h;
+    int rgb_bad = 0, alpha_bad = 0;
+    for (uint32_t y = 0; same_shape && y < img->header.h; y++)
+    {
+        const lv_color32_t *row = (const lv_color32_t *)(ref->data + y * ref->header.stride);
+        for (uint32_t x = 0; x < img->header.w; x++)
+        {
+            const uint8_t *p = img->data + y * stride + 2 * x;
+            const uint16_t got = big_endian ? (uint16_t)(p[0] << 8 | p[1]) : (uint16_t)(p[0] | p[1] << 8);
+            rgb_bad += got != rgb565_nearest(row[x].red, row[x].green, row[x].blue);
+            alpha_bad += (has_alpha ? alpha[y * (stride / 2) + x] : 255) != row[x].alpha;
+        }
+    }
+    printf("%s: against lodepng, %d RGB565 pixels and %d alpha values differ\n", file, rgb_bad, alpha_bad);
+    check(rgb_bad == 0, "descriptor colours differ from lodepng's decode");
+    check(alpha_bad == 0, "descriptor alpha differs from lodepng's decode");
+    lv_image_decoder_close(&dsc);
+}
+
+static bool glass_is(const lv_image_dsc_t *img)
+{
+    return memcmp(panel.pixels(), img->data, (size_t)LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t)) == 0;
+}
+
+// A screen with a black background and `src` at (x, y)
+static lv_obj_t *image_screen(const void *src, int x, int y)
+{
+    lv_obj_t *scr = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_t *img = lv_image_create(scr);
+    lv_image_set_src(img, src);
+    lv_obj_set_pos(img, x, y);
+    return scr;
+}
+
+static void show(lv_obj_t *scr)
+{
+    lv_obj_t *old = lv_screen_active();
+    lv_screen_load(scr);
+    if (old != scr)
+    {
+        lv_obj_delete(old);
+    }
+    lv_refr_now(nullptr);
+}
+
+// Average time of `frames` full-screen redraws, in microseconds
+static uint32_t redraw_us(int frames)
+{
+    const uint32_t t0 = fleet_micros();
+    for (int i = 0; i < frames; i++)
+    {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(nullptr);
+    }
+    return (fleet_micros() - t0) / frames;
+}
+
+static void check_splash()
+{
+    const lv_image_dsc_t *img = &fleet_img_splash;
+    printf("splash: %u x %u, cf 0x%02x, stride %u\n", (unsigned)img->header.w, (unsigned)img->header.h,
+           (unsigned)img->header.cf, (unsigned)img->header.stride);
+    check(img->header.cf == display.colorFormat(), "splash isn't in the display's wire format");
+    check(img->header.stride % 4 == 0, "stride not 4-byte aligned");
+    check(((uintptr_t)img->data % 16) == 0, "pixel data not 16-byte aligned");
+    check(img->header.w == LCD_WIDTH && img->header.h == LCD_HEIGHT, "splash isn't full-screen");
+
+    const FleetFlushStats before = display.pipeline().stats();
+    check(display.pushImage(img), "pushImage() of the splash");
+    check(glass_is(img), "pushImage(): glass differs from the image bytes");
+    check(display.pipeline().stats().transactions > before.transactions, "pushImage() sent nothing");
+
+    show(image_screen(img, 0, 0));
+    check(glass_is(img), "lv_image: glass differs from the image bytes");
+}
+
+static void check_icon()
+{
+    const lv_image_dsc_t *img = &fleet_img_mic;
+    const int x0 = 100, y0 = 120;
+    check(img->header.cf == LV_COLOR_FORMAT_RGB565A8, "icon with alpha isn't RGB565A8");
+    show(image_screen(img, x0, y0));
+
+    const uint16_t *rgb = (const uint16_t *)img->data;
+    const uint8_t *alpha = img->data + img->header.stride * img->header.h;
+    const int rgb_stride = img->header.stride / 2, a_stride = img->header.stride / 2;
+    int opaque_bad = 0, clear_bad = 0, opaque = 0, clear = 0;
+    for (int y = 0; y < (int)img->header.h; y++)
+    {
+        for (int x = 0; x < (int)img->header.w; x++)
+        {
+            const uint8_t a = alpha[y * a_stride + x];
+            const uint16_t px = panel.pixel(x0 + x, y0 + y);
+            if (a == 255)
+            {
+                opaque++;
+                opaque_bad += px != rgb[y * rgb_stride + x];
+            }
+            else if (a == 0)
+            {
+                clear++;
+                clear_bad += px != 0;
+            }
+        }
+    }
+    printf("mic: %d opaque pixels (%d wrong), %d transparent (%d wrong)\n", opaque, opaque_bad, clear, clear_bad);
+    check(opaque > 0 && opaque_bad == 0, "icon's opaque pixels");
+    check(clear > 0 && clear_bad == 0, "icon's transparent pixels");
+
+    // Not sendable as is: alpha, a window the AXS15231B can't take, padding
+    check(!display.pushImage(img, 0, 0), "pushImage() took an RGB565A8 image");
+    lv_image_dsc_t narrow = fleet_img_splash;
+    narrow.header.w = LCD_WIDTH / 2;
+    narrow.header.stride = LCD_WIDTH * 2; // the right half of each row as padding
+    check(!display.pushImage(&narrow), "pushImage() took padded rows");
+    narrow.header.stride = narrow.header.w * 2;
+    check(!display.pushImage(&narrow), "pushImage() took a half-width window on AXS15231B");
+}
+
+// The same splash in native RGB565, as an ordinary converter would emit it
+static void bench(int frames)
+{
+    const lv_image_dsc_t *swapped = &fleet_img_splash;
+    const size_t n = (size_t)swapped->header.w * swapped->header.h;
+    std::vector<uint16_t> px(n);
+    const uint16_t *src = (const uint16_t *)swapped->data;
+    for (size_t i = 0; i < n; i++)
+    {
+        px[i] = (uint16_t)(src[i] << 8 | src[i] >> 8);
+    }
+    lv_image_dsc_t native = *swapped;
+    native.header.cf = LV_COLOR_FORMAT_RGB565;
+    native.data = (const uint8_t *)px.data();
+
+    show(image_screen(&native, 0, 0));
+    check(glass_is(swapped), "native RGB565 copy drew different pixels");
+    const uint32_t native_us = redraw_us(frames);
+
+    show(image_screen(swapped, 0, 0));
+    const uint32_t swapped_us = redraw_us(frames);
+
+    uint32_t t0 = fleet_micros();
+    for (int i = 0; i < frames; i++)
+    {
+        display.pushImage(swapped);
+    }
+    const uint32_t push_us = (fleet_micros() - t0) / frames;
+    t0 = fleet_micros();
+    for (int i = 0; i < frames; i++)
+    {
+        display.pushImage(&native);
+    }
+    const uint32_t push_native_us = (fleet_micros() - t0) / frames;
+
+    printf("Full-screen splash, %d frames:\n", frames);
+    printf("path,us_per_frame\n");
+    printf("lv_image RGB565,%u\n", (unsigned)native_us);
+    printf("lv_image RGB565_SWAPPED,%u\n", (unsigned)swapped_us);
+    printf("pushImage RGB565,%u\n", (unsigned)push_native_us);
+    printf("pushImage RGB565_SWAPPED,%u\n", (unsigned)push_us);
+}
+
+int main(int argc, char **argv)
+{
+    int frames = 50;
+    const char *images_dir = "images";
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--images") == 0 && i + 1 < argc)
+        {
+            images_dir = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--frames N] [--images DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.panel = "AXS15231B";
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+
+    check_against_png(images_dir, "splash.png", &fleet_img_splash);
+    check_against_png(images_dir, "mic.png", &fleet_img_mic);
+    check_splash();
+    check_icon();
+    bench(frames > 0 ? frames : 1);
+
+    return fleet_check_exit();
+}
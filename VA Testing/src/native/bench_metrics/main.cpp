@@ -0,0 +1,153 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_metrics
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check FleetHistogram (lib/FleetGfx/src/fleet_metrics.h), the
+ * histograms behind the 'm' metrics dump:
+ *
+ *   - bucketOf(): 0 alone in bucket 0, [2^(i-1), 2^i) in bucket i, and
+ *     everything from 2^22 up, UINT32_MAX included, in the last bucket
+ *   - known inputs land in the expected buckets, with the expected count,
+ *     min, max and mean (no overflow at UINT32_MAX)
+ *   - percentile() gives its bucket's upper bound, clamped to max()
+ *   - empty and reset histograms report zeros
+ *
+ * Run:     pio run -e native_bench_metrics -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "fleet_check.h"
+#include "fleet_metrics.h"
+
+static void check_buckets()
+{
+    const int last = FleetHistogram::BUCKETS - 1;
+    static const struct
+    {
+        uint32_t value;
+        int bucket;
+    } known[] = {
+        {0, 0},
+        {1, 1},
+        {2, 2},
+        {3, 2},
+        {4, 3},
+        {7, 3},
+        {8, 4},
+        {1000, 10},
+        {1023, 10},
+        {1024, 11},
+        {(1u << 22) - 1, 22},
+        {1u << 22, 23},
+        {1u << 31, 23},
+        {UINT32_MAX, 23},
+    };
+    for (const auto &k : known)
+    {
+        const int b = FleetHistogram::bucketOf(k.value);
+        if (b != k.bucket)
+        {
+            printf("  bucketOf(%u) = %d, expected %d\n", (unsigned)k.value, b, k.bucket);
+        }
+        check(b == k.bucket, "value in the wrong bucket");
+    }
+    check(last == 23, "expected 24 buckets");
+
+    // Every bucket but the last covers exactly [bucketLow(i), bucketLow(i + 1))
+    for (int i = 1; i < last; i++)
+    {
+        const uint32_t lo = FleetHistogram::bucketLow(i), hi = FleetHistogram::bucketLow(i + 1) - 1;
+        check(FleetHistogram::bucketOf(lo) == i && FleetHistogram::bucketOf(hi) == i, "bucket bounds");
+    }
+    check(FleetHistogram::bucketLow(0) == 0 && FleetHistogram::bucketLow(1) == 1, "bucketLow() of 0 and 1");
+}
+
+static void check_record()
+{
+    FleetHistogram h;
+    const uint32_t values[] = {0, 1, 2, 3, 4, 1000};
+    for (uint32_t v : values)
+    {
+        h.record(v);
+    }
+    check(h.count() == 6, "count");
+    check(h.min() == 0, "min with a 0 sample");
+    check(h.max() == 1000, "max");
+    check(h.mean() == 1010 / 6, "mean");
+    check(h.bucket(0) == 1 && h.bucket(1) == 1 && h.bucket(2) == 2 && h.bucket(3) == 1 && h.bucket(10) == 1,
+          "bucket counts");
+    uint32_t total = 0;
+    for (int i = 0; i < FleetHistogram::BUCKETS; i++)
+    {
+        total += h.bucket(i);
+    }
+    check(total == h.count(), "bucket counts don't add up to count()");
+
+    // A single 1: min, max and mean all 1
+    FleetHistogram one;
+    one.record(1);
+    check(one.min() == 1 && one.max() == 1 && one.mean() == 1 && one.bucket(1) == 1, "a single 1");
+
+    // UINT32_MAX: last bucket, and the sum doesn't wrap
+    FleetHistogram top;
+    for (int i = 0; i < 4; i++)
+    {
+        top.record(UINT32_MAX);
+    }
+    check(top.bucket(FleetHistogram::BUCKETS - 1) == 4, "UINT32_MAX not in the last bucket");
+    check(top.min() == UINT32_MAX && top.max() == UINT32_MAX, "min/max at UINT32_MAX");
+    check(top.mean() == UINT32_MAX, "mean of UINT32_MAX samples wrapped");
+    check(top.percentile(50) == UINT32_MAX, "percentile in the last bucket isn't max()");
+
+    h.dump("known values", "us");
+    top.dump("UINT32_MAX", "us");
+}
+
+static void check_percentiles()
+{
+    FleetHistogram h;
+    for (uint32_t v = 1; v <= 100; v++)
+    {
+        h.record(v);
+    }
+    // 50 is in [32, 64), 90 and 99 in [64, 128), clamped to the max of 100
+    check(h.percentile(50) == 63, "p50 of 1..100");
+    check(h.percentile(90) == 100, "p90 of 1..100 not clamped to max");
+    check(h.percentile(100) == 100, "p100 isn't max");
+    check(h.percentile(1) == 1, "p1 of 1..100");
+    check(h.mean() == 50, "mean of 1..100");
+}
+
+static void check_empty()
+{
+    FleetHistogram h;
+    check(h.count() == 0 && h.min() == 0 && h.max() == 0 && h.mean() == 0 && h.percentile(50) == 0,
+          "empty histogram isn't all zeros");
+    h.record(500);
+    h.record(7);
+    h.reset();
+    check(h.count() == 0 && h.min() == 0 && h.max() == 0 && h.mean() == 0 && h.percentile(99) == 0,
+          "reset histogram isn't all zeros");
+    for (int i = 0; i < FleetHistogram::BUCKETS; i++)
+    {
+        check(h.bucket(i) == 0, "reset left a bucket count");
+    }
+    // min() after a reset comes from the new samples only
+    h.record(9);
+    check(h.min() == 9 && h.max() == 9, "min/max after reset");
+    h.dump("empty then 9", "B");
+}
+
+int main()
+{
+    check_buckets();
+    check_record();
+    check_percentiles();
+    check_empty();
+
+    return fleet_check_exit();
+}
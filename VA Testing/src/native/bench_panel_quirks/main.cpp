@@ -0,0 +1,186 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_panel_quirks
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check fleet_panel_round() for every controller in
+ * fleet_panel_table, in every rotation. Each rounded area must hold the
+ * original, stay on the panel and follow the controller's rules. It must
+ * not change if rounded again, and the bounding box of two rounded areas
+ * must be legal too (FleetCoalescer relies on that).
+ * Then show what each controller's rules cost on typical invalidations,
+ * before and after coalescing.
+ *
+ * Run:     pio run -e native_bench_panel_quirks -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fleet_check.h"
+#include "fleet_coalesce.h"
+#include "fleet_panel.h"
+
+#define PANEL_W 320
+#define PANEL_H 480
+#define MAX_RECTS 32
+
+static void check(bool ok, const char *what, const FleetPanelQuirks *q, int rot, const FleetRect &r)
+{
+    checkf(ok, "%s rot %d [%d,%d..%d,%d]: %s", q->name, rot, (int)r.x1, (int)r.y1, (int)r.x2, (int)r.y2, what);
+}
+
+// Logical (rotated) -> panel coordinates, written out independently
+static FleetRect to_panel(const FleetRect &r, FleetRotation rot)
+{
+    if (rot == FLEET_ROTATION_90)
+    {
+        return {r.y1, PANEL_H - 1 - r.x2, r.y2, PANEL_H - 1 - r.x1};
+    }
+    if (rot == FLEET_ROTATION_270)
+    {
+        return {PANEL_W - 1 - r.y2, r.x1, PANEL_W - 1 - r.y1, r.x2};
+    }
+    return r;
+}
+
+static bool aligned(int32_t lo, int32_t hi, int align, int size)
+{
+    return lo % align == 0 && ((hi + 1) % align == 0 || hi == size - 1);
+}
+
+static bool legal(const FleetPanelQuirks *q, const FleetRect &logical, FleetRotation rot)
+{
+    const FleetRect p = to_panel(logical, rot);
+    if (p.x1 < 0 || p.y1 < 0 || p.x2 >= PANEL_W || p.y2 >= PANEL_H || p.x1 > p.x2 || p.y1 > p.y2)
+    {
+        return false;
+    }
+    if (q->full_width && (p.x1 != 0 || p.x2 != PANEL_W - 1))
+    {
+        return false;
+    }
+    return aligned(p.x1, p.x2, q->x_align, PANEL_W) && aligned(p.y1, p.y2, q->y_align, PANEL_H);
+}
+
+static bool contains(const FleetRect &outer, const FleetRect &inner)
+{
+    return outer.x1 <= inner.x1 && outer.y1 <= inner.y1 && outer.x2 >= inner.x2 && outer.y2 >= inner.y2;
+}
+
+static FleetRect random_rect(int w, int h)
+{
+    const int32_t rw = 1 + rand() % (w / 3), rh = 1 + rand() % (h / 3);
+    const int32_t x = rand() % (w - rw + 1), y = rand() % (h - rh + 1);
+    return {x, y, x + rw - 1, y + rh - 1};
+}
+
+static void check_rounding(const FleetPanelQuirks *q, FleetRotation rot)
+{
+    const int w = rot == FLEET_ROTATION_0 ? PANEL_W : PANEL_H; // logical size
+    const int h = rot == FLEET_ROTATION_0 ? PANEL_H : PANEL_W;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        FleetRect in = random_rect(w, h);
+        if (i < 4)
+        {
+            // Edges and corners, where clamping kicks in
+            const FleetRect edges[] = {{0, 0, 0, 0}, {w - 1, h - 1, w - 1, h - 1}, {0, 0, w - 1, h - 1},
+                                       {w - 3, 1, w - 1, 2}};
+            in = edges[i];
+        }
+        FleetRect out = in;
+        fleet_panel_round(q, &out, PANEL_W, PANEL_H, rot);
+        check(contains(out, in), "does not hold the input", q, rot, in);
+        check(legal(q, out, rot), "not a legal window", q, rot, in);
+
+        FleetRect again = out;
+        fleet_panel_round(q, &again, PANEL_W, PANEL_H, rot);
+        check(memcmp(&again, &out, sizeof(out)) == 0, "rounding twice changes it", q, rot, in);
+
+        FleetRect other = random_rect(w, h);
+        fleet_panel_round(q, &other, PANEL_W, PANEL_H, rot);
+        const FleetRect box = {out.x1 < other.x1 ? out.x1 : other.x1, out.y1 < other.y1 ? out.y1 : other.y1,
+                               out.x2 > other.x2 ? out.x2 : other.x2, out.y2 > other.y2 ? out.y2 : other.y2};
+        check(legal(q, box, rot), "bounding box of two legal windows is not legal", q, rot, in);
+    }
+}
+
+struct Pattern
+{
+    const char *name;
+    FleetRect rects[MAX_RECTS];
+    int n;
+};
+
+static void add(Pattern &p, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    p.rects[p.n++] = {x, y, x + w - 1, y + h - 1};
+}
+
+// Transactions and modelled bus bytes: as invalidated (not legal on every
+// panel), rounded, then rounded and coalesced
+static void cost_report(const FleetPanelQuirks *q, const Pattern &p)
+{
+    FleetCoalescer co;
+    FleetRect rounded[MAX_RECTS];
+    for (int i = 0; i < p.n; i++)
+    {
+        rounded[i] = p.rects[i];
+        fleet_panel_round(q, &rounded[i], PANEL_W, PANEL_H);
+    }
+    const uint64_t raw = co.cost(p.rects, p.n);
+    const uint64_t legal_cost = co.cost(rounded, p.n);
+    const int n = co.run(rounded, p.n);
+    const uint64_t merged = co.cost(rounded, n);
+    for (int i = 0; i < n; i++)
+    {
+        check(legal(q, rounded[i], FLEET_ROTATION_0), "coalesced window is not legal", q, 0, rounded[i]);
+    }
+    printf("  %-10s %-18s %2d txn %7u B | rounded %2d txn %7u B | coalesced %2d txn %7u B\n", q->name, p.name, p.n,
+           (unsigned)raw, p.n, (unsigned)legal_cost, n, (unsigned)merged);
+}
+
+int main()
+{
+    printf("--- bench_panel_quirks: %dx%d panel ---\n", PANEL_W, PANEL_H);
+
+    const FleetRotation rots[] = {FLEET_ROTATION_0, FLEET_ROTATION_90, FLEET_ROTATION_270};
+    for (const FleetPanelQuirks *q = fleet_panel_table; q->name != nullptr; q++)
+    {
+        printf("%-10s x align %u, y align %u%s\n", q->name, (unsigned)q->x_align, (unsigned)q->y_align,
+               q->full_width ? ", full-width rows" : "");
+        check(fleet_panel_find(q->name) == q, "lookup by name", q, 0, FleetRect());
+        for (FleetRotation rot : rots)
+        {
+            check_rounding(q, rot);
+        }
+    }
+    const FleetRect none = {0, 0, 0, 0};
+    check(fleet_panel_find("axs15231b") != nullptr, "lookup ignores case", fleet_panel_table, 0, none);
+    check(fleet_panel_find("no-such-panel") == nullptr, "unknown panel found", fleet_panel_table, 0, none);
+
+    Pattern icons = {"status_icons", {}, 0};
+    for (int i = 0; i < 6; i++)
+    {
+        add(icons, 9 + i * 24, 5, 15, 15);
+    }
+    Pattern cursor = {"cursor_and_status", {}, 0};
+    add(cursor, 281, 5, 35, 15);
+    add(cursor, 31, 401, 3, 19);
+    Pattern spinner = {"spinner", {}, 0};
+    add(spinner, 91, 171, 139, 139);
+
+    printf("\nCost (%u overhead bytes per transaction):\n", (unsigned)FLEET_TXN_OVERHEAD_BYTES);
+    for (const FleetPanelQuirks *q = fleet_panel_table; q->name != nullptr; q++)
+    {
+        cost_report(q, icons);
+        cost_report(q, cursor);
+        cost_report(q, spinner);
+    }
+
+    return fleet_check_exit();
+}
@@ -0,0 +1,226 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_panel_throughput
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Run ex00's panel throughput benchmark (fleet_panel_bench) on
+ * FleetSimBus and check the harness itself. The simulated bus charges
+ * known costs on a virtual clock, so every number the benchmark reports
+ * has an exact expected value:
+ *
+ *   - us per frame, CPU time, FPS, MB/s and wire % of fill, polling and
+ *     DMA pushes, at every clock
+ *   - a clock the bus refuses is skipped, and so is one it accepts but
+ *     doesn't switch to (FleetSimBusModel::stuck_above_hz)
+ *   - setAddrWindow() time, transaction time and overhead per window size
+ *   - the bus was driven legally: windows on the panel, no push beyond
+ *     its window, DMA buffers alternated, every pixel accounted for
+ *
+ * then prints the CSV the device prints.
+ *
+ * Run:     pio run -e native_bench_panel_throughput -t exec
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+#include "fleet_check.h"
+#include "fleet_panel_bench.h"
+#include "fleet_sim_bus.h"
+
+#define STRIP_ROWS 24
+
+static bool near(double got, double want)
+{
+    return fabs(got - want) <= 1e-3 * fabs(want) + 1e-3;
+}
+
+// The model's cost of a frame pushed as the benchmark does it: one
+// full-screen window, then strips of strip_px pixels
+static uint32_t frame_us(const FleetSimBus &sim, size_t strip_px, bool dma, uint32_t *cpu_us)
+{
+    const FleetSimBusModel &m = sim.model();
+    const int rows = (int)(strip_px / m.width);
+    const uint32_t per_call = m.call_us + (dma ? m.dma_setup_us : 0);
+    uint32_t us = sim.windowUs();
+    *cpu_us = us;
+    for (int y = 0; y < m.height; y += rows)
+    {
+        const int n = (y + rows <= m.height ? rows : m.height - y) * m.width;
+        us += per_call + sim.wireUs(n);
+        *cpu_us += dma ? per_call : per_call + sim.wireUs(n);
+    }
+    return us;
+}
+
+static void check_throughput(FleetSimBus &sim, const FleetPanelBench &bench, size_t strip_px)
+{
+    const FleetSimBusModel &m = sim.model();
+    const double bytes = (double)m.width * m.height * 2;
+    for (int i = 0; i < bench.throughputCount(); i++)
+    {
+        const FleetThroughputRow &r = bench.throughput(i);
+        sim.setBusHz(r.bus_hz);
+        uint32_t want = 0, want_cpu = 0;
+        switch (r.test)
+        {
+        case FLEET_BENCH_FILL:
+            want = want_cpu = sim.fillUs();
+            break;
+        case FLEET_BENCH_PUSH_POLL:
+            want = frame_us(sim, strip_px, false, &want_cpu);
+            break;
+        default:
+            want = frame_us(sim, strip_px, true, &want_cpu);
+            break;
+        }
+        printf("%5.1f MHz %-9s %6u us (model %6u), cpu %6u us (model %6u)\n", r.bus_hz / 1e6,
+               fleet_bench_test_name(r.test), (unsigned)r.us_per_frame, (unsigned)want,
+               (unsigned)r.cpu_us_per_frame, (unsigned)want_cpu);
+        check(r.us_per_frame == want, "us per frame differs from the model");
+        check(r.cpu_us_per_frame == want_cpu, "CPU time differs from the model");
+        check(near(r.fps, 1e6 / want), "FPS isn't 1e6 / us per frame");
+        check(near(r.mb_s, bytes / want), "MB/s isn't bytes / us per frame");
+        check(near(r.wire_pct, r.mb_s * 100 / (r.bus_hz / 1e6 * m.lanes / 8)), "wire % isn't MB/s over the raw rate");
+        check(r.wire_pct > 0 && r.wire_pct <= 100, "wire % out of range");
+    }
+}
+
+static void check_windows(FleetSimBus &sim, const FleetPanelBench &bench, size_t strip_px)
+{
+    const FleetSimBusModel &m = sim.model();
+    for (int i = 0; i < bench.windowCount(); i++)
+    {
+        const FleetWindowRow &r = bench.window(i);
+        sim.setBusHz(r.bus_hz);
+
+        // The streaming rate the overhead is taken against: the same
+        // clock's push_dma row
+        double stream = 0;
+        for (int j = 0; j < bench.throughputCount(); j++)
+        {
+            if (bench.throughput(j).bus_hz == r.bus_hz && bench.throughput(j).test == FLEET_BENCH_PUSH_DMA)
+            {
+                stream = bench.throughput(j).mb_s;
+            }
+        }
+
+        double want = sim.windowUs();
+        for (size_t left = (size_t)r.w * r.h; left > 0;)
+        {
+            const size_t n = left < strip_px ? left : strip_px;
+            want += m.call_us + m.dma_setup_us + sim.wireUs(n);
+            left -= n;
+        }
+        const double bytes = (double)r.w * r.h * 2;
+        check(near(r.us_set_window, sim.windowUs()), "setAddrWindow time differs from the model");
+        check(near(r.us_per_txn, want), "transaction time differs from the model");
+        check(near(r.mb_s, bytes / want), "window MB/s isn't bytes / us per transaction");
+        check(stream > 0 && near(r.overhead_us, want - bytes / stream), "overhead isn't txn minus streaming time");
+        if (r.w == m.width && r.h == m.height)
+        {
+            check(near(r.overhead_us + 1, 1), "full-screen window isn't the zero-overhead reference");
+        }
+    }
+}
+
+// A bus that says yes to 80 MHz but stays at 40: the probe must catch it
+static void check_stuck_clock(uint16_t *strip0, uint16_t *strip1, size_t strip_px)
+{
+    static const uint32_t clocks[] = {20000000, 40000000, 80000000};
+    FleetSimBusModel model;
+    model.stuck_above_hz = 40000000;
+    FleetSimBus sim(model);
+    FleetPanelBench bench;
+    FleetPanelBenchConfig cfg;
+    cfg.bus_hz = clocks;
+    cfg.bus_count = 3;
+    cfg.frames = 2;
+    cfg.window_iters = 2;
+    cfg.strip[0] = strip0;
+    cfg.strip[1] = strip1;
+    cfg.strip_px = strip_px;
+    check(bench.run(&sim, cfg), "run() on a stuck bus");
+
+    printf("\nStuck clock:\n");
+    bench.print();
+    check(bench.throughputCount() == 2 * FLEET_BENCH_TEST_COUNT, "rows printed for a clock that didn't take");
+    check(bench.skippedCount() == 1, "stuck clock not skipped");
+    if (bench.skippedCount() == 1)
+    {
+        const FleetSkippedClock &k = bench.skippedClock(0);
+        check(k.bus_hz == 80000000 && k.why == FLEET_BENCH_SKIP_NOT_TAKEN, "80 MHz not skipped as not taken");
+        check(k.same_as_hz == 40000000, "stuck clock not matched to 40 MHz");
+    }
+    for (int i = 0; i < bench.throughputCount(); i++)
+    {
+        check(bench.throughput(i).bus_hz != 80000000, "a row claims 80 MHz");
+    }
+}
+
+int main()
+{
+    static const uint32_t clocks[] = {20000000, 40000000, 80000000, 100000000}; // 100 MHz: over the model's max
+    const int frames = 10, iters = 50;
+    const size_t strip_px = (size_t)320 * STRIP_ROWS;
+    std::vector<uint16_t> strip0(strip_px), strip1(strip_px);
+
+    FleetSimBus sim;
+    FleetPanelBench bench;
+    FleetPanelBenchConfig cfg;
+    cfg.bus_hz = clocks;
+    cfg.bus_count = 4;
+    cfg.lanes = sim.model().lanes;
+    cfg.frames = frames;
+    cfg.window_iters = iters;
+    cfg.strip[0] = strip0.data();
+    cfg.strip[1] = strip1.data();
+    cfg.strip_px = strip_px;
+
+    // Strips shorter than a row can't push a frame
+    FleetPanelBenchConfig short_cfg = cfg;
+    short_cfg.strip_px = 100;
+    check(!bench.run(&sim, short_cfg), "run() took strips shorter than a row");
+    check(sim.pushes == 0 && sim.fills == 0, "a refused run drove the bus");
+
+    check(bench.run(&sim, cfg), "run()");
+    const int clocks_run = 3;
+    check(bench.throughputCount() == clocks_run * FLEET_BENCH_TEST_COUNT, "one throughput row per test and clock");
+    check(bench.windowCount() == clocks_run * fleet_bench_window_count, "one window row per size and clock");
+
+    // Everything the benchmark sent
+    uint64_t want_px = (uint64_t)clocks_run * frames * 2 * 320 * 480;
+    for (int i = 0; i < fleet_bench_window_count; i++)
+    {
+        want_px += (uint64_t)clocks_run * iters * fleet_bench_windows[i].w * fleet_bench_windows[i].h;
+    }
+    printf("sim: %u fills, %u windows, %u pushes (%u DMA), %llu pixels, %u errors\n", (unsigned)sim.fills,
+           (unsigned)sim.windows, (unsigned)sim.pushes, (unsigned)sim.dma_pushes, (unsigned long long)sim.pixels,
+           (unsigned)sim.errors);
+    check(sim.errors == 0, "the benchmark drove the bus illegally");
+    check(sim.fills == (uint32_t)(clocks_run * (frames + 1)), "fill count (frames + one probe per clock)");
+    check(bench.skippedCount() == 1 && bench.skippedClock(0).bus_hz == 100000000 &&
+              bench.skippedClock(0).why == FLEET_BENCH_SKIP_REFUSED,
+          "100 MHz not skipped as refused");
+    check(sim.pixels == want_px, "pixels pushed");
+
+    check_throughput(sim, bench, strip_px);
+    check_windows(sim, bench, strip_px);
+
+    // What the tables should show: DMA frees the CPU, a faster clock is
+    // faster, and a tiny window is almost all overhead
+    const FleetThroughputRow &poll = bench.throughput(FLEET_BENCH_PUSH_POLL);
+    const FleetThroughputRow &dma = bench.throughput(FLEET_BENCH_PUSH_DMA);
+    check(dma.cpu_us_per_frame * 4 < poll.cpu_us_per_frame, "DMA didn't free the CPU");
+    check(bench.throughput(FLEET_BENCH_TEST_COUNT + FLEET_BENCH_PUSH_DMA).mb_s > dma.mb_s, "40 MHz not faster than 20");
+    check(bench.window(0).w == 1 && bench.window(0).mb_s < dma.mb_s / 10, "1x1 window not overhead-bound");
+
+    printf("\n");
+    bench.print();
+
+    check_stuck_clock(strip0.data(), strip1.data(), strip_px);
+
+    return fleet_check_exit();
+}
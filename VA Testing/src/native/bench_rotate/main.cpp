@@ -0,0 +1,145 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_rotate
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Compare the tiled rotate+swap kernel (fleet_rotate_rgb565) with
+ * what landscape costs without it: LVGL's per-pixel rotate, then a
+ * separate swap pass. Also check that both give bit-identical output.
+ *
+ * Run:     pio run -e native_bench_rotate -t exec
+ *
+ * The host's caches hold a whole frame (300 KB) and its prefetchers
+ * follow column walks, so the gap here is modest: on an x86-64 server
+ * core, 1.05-1.1x at 90 and 1.5-1.65x at 270, where the reference walks
+ * the source backwards. It says little about the S3 reading draw buffers
+ * from PSRAM through a 32-byte line cache: for a device number, read
+ * FleetDisplay's flush summary on ex01 built with -D FLEET_ROTATION=270.
+ * Exits non-zero if the output differs.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "fleet_rotate.h"
+#include "fleet_swap.h"
+
+// Landscape on the 320x480 Guition panel
+#define UI_WIDTH 480
+#define UI_HEIGHT 320
+
+// LVGL's generic path: rotate into a scratch buffer, then swap it
+static void rotate_then_swap(uint16_t *dst, uint16_t *tmp, const uint16_t *src, int w, int h, FleetRotation rot)
+{
+    fleet_rotate_rgb565_naive(tmp, src, w, h, w, rot);
+    fleet_swap_rgb565(dst, tmp, (size_t)w * h);
+}
+
+// --- Bit-exactness: odd sizes, every band split, with and without swap ---
+static bool verify(FleetRotation rot)
+{
+    const int sizes[][2] = {{1, 1}, {7, 3}, {17, 33}, {480, 32}, {31, 320}};
+    for (const auto &sz : sizes)
+    {
+        const int w = sz[0], h = sz[1];
+        std::vector<uint16_t> src((size_t)w * h), ref((size_t)w * h), tmp((size_t)w * h), out((size_t)w * h);
+        for (auto &p : src)
+        {
+            p = (uint16_t)rand();
+        }
+
+        for (int swap = 0; swap < 2; swap++)
+        {
+            fleet_rotate_rgb565_naive(tmp.data(), src.data(), w, h, w, rot);
+            if (swap)
+            {
+                fleet_swap_rgb565_scalar(ref.data(), tmp.data(), tmp.size());
+            }
+            else
+            {
+                ref = tmp;
+            }
+
+            // Bands of 1, 5 and all rows, as the flush pipeline asks for them
+            const int bands[] = {1, 5, w};
+            for (int band : bands)
+            {
+                memset(out.data(), 0xA5, out.size() * sizeof(uint16_t));
+                for (int r = 0; r < w; r += band)
+                {
+                    const int n = w - r < band ? w - r : band;
+                    fleet_rotate_rgb565(out.data() + (size_t)r * h, src.data(), w, h, w, rot, r, n, swap != 0);
+                }
+                if (out != ref)
+                {
+                    printf("FAIL rotate %d: %dx%d, swap %d, band %d\n", (int)rot, w, h, swap, band);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Best of five rounds: a shared host's noise only ever adds time
+template <typename F> static double time_ns_per_px(F fn, size_t px, int iters)
+{
+    fn(); // warm the caches
+    double best = 0;
+    for (int round = 0; round < 5; round++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iters; i++)
+        {
+            fn();
+            asm volatile("" : : : "memory");
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)px * iters);
+        best = round == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+int main()
+{
+    printf("--- bench_rotate (block %d, swap kernel %s) ---\n", FLEET_ROTATE_BLOCK, fleet_swap_impl_name());
+
+    bool ok = verify(FLEET_ROTATION_90) && verify(FLEET_ROTATION_270);
+    printf("Bit-exact check against rotate-then-swap: %s\n", ok ? "PASS" : "FAIL");
+
+    // A 1/10-screen PARTIAL area (what one flush rotates) and a full frame
+    const struct
+    {
+        const char *name;
+        int w, h, iters;
+    } sizes[] = {
+        {"strip 480x32", UI_WIDTH, UI_HEIGHT / 10, 4000},
+        {"frame 480x320", UI_WIDTH, UI_HEIGHT, 400},
+    };
+
+    std::vector<uint16_t> src(UI_WIDTH * UI_HEIGHT), tmp(UI_WIDTH * UI_HEIGHT), dst(UI_WIDTH * UI_HEIGHT);
+    for (auto &p : src)
+    {
+        p = (uint16_t)rand();
+    }
+
+    printf("\n%-6s %-15s %12s %12s %9s\n", "rot", "size", "naive ns/px", "tiled ns/px", "speedup");
+    const FleetRotation rots[] = {FLEET_ROTATION_90, FLEET_ROTATION_270};
+    for (FleetRotation rot : rots)
+    {
+        for (const auto &s : sizes)
+        {
+            const size_t px = (size_t)s.w * s.h;
+            const double naive = time_ns_per_px(
+                [&] { rotate_then_swap(dst.data(), tmp.data(), src.data(), s.w, s.h, rot); }, px, s.iters);
+            const double tiled = time_ns_per_px(
+                [&] { fleet_rotate_rgb565(dst.data(), src.data(), s.w, s.h, s.w, rot, 0, s.w, true); }, px, s.iters);
+            printf("%-6d %-15s %12.3f %12.3f %8.2fx\n", (int)rot, s.name, naive, tiled, naive / tiled);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_scenes
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    The ex02_bench_scenes frames on Linux against the in-memory
+ * framebuffer: one draw unit (no OS, as the device runs today) or two
+ * draw units on pthreads (-D FLEET_DRAW_UNITS=2).
+ *
+ * Run:     pio run -e native_bench_scenes -t exec
+ *          pio run -e native_bench_scenes_2units -t exec
+ *          .pio/build/native_bench_scenes_2units/program --frames 200 --out /tmp
+ *
+ * Prints one CSV line per scene, then the text scenes with the glyph
+ * cache bypassed and in use. --out writes a PPM snapshot of each scene.
+ * --ref compares each scene with the one-unit build's snapshot in that
+ * directory and exits non-zero if any pixel differs, so the threaded
+ * renderer is checked against the single-threaded one:
+ *
+ *          .pio/build/native_bench_scenes/program --frames 10 --out /tmp/ref
+ *          .pio/build/native_bench_scenes_2units/program --frames 10 --ref /tmp/ref
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+#include "fleet_snapshot.h"
+#include "fleet_ui_bench.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+
+int main(int argc, char **argv)
+{
+    int frames = 100;
+    const char *out_dir = nullptr;
+    const char *ref_dir = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            out_dir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--ref") == 0 && i + 1 < argc)
+        {
+            ref_dir = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--frames N] [--out DIR] [--ref DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+
+    fleet_ui_bench_all(frames, 5);
+    fleet_ui_bench_glyphs_all(frames, 5);
+
+    // Snapshots with animations at a fixed point, comparable across builds
+    int mismatches = 0;
+    for (int s = 0; s < FLEET_BENCH_SCENE_COUNT && (out_dir || ref_dir); s++)
+    {
+        const char *name = fleet_ui_bench_name((FleetBenchScene)s);
+        lv_lock();
+        fleet_ui_bench_scene((FleetBenchScene)s);
+        lv_refr_now(NULL);
+        lv_unlock();
+
+        char path[512];
+        if (out_dir != nullptr)
+        {
+            snprintf(path, sizeof(path), "%s/bench_%s_%du.ppm", out_dir, name, LV_DRAW_SW_DRAW_UNIT_CNT);
+            if (!fleet_snapshot_ppm(path, panel.pixels(), panel.width(), panel.height()))
+            {
+                printf("FATAL ERROR: cannot write %s\n", path);
+                return 1;
+            }
+            printf("Snapshot written to %s\n", path);
+        }
+        if (ref_dir != nullptr)
+        {
+            snprintf(path, sizeof(path), "%s/bench_%s_1u.ppm", ref_dir, name);
+            const int differ = fleet_snapshot_diff_ppm(path, panel.pixels(), panel.width(), panel.height());
+            if (differ < 0)
+            {
+                printf("  FAIL %s: cannot read %s\n", name, path);
+            }
+            else if (differ > 0)
+            {
+                printf("  FAIL %s: %d pixels differ from the 1-unit render\n", name, differ);
+            }
+            mismatches += differ != 0;
+        }
+    }
+    if (ref_dir != nullptr)
+    {
+        printf(mismatches ? "%d scene(s) differ from the 1-unit render\n" : "All scenes match the 1-unit render\n",
+               mismatches);
+    }
+    return mismatches ? 1 : 0;
+}
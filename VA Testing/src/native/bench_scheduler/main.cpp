@@ -0,0 +1,129 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_scheduler
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Check FleetScheduler's wake-up timing against what the old
+ * `delay(5)` loop gave us: sleeps last as long as LVGL asked (never
+ * shorter), and a wake() from another thread ends a sleep within a
+ * fraction of a millisecond instead of up to 5 ms later.
+ *
+ * Run:     pio run -e native_bench_scheduler -t exec
+ *
+ * Exits non-zero if a check fails. Host schedulers are noisy, so the
+ * limits are loose; the printed numbers are the interesting part.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+
+#include "fleet_check.h"
+#include "fleet_port.h"
+#include "fleet_scheduler.h"
+
+// A host that misses these by this much is too loaded to say anything
+#define MAX_OVERSHOOT_US 20000
+#define MAX_WAKE_LATENCY_US 20000
+
+// --- 1. Timed sleeps: as long as requested, never shorter ---
+static void timed_sleeps(FleetScheduler &sched)
+{
+    printf("Timed sleeps (what lv_timer_handler() asked for):\n");
+    printf("  %8s %10s %10s %10s\n", "ask_ms", "min_us", "avg_us", "max_us");
+
+    const uint32_t asks[] = {1, 5, 10, 33, 100};
+    for (uint32_t ms : asks)
+    {
+        uint32_t lo = UINT32_MAX, hi = 0;
+        uint64_t sum = 0;
+        const int runs = ms < 50 ? 20 : 5;
+        for (int i = 0; i < runs; i++)
+        {
+            const uint32_t t0 = fleet_micros();
+            const bool woken = sched.sleep(ms);
+            const uint32_t dt = fleet_micros() - t0;
+            check(!woken, "timed sleep reported a wake");
+            lo = dt < lo ? dt : lo;
+            hi = dt > hi ? dt : hi;
+            sum += dt;
+        }
+        printf("  %8u %10u %10u %10u\n", (unsigned)ms, (unsigned)lo, (unsigned)(sum / runs), (unsigned)hi);
+        check(lo >= ms * 1000, "slept less than asked");
+        check(hi <= ms * 1000 + MAX_OVERSHOOT_US, "overslept");
+    }
+}
+
+// --- 2. wake() from another thread while asleep ---
+static void early_wakes(FleetScheduler &sched)
+{
+    printf("wake() from another thread, 5 ms into a %u ms sleep:\n", (unsigned)FLEET_SCHED_MAX_SLEEP_MS);
+
+    uint32_t lo = UINT32_MAX, hi = 0;
+    uint64_t sum = 0;
+    const int runs = 50;
+    for (int i = 0; i < runs; i++)
+    {
+        uint32_t woke_at = 0;
+        std::thread waker([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            woke_at = fleet_micros();
+            sched.wake();
+        });
+
+        const bool woken = sched.sleep(FLEET_SCHED_MAX_SLEEP_MS);
+        const uint32_t back = fleet_micros();
+        waker.join();
+
+        check(woken, "sleep did not report the wake");
+        const uint32_t latency = back - woke_at;
+        lo = latency < lo ? latency : lo;
+        hi = latency > hi ? latency : hi;
+        sum += latency;
+    }
+    printf("  wake -> running: min %u us, avg %u us, max %u us (delay(5) loop: up to 5000 us)\n", (unsigned)lo,
+           (unsigned)(sum / runs), (unsigned)hi);
+    check(hi <= MAX_WAKE_LATENCY_US, "wake latency too high");
+}
+
+// --- 3. A wake before the sleep is not lost, and several collapse into one ---
+static void pending_wakes(FleetScheduler &sched)
+{
+    printf("Wakes posted while awake:\n");
+
+    sched.wake();
+    sched.wake();
+    sched.wake();
+
+    uint32_t t0 = fleet_micros();
+    const bool first = sched.sleep(100);
+    const uint32_t first_us = fleet_micros() - t0;
+
+    t0 = fleet_micros();
+    const bool second = sched.sleep(10);
+    const uint32_t second_us = fleet_micros() - t0;
+
+    printf("  1st sleep: %s after %u us, 2nd sleep: %s after %u us\n", first ? "woken" : "timeout",
+           (unsigned)first_us, second ? "woken" : "timeout", (unsigned)second_us);
+    check(first && first_us < MAX_WAKE_LATENCY_US, "pending wake was lost");
+    check(!second && second_us >= 10000, "wakes did not collapse into one");
+}
+
+int main()
+{
+    FleetScheduler sched;
+    if (!sched.begin())
+    {
+        printf("FATAL ERROR: scheduler init failed\n");
+        return 1;
+    }
+
+    timed_sleeps(sched);
+    early_wakes(sched);
+    pending_wakes(sched);
+
+    const FleetSchedulerStats &ss = sched.stats();
+    printf("Stats: %u sleeps, %u woken early, %u ms asleep\n", (unsigned)ss.sleeps, (unsigned)ss.woken,
+           (unsigned)(ss.slept_us / 1000));
+
+    return fleet_check_exit();
+}
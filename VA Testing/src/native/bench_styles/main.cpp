@@ -0,0 +1,99 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_styles
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    Style lookup cost on style-heavy voice screens (nested flex
+ * cards, themed buttons, transcript labels), with LVGL's per-object
+ * style cache off (native_bench_styles) or on (native_bench_styles_cache,
+ * -D FLEET_STYLE_CACHE=1). Build, layout, draw and lookup times per
+ * screen, plus sizeof(lv_obj_t) and the heap bytes per object.
+ *
+ * Run:     pio run -e native_bench_styles -t exec
+ *          pio run -e native_bench_styles_cache -t exec
+ *          .pio/build/native_bench_styles_cache/program --frames 200 --out /tmp
+ *
+ * Prints one CSV line per screen and, with --out, writes a PPM snapshot
+ * of each, so the two builds can be checked for identical output (cmp).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+#include "fleet_snapshot.h"
+#include "fleet_ui_bench.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+
+int main(int argc, char **argv)
+{
+    int frames = 50;
+    const char *out_dir = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            out_dir = argv[++i];
+        }
+        else
+        {
+            printf("usage: %s [--frames N] [--out DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+
+    fleet_ui_bench_styles_all(frames);
+
+    if (out_dir == nullptr)
+    {
+        return 0;
+    }
+
+    // The last run of each screen is still on the panel after a redraw
+    for (int s = 0; s < FLEET_STYLE_SCREEN_COUNT; s++)
+    {
+        FleetStyleResult r;
+        fleet_ui_bench_styles((FleetStyleScreen)s, 1, &r);
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/styles_%s_cache%d.ppm", out_dir,
+                 fleet_ui_style_screen_name((FleetStyleScreen)s), LV_OBJ_STYLE_CACHE);
+        if (!fleet_snapshot_ppm(path, panel.pixels(), panel.width(), panel.height()))
+        {
+            printf("FATAL ERROR: cannot write %s\n", path);
+            return 1;
+        }
+        printf("Snapshot written to %s\n", path);
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_te
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    Check FleetDisplay's TE pacing against a simulated TE signal:
+ *
+ *   - every frame's first window opens in the blanking, right after a pulse
+ *   - frames go out on distinct pulses, te_divider pulses apart or more
+ *   - with an animated scene, the frame rate tracks panel rate / divider
+ *
+ * Run:     pio run -e native_bench_te -t exec
+ *          .pio/build/native_bench_te/program --hz 60 --divider 2 --direct --seconds 5
+ *
+ * Exits non-zero if a check fails. Host scheduling is noisy, so the lag
+ * limit is loose and only 95% of frames have to meet it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "lvgl.h"
+
+#include "fleet_check.h"
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+#include "fleet_te.h"
+#include "fleet_ui_bench.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+#define TE_JITTER_US 200
+#define MAX_LAG_US (FLEET_TE_BLANKING_US + 2000)
+
+static FleetTe te;
+static FleetDisplay display;
+
+struct FrameStart
+{
+    uint32_t at_us;    // first setWindow() of the frame
+    uint32_t pulse;    // te.pulses() then
+    uint32_t pulse_us; // te.lastPulseUs() then
+};
+static std::vector<FrameStart> starts;
+static bool frame_open = false;
+
+// Notes the first window of each frame, i.e. when its pixels start
+class TimedPanel : public FleetFramebufferTransport
+{
+public:
+    void setWindow(int x, int y, int w, int h) override
+    {
+        if (frame_open)
+        {
+            starts.push_back({fleet_micros(), te.pulses(), te.lastPulseUs()});
+            frame_open = false;
+        }
+        FleetFramebufferTransport::setWindow(x, y, w, h);
+    }
+};
+static TimedPanel panel;
+
+static void on_render_start(lv_event_t *e)
+{
+    (void)e;
+    frame_open = true;
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 2;
+    int hz = 60;
+    int divider = 1;
+    bool direct = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            seconds = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--hz") == 0 && i + 1 < argc)
+        {
+            hz = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--divider") == 0 && i + 1 < argc)
+        {
+            divider = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--direct") == 0)
+        {
+            direct = true;
+        }
+        else
+        {
+            printf("usage: %s [--seconds N] [--hz N] [--divider N] [--direct]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (hz <= 0 || divider <= 0 || seconds <= 0)
+    {
+        printf("FATAL ERROR: --hz, --divider and --seconds must be positive\n");
+        return 2;
+    }
+
+    printf("--- bench_te: simulated TE at %d Hz (+-%d us), divider %d, %s render ---\n", hz, TE_JITTER_US, divider,
+           direct ? "direct" : "partial");
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.direct = direct;
+    cfg.te_divider = divider;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+    lv_display_add_event_cb(display.display(), on_render_start, LV_EVENT_RENDER_START, nullptr);
+
+    // Spinners never stop animating, so every panel frame could take a new one
+    fleet_ui_bench_scene(FLEET_BENCH_SPINNERS);
+
+    if (!te.beginSimulated(1000000 / hz, TE_JITTER_US))
+    {
+        printf("FATAL ERROR: simulated TE failed to start\n");
+        return 1;
+    }
+    display.syncToTe(&te);
+
+    const uint32_t pulse0 = te.pulses();
+    const uint32_t t0 = fleet_millis();
+    while (fleet_millis() - t0 < (uint32_t)seconds * 1000)
+    {
+        display.runOnce();
+    }
+    const uint32_t pulses = te.pulses() - pulse0;
+    te.end();
+
+    // Skip the first frame: it started before pacing had a reference
+    uint32_t in_time = 0, max_lag = 0, min_gap = UINT32_MAX;
+    for (size_t i = 1; i < starts.size(); i++)
+    {
+        const uint32_t lag = starts[i].at_us - starts[i].pulse_us;
+        in_time += lag <= MAX_LAG_US;
+        max_lag = lag > max_lag ? lag : max_lag;
+        const uint32_t gap = starts[i].pulse - starts[i - 1].pulse;
+        min_gap = gap < min_gap ? gap : min_gap;
+    }
+    const uint32_t frames = starts.size() > 1 ? (uint32_t)starts.size() - 1 : 0;
+    const uint32_t expected = pulses / divider;
+
+    printf("Pulses: %u, measured period %u us\n", (unsigned)pulses, (unsigned)te.periodUs());
+    printf("Frames: %u (panel rate / divider would be %u), %u.%u fps\n", (unsigned)frames, (unsigned)expected,
+           (unsigned)(frames / seconds), (unsigned)(frames * 10 / seconds % 10));
+    printf("Pulse -> first window: %u of %u within %u us, max %u us\n", (unsigned)in_time, (unsigned)frames,
+           (unsigned)MAX_LAG_US, (unsigned)max_lag);
+    printf("Closest frames: %u pulse(s) apart\n", (unsigned)(frames ? min_gap : 0));
+    te.lag().dump("te pulse->push", "us");
+    const FleetTeStats &ts = te.stats();
+    printf("Waits: %u, timeouts: %u, avg wait %u us\n", (unsigned)ts.waits, (unsigned)ts.timeouts,
+           (unsigned)(ts.waits ? ts.waited_us / ts.waits : 0));
+
+    check(frames > 0, "no frames rendered");
+    check(ts.timeouts == 0, "waited longer than FLEET_TE_TIMEOUT_MS for a pulse");
+    check(min_gap >= (uint32_t)divider, "two frames closer than te_divider pulses");
+    check(in_time * 100 >= frames * 95, "frames started outside the blanking");
+    check(frames * 10 >= expected * 8, "frame rate well below panel rate / divider");
+
+    return fleet_check_exit();
+}
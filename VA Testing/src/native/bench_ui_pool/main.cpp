@@ -0,0 +1,99 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: bench_ui_pool
+ * Target:  Host (PlatformIO `native` env)
+ * Goal:    Chat bubbles and list rows scrolling through the ex01 display
+ * setup (FleetDisplay on the in-memory framebuffer), created and deleted
+ * per item vs recycled through FleetUiPool. Prints the fleet_ui_bench
+ * churn table, then checks the pool:
+ *
+ *   - recycling builds only one screenful, everything else is reused
+ *   - the last frame is pixel-identical with and without the pool
+ *
+ * Run:     pio run -e native_bench_ui_pool -t exec
+ *          .pio/build/native_bench_ui_pool/program --items 500
+ *
+ * Exits non-zero if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "lvgl.h"
+
+#include "fleet_check.h"
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_port.h"
+#include "fleet_ui_bench.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+#define CHECK_ITEMS 37
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+static std::vector<uint16_t> churn_frame(FleetPoolKind kind, bool recycle, FleetChurnResult *r)
+{
+    fleet_ui_bench_churn(kind, recycle, CHECK_ITEMS, r);
+    // The list is deleted but not redrawn yet: the framebuffer still holds
+    // the last churn frame
+    return std::vector<uint16_t>(panel.pixels(), panel.pixels() + LCD_WIDTH * LCD_HEIGHT);
+}
+
+int main(int argc, char **argv)
+{
+    int items = 200;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--items") == 0 && i + 1 < argc)
+        {
+            items = atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: %s [--items N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+
+    fleet_ui_bench_churn_all(items);
+
+    printf("Checks (%d items):\n", CHECK_ITEMS);
+    const char *kind_names[FLEET_POOL_KIND_COUNT] = {"bubble", "row"};
+    for (int k = 0; k < FLEET_POOL_KIND_COUNT; k++)
+    {
+        FleetChurnResult created, recycled;
+        const std::vector<uint16_t> a = churn_frame((FleetPoolKind)k, false, &created);
+        const std::vector<uint16_t> b = churn_frame((FleetPoolKind)k, true, &recycled);
+        printf("  %-6s create: %u built, %u deleted; pool: %u built, %u reused\n", kind_names[k],
+               (unsigned)created.pool.created, (unsigned)created.pool.deleted, (unsigned)recycled.pool.created,
+               (unsigned)recycled.pool.reused);
+        check(created.pool.created == FLEET_CHURN_VISIBLE + CHECK_ITEMS && created.pool.reused == 0,
+              "create mode reused objects");
+        check(recycled.pool.created == FLEET_CHURN_VISIBLE && recycled.pool.reused == CHECK_ITEMS,
+              "pool built more than one screenful");
+        check(recycled.pool.deleted == 0, "pool deleted objects");
+        check(a == b, "recycled frame differs from the created one");
+    }
+
+    return fleet_check_exit();
+}
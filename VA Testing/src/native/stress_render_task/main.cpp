@@ -0,0 +1,230 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: stress_render_task
+ * Target:  Host (PlatformIO `native` env, LV_USE_OS = pthreads)
+ * Goal:    Hammer FleetRenderTask from several threads the way audio and
+ * network tasks will on the device, and check nothing is lost or raced:
+ *
+ *   - "posters" post UI work and wait for it to run (post -> run latency)
+ *   - "flooders" post without waiting, to exercise the full-queue path
+ *   - "lockers" edit widgets directly under lock()/unlock()
+ *
+ * Run:     pio run -e native_stress_render_task -t exec
+ *          .pio/build/native_stress_render_task/program --seconds 10
+ *
+ * Exits non-zero if accepted work is lost or never rendered. For data races
+ * build with -fsanitize=thread (see the env in platformio_override.ini).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "lvgl.h"
+
+#include "fleet_display.h"
+#include "fleet_fb_transport.h"
+#include "fleet_metrics.h"
+#include "fleet_port.h"
+#include "fleet_render_task.h"
+
+#define LCD_WIDTH 320
+#define LCD_HEIGHT 480
+#define POSTERS 3
+#define FLOODERS 2
+#define LOCKERS 2
+
+static FleetFramebufferTransport panel;
+static FleetDisplay display;
+static FleetRenderTask render;
+
+static lv_obj_t *labels[POSTERS];
+static lv_obj_t *boxes[LOCKERS];
+static std::atomic<bool> running{true};
+
+// --- Posters: one item in flight each, latency measured on the render task ---
+struct Poster
+{
+    int id;
+    uint32_t posted_at;
+    uint32_t count;
+    std::atomic<bool> done{true};
+    FleetHistogram latency_us; // written on the render task only
+};
+static Poster posters[POSTERS];
+
+static void poster_work(void *ctx)
+{
+    Poster *p = (Poster *)ctx;
+    p->latency_us.record(fleet_micros() - p->posted_at);
+    p->count++;
+    lv_label_set_text_fmt(labels[p->id], "poster %d: %u", p->id, (unsigned)p->count);
+    p->done = true;
+}
+
+static void poster_main(Poster *p)
+{
+    while (running.load())
+    {
+        if (!p->done.load())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        p->done = false;
+        p->posted_at = fleet_micros();
+        if (!render.post(poster_work, p))
+        {
+            p->done = true; // queue full (flooders), try again
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500 + rand() % 2000));
+    }
+}
+
+// --- Flooders: fire and forget ---
+static std::atomic<uint32_t> flood_ran{0};
+
+static void flood_work(void *ctx)
+{
+    (void)ctx;
+    flood_ran++;
+    lv_obj_invalidate(lv_screen_active());
+}
+
+static void flooder_main()
+{
+    while (running.load())
+    {
+        render.post(flood_work, nullptr);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+// --- Lockers: direct LVGL calls from another thread ---
+static std::atomic<uint32_t> lock_edits{0};
+
+static void locker_main(int id)
+{
+    while (running.load())
+    {
+        render.lock();
+        lv_obj_set_pos(boxes[id], rand() % (LCD_WIDTH - 40), 200 + rand() % (LCD_HEIGHT - 240));
+        render.unlock();
+        lock_edits++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 + rand() % 5));
+    }
+}
+
+static void create_ui()
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x003a57), LV_PART_MAIN);
+    for (int i = 0; i < POSTERS; i++)
+    {
+        labels[i] = lv_label_create(scr);
+        lv_obj_set_style_text_color(labels[i], lv_color_white(), LV_PART_MAIN);
+        lv_obj_set_pos(labels[i], 10, 10 + 30 * i);
+        lv_label_set_text_fmt(labels[i], "poster %d", i);
+    }
+    for (int i = 0; i < LOCKERS; i++)
+    {
+        boxes[i] = lv_obj_create(scr);
+        lv_obj_set_size(boxes[i], 40, 40);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 3;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            seconds = atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: %s [--seconds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("--- stress_render_task: %d posters, %d flooders, %d lockers, %d s ---\n", POSTERS, FLOODERS, LOCKERS,
+           seconds);
+
+    lv_init();
+    lv_tick_set_cb(fleet_millis);
+    if (!panel.begin(LCD_WIDTH, LCD_HEIGHT))
+    {
+        printf("FATAL ERROR: framebuffer allocation failed\n");
+        return 1;
+    }
+    FleetDisplayConfig cfg;
+    cfg.width = LCD_WIDTH;
+    cfg.height = LCD_HEIGHT;
+    cfg.log_every = 0;
+    if (!display.begin(&panel, cfg))
+    {
+        return 1;
+    }
+    create_ui();
+
+    if (!render.begin(&display))
+    {
+        return 1;
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < POSTERS; i++)
+    {
+        posters[i].id = i;
+        threads.emplace_back(poster_main, &posters[i]);
+    }
+    for (int i = 0; i < FLOODERS; i++)
+    {
+        threads.emplace_back(flooder_main);
+    }
+    for (int i = 0; i < LOCKERS; i++)
+    {
+        threads.emplace_back(locker_main, i);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running = false;
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+
+    // Nothing posts any more: everything accepted must still run
+    for (int i = 0; i < 1000 && render.executed.load() != render.posted.load(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    render.end();
+
+    const uint32_t posted = render.posted.load();
+    const uint32_t executed = render.executed.load();
+    printf("posted %u, executed %u, rejected (queue full) %u\n", (unsigned)posted, (unsigned)executed,
+           (unsigned)render.rejected.load());
+    printf("flood items run %u, direct lock edits %u\n", (unsigned)flood_ran.load(), (unsigned)lock_edits.load());
+
+    for (int i = 0; i < POSTERS; i++)
+    {
+        posters[i].latency_us.dump("post->run", "us");
+    }
+    display.metrics().dump();
+
+    bool ok = executed == posted;
+    for (int i = 0; i < POSTERS; i++)
+    {
+        ok = ok && posters[i].count > 0;
+    }
+    ok = ok && display.metrics().render_us.count() > 0;
+    printf(ok ? "OK\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,502 @@
+/*
+ * Project: ESP32 Voice Assistant Fleet
+ * Example: stress_tiered_alloc
+ * Target:  Host (PlatformIO `native` platform)
+ * Goal:    Replay an LVGL allocation trace against the tiered allocator
+ * (lib/FleetGfx/src/fleet_tiered_alloc.h) and against a single 64 KB tier
+ * that stands in for LVGL's old builtin pool, and compare failures,
+ * per-tier peaks and fragmentation.
+ *
+ * The trace is either a synthetic voice-assistant session (a chat log
+ * that grows and scrolls old bubbles out, a transcript label streamed in
+ * by reallocs, decoded images and short-lived layer buffers), or one
+ * recorded on the device with -D FLEET_ALLOC_TRACE=1:
+ *
+ *     pio device monitor | tee alloc.log
+ *     .pio/build/native_stress_tiered_alloc/program --trace alloc.log
+ *
+ * Every block is filled with a pattern that is checked again on realloc
+ * and free, so overlapping blocks show up as corruption.
+ *
+ * Then two threads (LVGL's draw units) allocate and free against small
+ * caps at once: neither tier may go over its cap, and every byte reserved
+ * for an allocation that failed must be given back.
+ *
+ * Run:     pio run -e native_stress_tiered_alloc -t exec
+ *
+ * Exits non-zero if a check fails, or if the tiered allocator fails an
+ * allocation.
+ */
+
+#include <map>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fleet_check.h"
+#include "fleet_tiered_alloc.h"
+
+// --- Traces ---
+
+enum OpKind
+{
+    OP_ALLOC,   // id = alloc(size)
+    OP_REALLOC, // id2 = realloc(id, size)
+    OP_FREE,    // free(id)
+};
+
+struct Op
+{
+    OpKind kind;
+    std::string id;
+    std::string id2;
+    size_t size;
+};
+
+class SyntheticTrace
+{
+public:
+    explicit SyntheticTrace(uint32_t seed) : rng(seed) {}
+
+    std::vector<Op> build(int turns)
+    {
+        // The idle screen: clock, status icons, buttons, their styles
+        for (int i = 0; i < 120; i++)
+        {
+            screen.push_back(alloc(range(40, 160)));
+        }
+        for (int t = 0; t < turns; t++)
+        {
+            turn();
+        }
+        // Tear down, so every block is released at the end
+        for (const std::string &id : screen)
+        {
+            release(id);
+        }
+        for (const Bubble &b : chat)
+        {
+            releaseBubble(b);
+        }
+        for (const std::string &id : images)
+        {
+            release(id);
+        }
+        return ops;
+    }
+
+private:
+    struct Bubble
+    {
+        std::string obj, label, style, text;
+    };
+
+    size_t range(size_t lo, size_t hi) { return std::uniform_int_distribution<size_t>(lo, hi)(rng); }
+
+    std::string alloc(size_t size)
+    {
+        const std::string id = "s" + std::to_string(next_id++);
+        ops.push_back({OP_ALLOC, id, "", size});
+        return id;
+    }
+
+    std::string realloc(const std::string &id, size_t size)
+    {
+        const std::string id2 = "s" + std::to_string(next_id++);
+        ops.push_back({OP_REALLOC, id, id2, size});
+        return id2;
+    }
+
+    void release(const std::string &id) { ops.push_back({OP_FREE, id, "", 0}); }
+
+    void releaseBubble(const Bubble &b)
+    {
+        release(b.text);
+        release(b.style);
+        release(b.label);
+        release(b.obj);
+    }
+
+    void turn()
+    {
+        // Listening: a spinner and a level meter, with a layer for the
+        // fading overlay (320 x 40..120 rows of RGB565)
+        std::string spinner = alloc(range(90, 140));
+        std::string arc = alloc(range(90, 140));
+        for (int i = 0; i < 4; i++)
+        {
+            std::string layer = alloc(320 * range(40, 120) * 2);
+            std::string tmp = alloc(range(16, 64));
+            release(layer);
+            release(tmp);
+        }
+
+        // The transcript streams in word by word
+        std::string transcript = alloc(16);
+        size_t len = 16;
+        const size_t words = range(4, 40);
+        for (size_t w = 0; w < words; w++)
+        {
+            len += range(3, 12);
+            transcript = realloc(transcript, len);
+        }
+        release(spinner);
+        release(arc);
+
+        // The reply becomes a chat bubble; the log keeps the last 24
+        Bubble b;
+        b.obj = alloc(range(80, 110));
+        b.label = alloc(range(100, 140));
+        b.style = alloc(range(24, 72));
+        b.text = alloc(range(40, 700));
+        chat.push_back(b);
+        if (chat.size() > 24)
+        {
+            releaseBubble(chat.front());
+            chat.erase(chat.begin());
+        }
+        release(transcript);
+
+        // Now and then a weather/album image, decoded and kept for a while
+        if (range(0, 3) == 0)
+        {
+            images.push_back(alloc(range(10, 150) * 1024));
+            if (images.size() > 3)
+            {
+                release(images.front());
+                images.erase(images.begin());
+            }
+        }
+    }
+
+    std::mt19937 rng;
+    std::vector<Op> ops;
+    std::vector<std::string> screen;
+    std::vector<Bubble> chat;
+    std::vector<std::string> images;
+    uint32_t next_id = 1;
+};
+
+// Lines as written by FleetTieredAlloc with FLEET_ALLOC_TRACE=1, anywhere
+// in a serial log
+static bool load_trace(const char *path, std::vector<Op> *ops)
+{
+    FILE *f = fopen(path, "r");
+    if (f == nullptr)
+    {
+        return false;
+    }
+    char line[512];
+    uint32_t failed = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        const char *p = strstr(line, "alloc: ");
+        if (p == nullptr)
+        {
+            continue;
+        }
+        char kind;
+        char a[64], b[64];
+        unsigned size;
+        p += 7;
+        if (sscanf(p, "a %63s %u", a, &size) == 2)
+        {
+            // A failed device allocation: replay it as alloc + free
+            const std::string id = strcmp(a, "0") ? a : "failed" + std::to_string(failed++);
+            ops->push_back({OP_ALLOC, id, "", size});
+            if (!strcmp(a, "0"))
+            {
+                ops->push_back({OP_FREE, id, "", 0});
+            }
+        }
+        else if (sscanf(p, "r %63s %63s %u", a, b, &size) == 3)
+        {
+            ops->push_back({OP_REALLOC, a, b, size});
+        }
+        else if (sscanf(p, "%c %63s", &kind, a) == 2 && kind == 'f')
+        {
+            ops->push_back({OP_FREE, a, "", 0});
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// --- Replay ---
+
+struct Live
+{
+    uint8_t *ptr;
+    size_t size;
+    uint8_t seed;
+};
+
+static void fill(const Live &l)
+{
+    for (size_t i = 0; i < l.size; i++)
+    {
+        l.ptr[i] = (uint8_t)(l.seed + i * 31);
+    }
+}
+
+static bool intact(const Live &l, size_t n)
+{
+    for (size_t i = 0; i < n && i < l.size; i++)
+    {
+        if (l.ptr[i] != (uint8_t)(l.seed + i * 31))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct ReplayResult
+{
+    uint32_t failed;      // allocations that returned nullptr
+    uint32_t corrupted;   // blocks whose contents changed under us
+    uint32_t unknown_ids; // frees/reallocs of blocks we don't hold (failed, or before the recording)
+    unsigned max_frag[FLEET_TIER_COUNT]; // worst fragmentation seen, percent
+};
+
+static ReplayResult replay(FleetTieredAlloc &heap, const std::vector<Op> &ops)
+{
+    ReplayResult r = {};
+    std::map<std::string, Live> live;
+    uint8_t seed = 1;
+    uint32_t n = 0;
+
+    for (const Op &op : ops)
+    {
+        if (n++ % 64 == 0)
+        {
+            for (int t = 0; t < FLEET_TIER_COUNT; t++)
+            {
+                const unsigned frag = heap.fragmentation((FleetTier)t);
+                r.max_frag[t] = frag > r.max_frag[t] ? frag : r.max_frag[t];
+            }
+        }
+        if (op.kind == OP_ALLOC)
+        {
+            uint8_t *p = (uint8_t *)heap.allocate(op.size);
+            if (p == nullptr)
+            {
+                r.failed++;
+                continue;
+            }
+            check(((uintptr_t)p & 7) == 0, "block not 8-byte aligned");
+            check(FleetTieredAlloc::blockSize(p) >= op.size, "block smaller than asked for");
+            Live l = {p, op.size, seed++};
+            fill(l);
+            live[op.id] = l;
+            continue;
+        }
+
+        auto it = live.find(op.id);
+        if (it == live.end())
+        {
+            r.unknown_ids++;
+            if (op.kind == OP_REALLOC)
+            {
+                uint8_t *p = (uint8_t *)heap.allocate(op.size);
+                if (p == nullptr)
+                {
+                    r.failed++;
+                    continue;
+                }
+                Live l = {p, op.size, seed++};
+                fill(l);
+                live[op.id2] = l;
+            }
+            continue;
+        }
+        Live l = it->second;
+        live.erase(it);
+        if (!intact(l, l.size))
+        {
+            r.corrupted++;
+        }
+
+        if (op.kind == OP_FREE)
+        {
+            heap.release(l.ptr);
+            continue;
+        }
+        uint8_t *p = (uint8_t *)heap.reallocate(l.ptr, op.size);
+        if (p == nullptr)
+        {
+            // Like realloc(): the old block is still valid
+            r.failed++;
+            live[op.id2] = l;
+            continue;
+        }
+        Live moved = {p, op.size, l.seed};
+        if (!intact(moved, l.size < op.size ? l.size : op.size))
+        {
+            r.corrupted++;
+        }
+        fill(moved);
+        live[op.id2] = moved;
+    }
+
+    // Anything the trace left allocated (a recording cut short)
+    for (auto &kv : live)
+    {
+        if (!intact(kv.second, kv.second.size))
+        {
+            r.corrupted++;
+        }
+        heap.release(kv.second.ptr);
+    }
+    return r;
+}
+
+static ReplayResult run(const char *name, const FleetTieredConfig &cfg, const std::vector<Op> &ops)
+{
+    FleetTieredAlloc heap;
+    if (!heap.begin(cfg))
+    {
+        checkf(false, "%s: could not set up the arenas", name);
+        return {};
+    }
+    const ReplayResult r = replay(heap, ops);
+
+    printf("%s: %u failed allocations, %u corrupted blocks, %u unknown blocks\n", name, (unsigned)r.failed,
+           (unsigned)r.corrupted, (unsigned)r.unknown_ids);
+    const char *tier_names[FLEET_TIER_COUNT] = {"internal", "psram"};
+    for (int t = 0; t < FLEET_TIER_COUNT; t++)
+    {
+        const FleetTierStats s = heap.stats((FleetTier)t);
+        if (s.allocs == 0 && s.failures == 0)
+        {
+            continue;
+        }
+        printf("  %-8s peak %7u  allocs %6u  spills %5u  fails %4u  worst frag %u%%\n", tier_names[t],
+               (unsigned)s.peak, (unsigned)s.allocs, (unsigned)s.spills, (unsigned)s.failures, r.max_frag[t]);
+        check(s.peak >= s.used, "peak below current use");
+    }
+    const FleetTierStats in = heap.stats(FLEET_TIER_INTERNAL);
+    const FleetTierStats ps = heap.stats(FLEET_TIER_PSRAM);
+    check(in.blocks + ps.blocks == 0 && in.used + ps.used == 0, "bytes left in use after the trace");
+    check(in.peak <= cfg.internal_max, "internal tier went over its cap");
+    check(ps.peak <= cfg.psram_max, "psram tier went over its cap");
+    check(r.corrupted == 0, "block contents corrupted");
+    heap.end();
+    return r;
+}
+
+static void check_two_tasks()
+{
+    FleetTieredConfig cfg;
+    cfg.small_max = 256;
+    cfg.internal_max = 4 * 1024;
+    cfg.psram_max = 16 * 1024;
+    FleetTieredAlloc heap;
+    if (!heap.begin(cfg))
+    {
+        check(false, "two tasks: could not set up the arenas");
+        return;
+    }
+
+    auto task = [&heap](uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<void *> live;
+        for (int i = 0; i < 200000; i++)
+        {
+            if (live.size() < 12 && rng() % 3 != 0)
+            {
+                void *p = heap.allocate(16 + rng() % 1500);
+                if (p != nullptr)
+                {
+                    live.push_back(p);
+                }
+            }
+            else if (!live.empty())
+            {
+                const size_t k = rng() % live.size();
+                heap.release(live[k]);
+                live[k] = live.back();
+                live.pop_back();
+            }
+        }
+        for (void *p : live)
+        {
+            heap.release(p);
+        }
+    };
+    std::thread a(task, 1), b(task, 2);
+    a.join();
+    b.join();
+
+    const FleetTierStats in = heap.stats(FLEET_TIER_INTERNAL);
+    const FleetTierStats ps = heap.stats(FLEET_TIER_PSRAM);
+    printf("two tasks: internal peak %u of %u, psram peak %u of %u, %u + %u allocs, %u + %u failures\n",
+           (unsigned)in.peak, (unsigned)cfg.internal_max, (unsigned)ps.peak, (unsigned)cfg.psram_max,
+           (unsigned)in.allocs, (unsigned)ps.allocs, (unsigned)in.failures, (unsigned)ps.failures);
+    check(in.failures + ps.failures > 0, "two tasks: caps never reached");
+    check(in.peak <= cfg.internal_max && ps.peak <= cfg.psram_max, "two tasks: a tier went over its cap");
+    check(in.used + ps.used == 0 && in.blocks + ps.blocks == 0, "two tasks: bytes left reserved");
+    heap.end();
+}
+
+int main(int argc, char **argv)
+{
+    const char *trace_path = nullptr;
+    uint32_t seed = 1;
+    int turns = 400;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = (uint32_t)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--turns") == 0 && i + 1 < argc)
+        {
+            turns = atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: %s [--trace alloc.log] [--seed N] [--turns N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Op> ops;
+    if (trace_path != nullptr)
+    {
+        if (!load_trace(trace_path, &ops))
+        {
+            printf("cannot read %s\n", trace_path);
+            return 2;
+        }
+        printf("Trace %s: %u operations\n", trace_path, (unsigned)ops.size());
+    }
+    else
+    {
+        ops = SyntheticTrace(seed).build(turns);
+        printf("Synthetic trace, seed %u, %d turns: %u operations\n", (unsigned)seed, turns, (unsigned)ops.size());
+    }
+
+    // LVGL's old heap: one 64 KB internal pool for everything
+    FleetTieredConfig builtin;
+    builtin.small_max = SIZE_MAX;
+    builtin.internal_max = 64 * 1024;
+    builtin.psram_max = 0;
+    run("builtin 64K", builtin, ops);
+
+    const ReplayResult tiered = run("tiered", FleetTieredConfig(), ops);
+    check(tiered.failed == 0, "tiered allocator failed allocations");
+
+    check_two_tasks();
+
+    return fleet_check_exit();
+}
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Project: ESP32 Voice Assistant Fleet
+Tool:    fleet_asset_pack.py
+Goal:    Pack a directory of images and fonts into the image for the
+         "assets" flash partition, which lib/FleetGfx fleet_asset_pack
+         memory-maps at boot (see fleet_asset_pack.h for the layout).
+
+Names in the pack are the paths relative to the directory, '/'-separated,
+so "assets/img/sun.bin" is "A:img/sun.bin" in LVGL. Files are stored as
+they are: LVGL .bin images and fonts, PNGs if a decoder is enabled, anything.
+
+Usage:
+    python tools/fleet_asset_pack.py assets -o .pio/assets.bin
+    python tools/fleet_asset_pack.py --list .pio/assets.bin
+
+    # Flash it (offset and size from partitions_16MB_assets.csv)
+    esptool.py --chip esp32s3 write_flash 0xA10000 .pio/assets.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = 0x41544C46  # "FLTA"
+VERSION = 1
+NAME_MAX = 40  # including the NUL
+ALIGN = 16
+HEADER = struct.Struct("<IHHII")   # magic, version, count, total_size, data_crc
+ENTRY = struct.Struct("<40sIIII")  # name, offset, size, crc, reserved
+PARTITION_SIZE = 0x5E0000  # "assets" in partitions_16MB_assets.csv
+
+
+def collect(root):
+    """Return [(name, path)] for every file under root, sorted by name as
+    the device's binary search expects (bytewise, like strcmp)."""
+    files = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames[:] = [d for d in dirnames if not d.startswith(".")]
+        for fn in filenames:
+            if fn.startswith("."):
+                continue
+            path = os.path.join(dirpath, fn)
+            name = os.path.relpath(path, root).replace(os.sep, "/")
+            if len(name.encode()) >= NAME_MAX:
+                sys.exit("name too long (max %d bytes): %s" % (NAME_MAX - 1, name))
+            files.append((name, path))
+    return sorted(files, key=lambda f: f[0].encode())
+
+
+def pack(files):
+    """Build the image from [(name, path)]."""
+    offset = HEADER.size + ENTRY.size * len(files)
+    entries = []
+    blobs = []
+    for name, path in files:
+        with open(path, "rb") as f:
+            data = f.read()
+        pad = -offset % ALIGN
+        blobs.append(b"\0" * pad)
+        offset += pad
+        entries.append(ENTRY.pack(name.encode(), offset, len(data), zlib.crc32(data), 0))
+        blobs.append(data)
+        offset += len(data)
+
+    body = b"".join(entries) + b"".join(blobs)
+    total = HEADER.size + len(body)
+    return HEADER.pack(MAGIC, VERSION, len(files), total, zlib.crc32(body)) + body
+
+
+def unpack(image):
+    """Return [(name, offset, size, crc_ok)] for a packed image."""
+    magic, version, count, total, data_crc = HEADER.unpack_from(image)
+    if magic != MAGIC or version != VERSION:
+        sys.exit("not an asset image (magic 0x%08x, version %d)" % (magic, version))
+    if total > len(image) or zlib.crc32(image[HEADER.size:total]) != data_crc:
+        sys.exit("image is truncated or corrupt")
+    out = []
+    for i in range(count):
+        raw, offset, size, crc, _ = ENTRY.unpack_from(image, HEADER.size + i * ENTRY.size)
+        name = raw.split(b"\0", 1)[0].decode()
+        out.append((name, offset, size, zlib.crc32(image[offset:offset + size]) == crc))
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("src", help="directory to pack (or the image, with --list)")
+    ap.add_argument("-o", "--out", default="assets.bin", help="output image (default assets.bin)")
+    ap.add_argument("--list", action="store_true", help="list and check an existing image")
+    ap.add_argument("--max-size", type=lambda s: int(s, 0), default=PARTITION_SIZE,
+                    help="partition size to check against (default 0x%X)" % PARTITION_SIZE)
+    args = ap.parse_args()
+
+    if args.list:
+        with open(args.src, "rb") as f:
+            entries = unpack(f.read())
+        for name, offset, size, ok in entries:
+            print("%8d  0x%06x  %s%s" % (size, offset, name, "" if ok else "  BAD CRC"))
+        if not all(e[3] for e in entries):
+            sys.exit(1)
+        return
+
+    if not os.path.isdir(args.src):
+        sys.exit("%s is not a directory" % args.src)
+    image = pack(collect(args.src))
+    if len(image) > args.max_size:
+        sys.exit("%d bytes don't fit the %d byte partition" % (len(image), args.max_size))
+    with open(args.out, "wb") as f:
+        f.write(image)
+    print("%d files, %d bytes (%.0f%% of the partition) -> %s" % (
+        HEADER.unpack_from(image)[2], len(image), 100.0 * len(image) / args.max_size, args.out))
+
+
+if __name__ == "__main__":
+    main()
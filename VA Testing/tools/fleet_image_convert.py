@@ -0,0 +1,471 @@
+#!/usr/bin/env python3
+"""
+Project: ESP32 Voice Assistant Fleet
+Tool:    fleet_image_convert.py
+Goal:    Turn PNGs into LVGL v9 image descriptors that are already in the
+         panel's wire format, so drawing them costs no per-pixel conversion.
+
+The AXS15231B takes big-endian RGB565. FleetDisplay renders
+LV_COLOR_FORMAT_RGB565_SWAPPED (FLEET_RENDER_SWAPPED=1), so an opaque image
+stored as RGB565_SWAPPED blends into the draw buffer as a plain copy and
+leaves the flush untouched; a full-screen one can skip LVGL altogether with
+FleetDisplay::pushImage(). Per image:
+
+    opaque      RGB565_SWAPPED (RGB565 if the env sets FLEET_RENDER_SWAPPED=0)
+    with alpha  RGB565A8: RGB565 plane + A8 plane (LVGL has no swapped
+                variant; it is blended per pixel anyway)
+
+Rows are padded to --stride-align bytes (default 4, so every row starts
+word-aligned and 16-bit loads never straddle), and the pixel arrays are
+16-byte aligned. Every converted image is unpacked again and checked
+against the pixels this tool decoded: colour bits exactly what the
+quantiser gives, alpha exact, padding zero. Any mismatch fails the run.
+That proves the packing, not the PNG decoder; native_bench_image_convert
+checks the descriptors against LVGL's own decoder (lodepng).
+
+Colours are rounded to the nearest RGB565 value. LVGL's lv_color_to_u16()
+truncates instead, so a PNG decoded on the device can be one step darker
+per channel than the same image converted here.
+
+The PNG decoder is plain Python (zlib only), so PlatformIO's own
+interpreter runs it without extra packages. Non-interlaced PNGs of any
+colour type and bit depth.
+
+Usage:
+    # C descriptors + fleet_images.h (what the PlatformIO hook generates)
+    python tools/fleet_image_convert.py images -o build/fleet_images
+
+    # LVGL .bin files for the asset partition (tools/fleet_asset_pack.py)
+    python tools/fleet_image_convert.py images -o assets/img --bin
+
+    # Convert and validate only; print each image's format and error
+    python tools/fleet_image_convert.py images --check
+
+PlatformIO (platformio_override.ini):
+    extra_scripts = pre:tools/fleet_image_convert.py
+    custom_fleet_images = images        ; PNG directory, default "images"
+
+converts into $BUILD_DIR/fleet_images before the build, compiles the
+descriptors with the project and puts fleet_images.h on the include path:
+
+    #include "fleet_images.h"
+    lv_image_set_src(img, &fleet_img_splash);   // from images/splash.png
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+# lv_color_format_t values (LVGL v9)
+CF_RGB565 = 0x12
+CF_RGB565A8 = 0x14
+CF_RGB565_SWAPPED = 0x1B
+CF_NAMES = {CF_RGB565: "RGB565", CF_RGB565A8: "RGB565A8", CF_RGB565_SWAPPED: "RGB565_SWAPPED"}
+
+IMAGE_HEADER_MAGIC = 0x19  # LV_IMAGE_HEADER_MAGIC
+DATA_ALIGN = 16
+PNG_SIG = b"\x89PNG\r\n\x1a\n"
+
+
+class PngError(Exception):
+    pass
+
+
+# --- PNG --------------------------------------------------------------------
+
+def _unfilter(raw, width, height, bpp_bits):
+    """Undo the per-row filters; return the list of unfiltered rows."""
+    bpp = max(1, bpp_bits // 8)  # filter unit: bytes per complete pixel
+    row_len = (width * bpp_bits + 7) // 8
+    rows = []
+    prev = bytearray(row_len)
+    pos = 0
+    for _ in range(height):
+        if pos + 1 + row_len > len(raw):
+            raise PngError("image data too short")
+        ftype = raw[pos]
+        cur = bytearray(raw[pos + 1:pos + 1 + row_len])
+        pos += 1 + row_len
+        if ftype == 1:  # Sub
+            for i in range(bpp, row_len):
+                cur[i] = (cur[i] + cur[i - bpp]) & 0xFF
+        elif ftype == 2:  # Up
+            for i in range(row_len):
+                cur[i] = (cur[i] + prev[i]) & 0xFF
+        elif ftype == 3:  # Average
+            for i in range(row_len):
+                left = cur[i - bpp] if i >= bpp else 0
+                cur[i] = (cur[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif ftype == 4:  # Paeth
+            for i in range(row_len):
+                a = cur[i - bpp] if i >= bpp else 0
+                b = prev[i]
+                c = prev[i - bpp] if i >= bpp else 0
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                cur[i] = (cur[i] + pred) & 0xFF
+        elif ftype != 0:
+            raise PngError("bad filter type %d" % ftype)
+        rows.append(cur)
+        prev = cur
+    return rows
+
+
+def _samples(row, width, depth, channels):
+    """Yield the row's samples, scaled to 8 bits."""
+    n = width * channels
+    if depth == 8:
+        return list(row[:n])
+    if depth == 16:
+        return [row[2 * i] for i in range(n)]  # high byte = sample >> 8
+    # 1, 2 or 4 bits, MSB first
+    per_byte = 8 // depth
+    mask = (1 << depth) - 1
+    scale = 255 // mask
+    out = []
+    for i in range(n):
+        byte = row[i // per_byte]
+        shift = 8 - depth * (i % per_byte + 1)
+        out.append(((byte >> shift) & mask) * scale)
+    return out
+
+
+def _indices(row, width, depth):
+    """Palette indices of one row (no scaling)."""
+    if depth == 8:
+        return list(row[:width])
+    per_byte = 8 // depth
+    mask = (1 << depth) - 1
+    return [(row[i // per_byte] >> (8 - depth * (i % per_byte + 1))) & mask for i in range(width)]
+
+
+def decode_png(data):
+    """Return (width, height, pixels) with pixels a flat list of RGBA
+    tuples, row-major."""
+    if data[:8] != PNG_SIG:
+        raise PngError("not a PNG")
+    pos = 8
+    ihdr = None
+    palette = []
+    trns = None
+    idat = []
+    while pos + 8 <= len(data):
+        length, ctype = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b"IHDR":
+            ihdr = struct.unpack(">IIBBBBB", chunk)
+        elif ctype == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk) - 2, 3)]
+        elif ctype == b"tRNS":
+            trns = chunk
+        elif ctype == b"IDAT":
+            idat.append(chunk)
+        elif ctype == b"IEND":
+            break
+    if ihdr is None:
+        raise PngError("no IHDR")
+    width, height, depth, ctype, _, _, interlace = ihdr
+    if interlace:
+        raise PngError("interlaced PNGs are not supported (re-save without Adam7)")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if channels is None or depth not in (1, 2, 4, 8, 16):
+        raise PngError("unsupported colour type %d / depth %d" % (ctype, depth))
+
+    rows = _unfilter(zlib.decompress(b"".join(idat)), width, height, depth * channels)
+    pixels = []
+    if ctype == 3:
+        alpha = list(trns) if trns else []
+        for row in rows:
+            for i in _indices(row, width, depth):
+                if i >= len(palette):
+                    raise PngError("palette index %d out of range" % i)
+                r, g, b = palette[i]
+                pixels.append((r, g, b, alpha[i] if i < len(alpha) else 255))
+        return width, height, pixels
+
+    # Colour key transparency (tRNS) for grey and RGB, in the file's depth
+    key = None
+    if trns and ctype in (0, 2):
+        key = struct.unpack(">" + "H" * (len(trns) // 2), trns)
+    for row in rows:
+        s = _samples(row, width, depth, channels)
+        raw = None
+        if key is not None:
+            if depth == 16:
+                raw = struct.unpack(">" + "H" * (width * channels), bytes(row[:width * channels * 2]))
+            else:
+                raw = _indices(row, width * channels, depth) if depth < 8 else list(row[:width * channels])
+        for x in range(width):
+            v = s[x * channels:(x + 1) * channels]
+            if ctype == 0:
+                px = (v[0], v[0], v[0], 255)
+            elif ctype == 2:
+                px = (v[0], v[1], v[2], 255)
+            elif ctype == 4:
+                px = (v[0], v[0], v[0], v[1])
+            else:
+                px = tuple(v)
+            if key is not None and tuple(raw[x * channels:(x + 1) * channels]) == key[:channels]:
+                px = px[:3] + (0,)
+            pixels.append(px)
+    return width, height, pixels
+
+
+def encode_png(width, height, pixels):
+    """Minimal RGBA PNG writer (filter 0), for test images."""
+    def chunk(ctype, body):
+        return struct.pack(">I", len(body)) + ctype + body + struct.pack(">I", zlib.crc32(ctype + body))
+    raw = bytearray()
+    for y in range(height):
+        raw.append(0)
+        for r, g, b, a in pixels[y * width:(y + 1) * width]:
+            raw += bytes((r, g, b, a))
+    return (PNG_SIG + chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 6, 0, 0, 0)) +
+            chunk(b"IDAT", zlib.compress(bytes(raw), 9)) + chunk(b"IEND", b""))
+
+
+# --- Conversion -------------------------------------------------------------
+
+def rgb565(r, g, b):
+    """Round to nearest: at most half a step off per channel, where
+    truncating (lv_color_to_u16()) can be a whole step off."""
+    return ((r * 31 + 127) // 255) << 11 | ((g * 63 + 127) // 255) << 5 | ((b * 31 + 127) // 255)
+
+
+def expand565(c):
+    """RGB565 back to 8-bit channels, the way LVGL does (bit replication)."""
+    r, g, b = c >> 11, (c >> 5) & 0x3F, c & 0x1F
+    return (r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2)
+
+
+def align_up(v, a):
+    return (v + a - 1) // a * a
+
+
+def convert(width, height, pixels, swapped=True, stride_align=4):
+    """Return (cf, stride, data) for LVGL: one plane, or RGB565 + A8."""
+    opaque = all(p[3] == 255 for p in pixels)
+    stride = align_up(width * 2, stride_align)
+    order = ">" if opaque and swapped else "<"
+    data = bytearray()
+    for y in range(height):
+        row = pixels[y * width:(y + 1) * width]
+        data += struct.pack(order + "%dH" % width, *[rgb565(r, g, b) for r, g, b, _ in row])
+        data += b"\0" * (stride - width * 2)
+    if opaque:
+        return (CF_RGB565_SWAPPED if swapped else CF_RGB565), stride, bytes(data)
+    # LVGL: the A8 plane follows, with half the RGB565 stride
+    astride = stride // 2
+    for y in range(height):
+        data += bytes(p[3] for p in pixels[y * width:(y + 1) * width])
+        data += b"\0" * (astride - width)
+    return CF_RGB565A8, stride, bytes(data)
+
+
+def validate(width, height, pixels, cf, stride, data):
+    """Unpack `data` again and compare with `pixels`, as decode_png()
+    returned them. Returns (errors, max_channel_error); errors are
+    strings."""
+    errors = []
+    max_err = 0
+    big = cf == CF_RGB565_SWAPPED
+    if stride % 2 or stride < width * 2:
+        return ["bad stride %d" % stride], 0
+    want_len = stride * height + (stride // 2 * height if cf == CF_RGB565A8 else 0)
+    if len(data) != want_len:
+        return ["%d data bytes, expected %d" % (len(data), want_len)], 0
+    for y in range(height):
+        row = data[y * stride:(y + 1) * stride]
+        if any(row[width * 2:]):
+            errors.append("row %d: padding not zero" % y)
+        for x in range(width):
+            src = pixels[y * width + x]
+            c = (row[2 * x] << 8 | row[2 * x + 1]) if big else (row[2 * x] | row[2 * x + 1] << 8)
+            if c != rgb565(*src[:3]):
+                errors.append("(%d,%d): 0x%04x, expected 0x%04x" % (x, y, c, rgb565(*src[:3])))
+            max_err = max(max_err, max(abs(a - b) for a, b in zip(expand565(c), src[:3])))
+            if len(errors) > 10:
+                return errors, max_err
+    if cf == CF_RGB565A8:
+        astride = stride // 2
+        plane = data[stride * height:]
+        for y in range(height):
+            row = plane[y * astride:(y + 1) * astride]
+            got = list(row[:width])
+            want = [p[3] for p in pixels[y * width:(y + 1) * width]]
+            if got != want:
+                errors.append("row %d: alpha differs" % y)
+            if any(row[width:]):
+                errors.append("row %d: alpha padding not zero" % y)
+    return errors, max_err
+
+
+def c_name(stem):
+    return "fleet_img_" + re.sub(r"[^0-9a-zA-Z_]", "_", stem).lower()
+
+
+def image_header(cf, width, height, stride):
+    """lv_image_header_t, 12 bytes, as LVGL's .bin files start."""
+    return struct.pack("<BBHHHHH", IMAGE_HEADER_MAGIC, cf, 0, width, height, stride, 0)
+
+
+def c_source(name, png, cf, width, height, stride, data):
+    lines = [
+        "/* Generated by tools/fleet_image_convert.py from %s. Do not edit. */" % png,
+        "",
+        '#include "lvgl.h"',
+        "",
+        "__attribute__((aligned(%d))) static const uint8_t %s_map[] = {" % (DATA_ALIGN, name),
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        "const lv_image_dsc_t %s = {" % name,
+        "    .header = {",
+        "        .magic = LV_IMAGE_HEADER_MAGIC,",
+        "        .cf = LV_COLOR_FORMAT_%s," % CF_NAMES[cf],
+        "        .flags = 0,",
+        "        .w = %d," % width,
+        "        .h = %d," % height,
+        "        .stride = %d," % stride,
+        "    },",
+        "    .data_size = sizeof(%s_map)," % name,
+        "    .data = %s_map," % name,
+        "};",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def c_header(images, src_dir):
+    lines = [
+        "/* Generated by tools/fleet_image_convert.py from %s/. Do not edit. */" % src_dir,
+        "",
+        "#pragma once",
+        "",
+        '#include "lvgl.h"',
+        "",
+        "#ifdef __cplusplus",
+        'extern "C" {',
+        "#endif",
+        "",
+    ]
+    for name, png, cf, width, height, stride in images:
+        lines.append("extern const lv_image_dsc_t %s; /* %s: %d x %d %s, stride %d */" % (
+            name, png, width, height, CF_NAMES[cf], stride))
+    lines += ["", "#ifdef __cplusplus", "}", "#endif", ""]
+    return "\n".join(lines)
+
+
+def write_if_changed(path, content):
+    """Only touch files that change, so the build recompiles only those."""
+    if isinstance(content, str):
+        content = content.encode()
+    try:
+        with open(path, "rb") as f:
+            if f.read() == content:
+                return False
+    except OSError:
+        pass
+    with open(path, "wb") as f:
+        f.write(content)
+    return True
+
+
+def run(src_dir, out_dir=None, swapped=True, stride_align=4, as_bin=False, verbose=True):
+    """Convert every PNG in src_dir; write C sources (or .bin files) to
+    out_dir unless it is None. Returns the number of failed images."""
+    pngs = sorted(f for f in os.listdir(src_dir) if f.lower().endswith(".png"))
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+    failed = 0
+    done = []
+    for fn in pngs:
+        path = os.path.join(src_dir, fn)
+        stem = os.path.splitext(fn)[0]
+        try:
+            with open(path, "rb") as f:
+                width, height, pixels = decode_png(f.read())
+        except (PngError, zlib.error, struct.error) as e:
+            print("%s: %s" % (path, e))
+            failed += 1
+            continue
+        cf, stride, data = convert(width, height, pixels, swapped, stride_align)
+        errors, max_err = validate(width, height, pixels, cf, stride, data)
+        if verbose or errors:
+            print("  %-24s %4d x %-4d %-15s stride %4d  %7d bytes  max err %d%s" % (
+                fn, width, height, CF_NAMES[cf], stride, len(data), max_err, "  FAILED" if errors else ""))
+        for e in errors:
+            print("    " + e)
+        if errors:
+            failed += 1
+            continue
+        name = c_name(stem)
+        done.append((name, fn, cf, width, height, stride))
+        if out_dir and as_bin:
+            write_if_changed(os.path.join(out_dir, stem + ".bin"), image_header(cf, width, height, stride) + data)
+        elif out_dir:
+            write_if_changed(os.path.join(out_dir, stem + ".c"),
+                             c_source(name, fn, cf, width, height, stride, data))
+    if out_dir and not as_bin:
+        write_if_changed(os.path.join(out_dir, "fleet_images.h"), c_header(done, os.path.basename(src_dir)))
+    return failed
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("src", help="directory of PNGs")
+    ap.add_argument("-o", "--out", help="output directory")
+    ap.add_argument("--bin", action="store_true", help="write LVGL .bin files instead of C sources")
+    ap.add_argument("--check", action="store_true", help="convert and validate only, write nothing")
+    ap.add_argument("--native", action="store_true",
+                    help="opaque images as RGB565, for FLEET_RENDER_SWAPPED=0 builds")
+    ap.add_argument("--stride-align", type=int, default=4, help="row alignment in bytes (default 4)")
+    args = ap.parse_args()
+
+    if not args.check and not args.out:
+        ap.error("-o is required unless --check")
+    if args.stride_align < 2 or args.stride_align % 2:
+        ap.error("--stride-align must be even")
+    failed = run(args.src, None if args.check else args.out, not args.native, args.stride_align, args.bin)
+    if failed:
+        sys.exit("%d image(s) failed" % failed)
+
+
+# --- PlatformIO hook --------------------------------------------------------
+
+def pio_hook(env):
+    """pre: extra_script. Convert the env's PNGs into $BUILD_DIR and add the
+    descriptors to the build."""
+    src_dir = os.path.join(env.subst("$PROJECT_DIR"), env.GetProjectOption("custom_fleet_images", "images"))
+    if not os.path.isdir(src_dir):
+        return
+    flags = env.GetProjectOption("build_flags", "")
+    if not isinstance(flags, str):
+        flags = " ".join(flags)
+    swapped = re.search(r"FLEET_RENDER_SWAPPED\s*=\s*0\b", flags) is None
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "fleet_images")
+    print("fleet_image_convert: %s -> %s (%s)" % (src_dir, out_dir, "swapped" if swapped else "native"))
+    if run(src_dir, out_dir, swapped, verbose=False):
+        sys.stderr.write("fleet_image_convert: image conversion failed\n")
+        env.Exit(1)
+    env.Append(CPPPATH=[out_dir])
+    env.BuildSources(os.path.join("$BUILD_DIR", "fleet_images_obj"), out_dir)
+
+
+try:
+    Import("env")  # noqa: F821 (SCons, when run as a PlatformIO extra_script)
+except NameError:
+    env = None
+
+if env is not None:
+    pio_hook(env)
+elif __name__ == "__main__":
+    main()
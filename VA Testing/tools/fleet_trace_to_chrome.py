@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Project: ESP32 Voice Assistant Fleet
+Tool:    fleet_trace_to_chrome.py
+Goal:    Turn the trace text printed by a FLEET_PROFILE build (LVGL's
+         built-in profiler plus lib/FleetGfx fleet_trace) into Chrome trace
+         JSON, which chrome://tracing and https://ui.perfetto.dev both open.
+
+The device prints lines like
+
+    loopTask-1234 [1] 12.345678: tracing_mark_write: B|1|lv_timer_handler
+    fleet_dma-3048 [0] 12.345901: tracing_mark_write: E|1|dma_push
+
+mixed in with the normal serial log. Anything that doesn't parse is skipped.
+
+Usage:
+    # From a saved serial log (send 't' in the monitor first)
+    pio device monitor -e guition_3_5_ex01_hello_lvgl_profile | tee trace.log
+    python tools/fleet_trace_to_chrome.py trace.log -o trace.json
+
+    # Or straight from the board (needs pyserial): run for 5 s, send 't',
+    # collect until the trace summary line arrives
+    python tools/fleet_trace_to_chrome.py --port /dev/ttyACM0 --seconds 5 -o trace.json
+"""
+
+import argparse
+import json
+import re
+import sys
+import time
+
+LINE_RE = re.compile(
+    r"(?P<thread>[^\s\[\]]+?)-(?P<tid>\d+)\s+\[(?P<cpu>\d+)\]\s+"
+    r"(?P<sec>\d+)\.(?P<frac>\d+):\s+(?:tracing_mark_write:\s+)?"
+    r"(?P<ph>[BE])\|(?P<pid>\d+)\|(?P<name>\S.*?)\s*$"
+)
+
+DONE_MARK = "fleet_trace:"
+
+
+def parse(lines):
+    """Yield (thread, tid, cpu, ts_us, phase, name) for every trace line."""
+    for line in lines:
+        m = LINE_RE.search(line)
+        if not m:
+            continue
+        # The fraction is 6 digits from fleet_trace and LVGL at 1 MHz, but
+        # LVGL prints 3 at its default 1 kHz tick; scale either way.
+        frac = m.group("frac")
+        ts_us = int(m.group("sec")) * 1000000 + int(frac) * 10 ** (6 - len(frac))
+        yield (m.group("thread"), int(m.group("tid")), int(m.group("cpu")),
+               ts_us, m.group("ph"), m.group("name"))
+
+
+# Every task is in the one process, the device
+PID = 1
+
+
+def to_chrome(records):
+    """Build the Chrome trace dict from time-sorted records. One track per
+    task. An unpinned task can run on either core, so a track can't belong
+    to a core: each event carries the core it ran on in its args, and the
+    track name lists the cores the task was seen on."""
+    events = []
+    threads = {}
+    for thread, tid, cpu, ts_us, ph, name in records:
+        threads.setdefault(tid, [thread, set()])[1].add(cpu)
+        events.append({"name": name, "ph": ph, "ts": ts_us, "pid": PID, "tid": tid, "args": {"core": cpu}})
+
+    for tid, (thread, cpus) in sorted(threads.items()):
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": tid,
+                       "args": {"name": "%s (%d) core %s" % (thread, tid, ",".join(map(str, sorted(cpus))))}})
+    events.append({"name": "process_name", "ph": "M", "pid": PID, "args": {"name": "device"}})
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def read_port(port, baud, seconds):
+    """Let the board run, ask it for the trace and return the lines."""
+    try:
+        import serial  # pyserial
+    except ImportError:
+        sys.exit("--port needs pyserial (pip install pyserial)")
+
+    lines = []
+    with serial.Serial(port, baud, timeout=0.5) as ser:
+        time.sleep(seconds)
+        ser.reset_input_buffer()
+        ser.write(b"t")
+        idle = 0
+        while idle < 10:  # 5 s without data: give up
+            raw = ser.readline()
+            if not raw:
+                idle += 1
+                continue
+            idle = 0
+            line = raw.decode("utf-8", "replace").rstrip()
+            lines.append(line)
+            if DONE_MARK in line:
+                break
+    return lines
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("logs", nargs="*", help="serial log files ('-' for stdin)")
+    ap.add_argument("-o", "--out", default="trace.json", help="output JSON (default trace.json)")
+    ap.add_argument("--port", help="read from this serial port instead of files")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--seconds", type=float, default=5.0, help="run time before requesting the trace")
+    args = ap.parse_args()
+
+    lines = []
+    if args.port:
+        lines = read_port(args.port, args.baud, args.seconds)
+    elif not args.logs or args.logs == ["-"]:
+        lines = sys.stdin.read().splitlines()
+    else:
+        for path in args.logs:
+            with open(path, encoding="utf-8", errors="replace") as f:
+                lines.extend(f.read().splitlines())
+
+    records = sorted(parse(lines), key=lambda r: r[3])
+    if not records:
+        sys.exit("no trace lines found (was the build FLEET_PROFILE=1, and was 't' sent?)")
+
+    with open(args.out, "w") as f:
+        json.dump(to_chrome(records), f)
+
+    span_ms = (records[-1][3] - records[0][3]) / 1000.0 if len(records) > 1 else 0.0
+    print("%d events, %d tracks, ~%.1f ms -> %s" % (
+        len(records), len({r[1] for r in records}), span_ms, args.out))
+
+
+if __name__ == "__main__":
+    main()